@@ -0,0 +1,487 @@
+// GearBench: microbenchmarks for the logging pipeline (format -> ring push -> file queue -> disk -> rotation)
+// and the search paths of the Logger window (columnar level/time scan, case-insensitive text search).
+//
+// Run with JSON output for the regression check:
+//   GearBench --benchmark_out=bench.json --benchmark_out_format=json
+//   python3 Bench/compare_bench.py Bench/baseline.json bench.json
+//
+// Every benchmark reports throughput (items_per_second) and, where single operations are timed,
+// latency percentiles as counters (p50_ns, p99_ns, p999_ns, max_ns).
+
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "Logger/Logger.h"
+#include "Logger/LogToFile.h"
+#include "Logger/LogFileWriter.h"
+#include "Logger/CircularLogBuffer.h"
+#include "Logger/LatencyHistogram.h"
+#include "Logger/ColumnarLogStore.h"
+#include "Utils/StringSearch.h"
+#include "Trace/TraceRecorder.h"
+
+#ifndef _WIN32
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "Ipc/LogSocketServer.h"
+#endif
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	const std::string BENCH_FOLDER = "bench_logs";
+	const std::string SAMPLE_TEXT = "Motor \"Left\" Run(): reached target position 1234.5 after 17 ms";
+
+	uint64_t ElapsedNs(Clock::time_point start)
+	{
+		return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start).count());
+	}
+
+	// Percentiles are per thread; with several threads the reported value is the thread average
+	void ReportLatency(benchmark::State& state, const LatencyHistogram& latency)
+	{
+		constexpr auto flags = benchmark::Counter::kAvgThreads;
+		state.counters["p50_ns"] = benchmark::Counter(static_cast<double>(latency.GetPercentile(50.0)), flags);
+		state.counters["p99_ns"] = benchmark::Counter(static_cast<double>(latency.GetPercentile(99.0)), flags);
+		state.counters["p999_ns"] = benchmark::Counter(static_cast<double>(latency.GetPercentile(99.9)), flags);
+		state.counters["max_ns"] = benchmark::Counter(static_cast<double>(latency.GetMax()), flags);
+	}
+
+	// Waits until the writer thread has flushed 'lines' lines in total
+	void WaitForWriter(const LogToFile& logger, uint64_t lines)
+	{
+		while (logger.GetStats().linesWritten < lines)
+			std::this_thread::yield();
+	}
+}
+
+// One LOG1_* call on a single thread: the user text is formatted into a capped buffer (Logger::FormatCapped),
+// PushFormatted() interns the prefix and pushes to the ring and the file queue. Arg 1 logs a text above
+// the message length cap, i.e. the truncation path.
+static void BM_Log1(benchmark::State& state)
+{
+	const std::string payload(state.range(0) ? Logger::GetMaxMessageLength() * 2 : 0, 'x');
+
+	LatencyHistogram latency;
+	int value = 0;
+	for (auto _ : state)
+	{
+		const auto start = Clock::now();
+		LOG1_INFO("Motor", "reached target {} after {} ms{}", ++value, 17, payload);
+		latency.Record(ElapsedNs(start));
+	}
+	state.SetItemsProcessed(state.iterations());
+	ReportLatency(state, latency);
+	state.counters["dropped"] = static_cast<double>(Logger::GetMetrics().file.droppedMessages);
+}
+BENCHMARK(BM_Log1)->Arg(0)->Arg(1);
+
+// Ring buffer push, shared ring; the thread sweep shows mutex contention
+static void BM_RingPush(benchmark::State& state)
+{
+	static CircularLogBuffer ring(Logger::LOG_BUFFER_CAPACITY);
+	const LogMessage message(LogLevel::Info, SAMPLE_TEXT);
+
+	LatencyHistogram latency;
+	for (auto _ : state)
+	{
+		const auto start = Clock::now();
+		ring.Push(message);
+		latency.Record(ElapsedNs(start));
+	}
+	state.SetItemsProcessed(state.iterations());
+	ReportLatency(state, latency);
+}
+BENCHMARK(BM_RingPush)->ThreadRange(1, 16)->UseRealTime();
+
+// Producer side of LogToFile: queue insert only, the writer thread drains in the background
+static void BM_Enqueue(benchmark::State& state)
+{
+	std::filesystem::remove_all(BENCH_FOLDER);
+	LogToFile logger(BENCH_FOLDER, "enqueue.log", 64 * 1024, 1);
+	const LogMessage message(LogLevel::Info, SAMPLE_TEXT);
+
+	LatencyHistogram latency;
+	for (auto _ : state)
+	{
+		const auto start = Clock::now();
+		logger.Write(message);
+		latency.Record(ElapsedNs(start));
+	}
+	state.SetItemsProcessed(state.iterations());
+	ReportLatency(state, latency);
+	state.counters["dropped"] = static_cast<double>(logger.GetStats().droppedMessages);
+}
+BENCHMARK(BM_Enqueue);
+
+// End-to-end file write: a batch of lines is enqueued and timed until the writer has flushed all of them
+static void BM_Write(benchmark::State& state)
+{
+	const int64_t batch = state.range(0);
+	std::filesystem::remove_all(BENCH_FOLDER);
+	LogToFile logger(BENCH_FOLDER, "write.log", 1024 * 1024, 1);
+	const LogMessage message(LogLevel::Info, SAMPLE_TEXT);
+
+	uint64_t written = 0;
+	for (auto _ : state)
+	{
+		for (int64_t i = 0; i < batch; ++i)
+			logger.Write(message);
+		written += static_cast<uint64_t>(batch);
+		WaitForWriter(logger, written);
+	}
+	const LogFileStats stats = logger.GetStats();
+	state.SetItemsProcessed(state.iterations() * batch);
+	state.SetBytesProcessed(static_cast<int64_t>(stats.bytesWritten));
+}
+BENCHMARK(BM_Write)->Arg(1000)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+// Rotation: every batch overflows the 4 KB file once; reports the rotation time measured by LogToFile
+static void BM_Rotate(benchmark::State& state)
+{
+	std::filesystem::remove_all(BENCH_FOLDER);
+	LogToFile logger(BENCH_FOLDER, "rotate.log", 4, 5);
+	const LogMessage message(LogLevel::Info, SAMPLE_TEXT);
+	const uint64_t linesPerFile = 4096 / (message.ToStringForFile().size() + 1) + 1;
+
+	LatencyHistogram rotationLatency;
+	uint64_t written = 0;
+	uint64_t rotations = 0;
+	for (auto _ : state)
+	{
+		for (uint64_t i = 0; i < linesPerFile; ++i)
+			logger.Write(message);
+		written += linesPerFile;
+		WaitForWriter(logger, written);
+
+		const LogFileStats stats = logger.GetStats();
+		if (stats.rotations != rotations)
+		{
+			rotations = stats.rotations;
+			rotationLatency.Record(stats.lastRotationNs);
+		}
+	}
+	state.counters["rotations"] = static_cast<double>(rotations);
+	ReportLatency(state, rotationLatency);
+}
+BENCHMARK(BM_Rotate)->UseRealTime()->Unit(benchmark::kMicrosecond);
+
+// File backend alone, formatted lines straight into the file: 0 = std::ofstream with a flush per line (the former
+// LogToFile path), 1 = LogFileWriter (raw fd, buffered, one write per batch). Measured in CPU time, so
+// bytes_per_second is MB per CPU second (inverse: CPU cost per MB, including the write syscalls).
+static void BM_FileBackend(benchmark::State& state)
+{
+	const bool rawFd = state.range(0) != 0;
+	std::filesystem::remove_all(BENCH_FOLDER);
+	std::filesystem::create_directories(BENCH_FOLDER);
+	const auto path = std::filesystem::path(BENCH_FOLDER) / "backend.log";
+	const std::string line = LogMessage(LogLevel::Info, SAMPLE_TEXT).ToStringForFile();
+	constexpr int BATCH = 1000;
+
+	std::ofstream stream;
+	LogFileWriter writer;
+	if (rawFd)
+		writer.Open(path);
+	else
+		stream.open(path, std::ios::app | std::ios::binary);
+
+	for (auto _ : state)
+	{
+		for (int i = 0; i < BATCH; ++i)
+		{
+			if (rawFd)
+				writer.AppendLine(line);
+			else
+			{
+				stream << line << '\n';
+				stream.flush();
+			}
+		}
+		if (rawFd)
+			writer.Flush();
+
+		// Keep the file small, the page cache and not the disk is measured
+		state.PauseTiming();
+		if (rawFd)
+			writer.Open(path);
+		std::filesystem::resize_file(path, 0);
+		state.ResumeTiming();
+	}
+	state.SetItemsProcessed(state.iterations() * BATCH);
+	state.SetBytesProcessed(state.iterations() * BATCH * static_cast<int64_t>(line.size() + 1));
+}
+BENCHMARK(BM_FileBackend)->Arg(0)->Arg(1)->Unit(benchmark::kMicrosecond);
+
+// Full producer path through the global Logger (format + ring + file queue) with a thread sweep
+static void BM_LoggerContention(benchmark::State& state)
+{
+	LatencyHistogram latency;
+	int value = 0;
+	for (auto _ : state)
+	{
+		const auto start = Clock::now();
+		LOG1_DEBUG("Bench", "value {} from thread {}", ++value, state.thread_index());
+		latency.Record(ElapsedNs(start));
+	}
+	state.SetItemsProcessed(state.iterations());
+	ReportLatency(state, latency);
+
+	if (state.thread_index() == 0)
+		state.counters["dropped"] = static_cast<double>(Logger::GetMetrics().file.droppedMessages);
+}
+BENCHMARK(BM_LoggerContention)->ThreadRange(1, 16)->UseRealTime();
+
+// GEAR_TRACE_SCOPE cost (begin + end event) while a capture runs; the capture is restarted before the
+// thread buffer fills up, so every iteration takes the recording path. Target: < 20 ns per event.
+static void BM_TraceScope(benchmark::State& state)
+{
+	if (state.thread_index() == 0)
+		gear::TraceRecorder::Start();
+
+	size_t scopes = 0;
+	for (auto _ : state)
+	{
+		GEAR_TRACE_SCOPE("bench");
+		if (++scopes == gear::TraceRecorder::EVENTS_PER_THREAD / 2)
+		{
+			state.PauseTiming();
+			if (state.thread_index() == 0)
+				gear::TraceRecorder::Start();
+			scopes = 0;
+			state.ResumeTiming();
+		}
+	}
+	state.SetItemsProcessed(state.iterations() * 2);
+
+	if (state.thread_index() == 0)
+	{
+		state.counters["dropped"] = static_cast<double>(gear::TraceRecorder::GetDroppedCount());
+		gear::TraceRecorder::Stop();
+	}
+}
+BENCHMARK(BM_TraceScope)->ThreadRange(1, 8)->UseRealTime();
+
+// Trace point cost without a running capture
+static void BM_TraceScopeIdle(benchmark::State& state)
+{
+	gear::TraceRecorder::Stop();
+	for (auto _ : state)
+	{
+		GEAR_TRACE_SCOPE("bench");
+	}
+	state.SetItemsProcessed(state.iterations() * 2);
+}
+BENCHMARK(BM_TraceScopeIdle);
+
+namespace
+{
+	// 'count' entries spread over the hour before 'endNs', ~1% errors (fixed seed, same data for both layouts)
+	void FillScanData(size_t count, int64_t endNs, std::vector<LogMessage>* rows, ColumnarLogStore* columns)
+	{
+		std::mt19937 rng(42);
+		const int64_t hourNs = 3600LL * 1000 * 1000 * 1000;
+		const int64_t stepNs = hourNs / static_cast<int64_t>(count);
+
+		if (rows)
+			rows->reserve(count);
+		if (columns)
+			columns->Reserve(count, count * 12);
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			const uint32_t r = rng() % 100;
+			const LogLevel level = r == 0 ? LogLevel::Error : (r < 5 ? LogLevel::Warning : (r < 50 ? LogLevel::Debug : LogLevel::Info));
+			const int64_t ts = endNs - hourNs + static_cast<int64_t>(i) * stepNs;
+			std::string text = "entry " + std::to_string(i);
+
+			if (columns)
+				columns->Append(level, ts, text, i);
+			if (rows)
+			{
+				rows->emplace_back(level, std::move(text));
+				rows->back().timestamp = FromEpochNanoseconds(ts);
+				rows->back().sequence = i;
+			}
+		}
+	}
+
+	constexpr int64_t SCAN_END_NS = 1'700'000'000'000'000'000;
+	constexpr int64_t SCAN_MIN_NS = SCAN_END_NS - 600LL * 1000 * 1000 * 1000; // Last 10 minutes
+}
+
+// "Show only errors in the last 10 minutes" over a LogMessage array (the ring's layout). 10M entries need ~1 GB.
+static void BM_ScanRows(benchmark::State& state)
+{
+	std::vector<LogMessage> rows;
+	FillScanData(static_cast<size_t>(state.range(0)), SCAN_END_NS, &rows, nullptr);
+	const auto minTp = FromEpochNanoseconds(SCAN_MIN_NS);
+
+	size_t matches = 0;
+	for (auto _ : state)
+	{
+		matches = 0;
+		for (const LogMessage& msg : rows)
+		{
+			if (msg.level == LogLevel::Error && msg.timestamp >= minTp)
+				++matches;
+		}
+		benchmark::DoNotOptimize(matches);
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+	state.counters["matches"] = static_cast<double>(matches);
+}
+BENCHMARK(BM_ScanRows)->Arg(1000000)->Arg(10000000)->Unit(benchmark::kMicrosecond);
+
+// Same scan over ColumnarLogStore with the best SIMD kernel of this CPU
+static void BM_ScanColumnar(benchmark::State& state)
+{
+	ColumnarLogStore columns;
+	FillScanData(static_cast<size_t>(state.range(0)), SCAN_END_NS, nullptr, &columns);
+
+	std::vector<uint32_t> indices;
+	indices.reserve(static_cast<size_t>(state.range(0)));
+	size_t matches = 0;
+	for (auto _ : state)
+	{
+		indices.clear();
+		matches = columns.ScanLevelTime(LevelBit(LogLevel::Error), SCAN_MIN_NS, INT64_MAX, indices, 0, SIZE_MAX, gear::GetSimdLevel());
+		benchmark::DoNotOptimize(indices.data());
+	}
+	state.SetItemsProcessed(state.iterations() * state.range(0));
+	state.SetLabel(gear::SimdLevelName(gear::GetSimdLevel()));
+	state.counters["matches"] = static_cast<double>(matches);
+}
+BENCHMARK(BM_ScanColumnar)->Arg(1000000)->Arg(10000000)->Unit(benchmark::kMicrosecond);
+
+namespace
+{
+	// Arg of the search benchmarks: 0 = lowercase copy + std::string::find (the approach FindNoCase replaced),
+	// 1.. = FindNoCase with that kernel (clamped to what the CPU supports)
+	const gear::SimdLevel SEARCH_KERNELS[] = { gear::SimdLevel::Scalar, gear::SimdLevel::Sse2, gear::SimdLevel::Avx2 };
+
+	size_t FindLowerCopy(std::string haystack, std::string needle)
+	{
+		auto lower = [](std::string& s) { std::transform(s.begin(), s.end(), s.begin(), [](char c) { return gear::ToLowerAscii(c); }); };
+		lower(haystack);
+		lower(needle);
+		const size_t pos = haystack.find(needle);
+		return pos == std::string::npos ? gear::NOT_FOUND : pos;
+	}
+
+	size_t Search(const benchmark::State& state, std::string_view haystack, std::string_view needle)
+	{
+		if (state.range(0) == 0)
+			return FindLowerCopy(std::string(haystack), std::string(needle));
+		return gear::FindNoCase(haystack, needle, SEARCH_KERNELS[state.range(0) - 1]);
+	}
+
+	void LabelSearch(benchmark::State& state)
+	{
+		state.SetLabel(state.range(0) == 0 ? "lowercase copy" : gear::SimdLevelName(gear::ClampSimdLevel(SEARCH_KERNELS[state.range(0) - 1])));
+	}
+}
+
+// Icon-name style filtering: 20000 short strings per iteration
+static void BM_SearchNames(benchmark::State& state)
+{
+	std::vector<std::string> names;
+	for (int i = 0; i < 20000; ++i)
+		names.push_back("ICON_FA_ENTRY_NUMBER_" + std::to_string(i) + (i % 97 == 0 ? "_ARROW_UP" : "_CIRCLE"));
+
+	for (auto _ : state)
+	{
+		size_t hits = 0;
+		for (const std::string& name : names)
+			hits += Search(state, name, "arrow_up") != gear::NOT_FOUND;
+		benchmark::DoNotOptimize(hits);
+	}
+	state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(names.size()));
+	LabelSearch(state);
+}
+BENCHMARK(BM_SearchNames)->DenseRange(0, 3)->Unit(benchmark::kMicrosecond);
+
+// Log-line style search: one 1 MB text, match at its end
+static void BM_SearchText(benchmark::State& state)
+{
+	std::string text;
+	while (text.size() < 1 << 20)
+		text += "[Sensor.Left] \"Temperature\" reading within expected range, motor idle. ";
+	text += "Arrow up";
+
+	for (auto _ : state)
+		benchmark::DoNotOptimize(Search(state, text, "ARROW UP"));
+	state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(text.size()));
+	LabelSearch(state);
+}
+BENCHMARK(BM_SearchText)->DenseRange(0, 3)->Unit(benchmark::kMicrosecond);
+
+#ifndef _WIN32
+// Socket ingestion into the Logger ring: one client sends 100-record datagrams over a Unix socket, timed until the
+// server has pushed all of them via Logger::PushExternal. Target: >= 1M msgs/s (items_per_second).
+static void BM_SocketIngest(benchmark::State& state)
+{
+	const int64_t perDatagram = state.range(0);
+	const std::string path = "/tmp/gear_bench_" + std::to_string(::getpid()) + ".sock";
+	gear::LogSocketServer server(path, [](LogMessage* messages, size_t count) { Logger::PushExternal(messages, count); });
+	if (!server.IsListening())
+	{
+		state.SkipWithError(server.GetError().c_str());
+		return;
+	}
+
+	const int fd = ::socket(AF_UNIX, SOCK_DGRAM, 0);
+	sockaddr_un addr{};
+	addr.sun_family = AF_UNIX;
+	std::snprintf(addr.sun_path, sizeof(addr.sun_path), "%s", path.c_str());
+	::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+
+	std::vector<char> buffer(gear::LOG_DATAGRAM_MAX_SIZE);
+	gear::LogDatagramWriter writer(buffer.data(), buffer.size(), static_cast<uint32_t>(::getpid()), "bench");
+	for (int64_t i = 0; i < perDatagram; ++i)
+		writer.Add(gear::ShmLogLevel::Info, SAMPLE_TEXT);
+
+	constexpr int datagramsPerIteration = 100;
+	uint64_t sent = 0;
+	for (auto _ : state)
+	{
+		for (int i = 0; i < datagramsPerIteration; ++i)
+			::send(fd, writer.Data(), writer.Size(), 0); // Blocks while the server's receive buffer is full
+		sent += static_cast<uint64_t>(datagramsPerIteration * perDatagram);
+		while (server.GetRecordCount() < sent)
+			std::this_thread::yield();
+	}
+	::close(fd);
+
+	state.SetItemsProcessed(static_cast<int64_t>(sent));
+	state.SetBytesProcessed(static_cast<int64_t>(server.GetByteCount()));
+	state.counters["rejected"] = static_cast<double>(server.GetRejectedCount());
+}
+BENCHMARK(BM_SocketIngest)->Arg(1)->Arg(100)->UseRealTime()->Unit(benchmark::kMillisecond);
+#endif
+
+int main(int argc, char** argv)
+{
+	benchmark::Initialize(&argc, argv);
+	if (benchmark::ReportUnrecognizedArguments(argc, argv))
+		return 1;
+
+	benchmark::RunSpecifiedBenchmarks();
+	benchmark::Shutdown();
+
+	std::error_code ec;
+	std::filesystem::remove_all(BENCH_FOLDER, ec);
+	return 0;
+}
@@ -0,0 +1,165 @@
+// GearLogGen: load generator for GEAR's log socket (Ipc/LogSocketServer.h).
+//
+// Sends batched log datagrams at a fixed message rate and prints the achieved rate once per second:
+//   GearLogGen [--address /tmp/gear_log.sock | udp://PORT] [--rate 1000000] [--batch 100] [--seconds 10] [--name loadgen]
+// --rate 0 sends as fast as possible. Levels cycle Info/Info/Info/Warning/Debug, one Error every 1000 messages.
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#ifndef _WIN32
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#include "Ipc/LogDatagram.h"
+#include "Ipc/LogSocketServer.h"
+
+using namespace gear;
+
+namespace
+{
+	struct Options
+	{
+		std::string address = LogSocketServer::DEFAULT_ADDRESS;
+		uint64_t rate = 1'000'000;
+		size_t batch = 100;
+		double seconds = 10.0;
+		std::string name = "loadgen";
+	};
+
+	bool ParseOptions(int argc, char** argv, Options& options)
+	{
+		for (int i = 1; i < argc; ++i)
+		{
+			const std::string arg = argv[i];
+			if (i + 1 >= argc)
+				return false;
+			const char* value = argv[++i];
+			if (arg == "--address")
+				options.address = value;
+			else if (arg == "--rate")
+				options.rate = std::strtoull(value, nullptr, 10);
+			else if (arg == "--batch")
+				options.batch = std::max<size_t>(1, std::strtoull(value, nullptr, 10));
+			else if (arg == "--seconds")
+				options.seconds = std::atof(value);
+			else if (arg == "--name")
+				options.name = value;
+			else
+				return false;
+		}
+		return true;
+	}
+
+	ShmLogLevel LevelFor(uint64_t index)
+	{
+		if (index % 1000 == 999)
+			return ShmLogLevel::Error;
+		constexpr ShmLogLevel cycle[] = { ShmLogLevel::Info, ShmLogLevel::Info, ShmLogLevel::Info, ShmLogLevel::Warning, ShmLogLevel::Debug };
+		return cycle[index % 5];
+	}
+}
+
+int main(int argc, char** argv)
+{
+#ifdef _WIN32
+	std::fprintf(stderr, "GearLogGen needs POSIX sockets\n");
+	return 1;
+#else
+	Options options;
+	if (!ParseOptions(argc, argv, options))
+	{
+		std::fprintf(stderr, "usage: GearLogGen [--address PATH|udp://PORT] [--rate MSGS_PER_S] [--batch N] [--seconds S] [--name NAME]\n");
+		return 1;
+	}
+
+	int fd = -1;
+	int result = -1;
+	if (options.address.rfind("udp://", 0) == 0)
+	{
+		fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+		sockaddr_in addr{};
+		addr.sin_family = AF_INET;
+		addr.sin_port = htons(static_cast<uint16_t>(std::atoi(options.address.c_str() + 6)));
+		addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+		result = ::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+	}
+	else
+	{
+		fd = ::socket(AF_UNIX, SOCK_DGRAM, 0);
+		sockaddr_un addr{};
+		addr.sun_family = AF_UNIX;
+		std::snprintf(addr.sun_path, sizeof(addr.sun_path), "%s", options.address.c_str());
+		result = ::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+	}
+	if (fd < 0 || result != 0)
+	{
+		std::fprintf(stderr, "connect '%s': %s\n", options.address.c_str(), std::strerror(errno));
+		return 1;
+	}
+
+	using Clock = std::chrono::steady_clock;
+	std::vector<char> buffer(LOG_DATAGRAM_MAX_SIZE);
+	char text[128];
+	uint64_t sent = 0;
+	uint64_t failed = 0;
+	uint64_t reported = 0;
+
+	const auto start = Clock::now();
+	const auto end = start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(options.seconds));
+	auto nextReport = start + std::chrono::seconds(1);
+
+	while (Clock::now() < end)
+	{
+		LogDatagramWriter writer(buffer.data(), buffer.size(), static_cast<uint32_t>(::getpid()), options.name);
+		for (size_t i = 0; i < options.batch; ++i)
+		{
+			const uint64_t index = sent + writer.GetRecordCount();
+			const int length = std::snprintf(text, sizeof(text), "Motor \"Left\" Run(): reached target position %llu after 17 ms",
+				static_cast<unsigned long long>(index));
+			if (!writer.Add(LevelFor(index), std::string_view(text, static_cast<size_t>(length))))
+				break;
+		}
+
+		if (::send(fd, writer.Data(), writer.Size(), 0) == static_cast<ssize_t>(writer.Size()))
+			sent += writer.GetRecordCount();
+		else
+			failed += writer.GetRecordCount();
+
+		// Pace against the absolute schedule, so short sleeps do not accumulate drift
+		if (options.rate > 0)
+		{
+			const auto due = start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(static_cast<double>(sent) / options.rate));
+			if (due > Clock::now())
+				std::this_thread::sleep_until(due);
+		}
+
+		const auto now = Clock::now();
+		if (now >= nextReport)
+		{
+			std::printf("%8.3f M msgs/s  (%llu sent, %llu failed)\n", (sent - reported) / 1e6,
+				static_cast<unsigned long long>(sent), static_cast<unsigned long long>(failed));
+			std::fflush(stdout);
+			reported = sent;
+			nextReport += std::chrono::seconds(1);
+		}
+	}
+
+	const double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+	std::printf("total: %llu messages in %.2f s = %.3f M msgs/s, %llu failed\n",
+		static_cast<unsigned long long>(sent), elapsed, sent / elapsed / 1e6, static_cast<unsigned long long>(failed));
+	::close(fd);
+	return 0;
+#endif
+}
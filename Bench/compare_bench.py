@@ -0,0 +1,89 @@
+#!/usr/bin/env python3
+"""Compares two GearBench JSON results and flags regressions.
+
+Usage:
+    python3 compare_bench.py baseline.json current.json [--threshold 10] [--metrics real_time,p99_ns]
+
+A benchmark regresses if one of the compared metrics is more than 'threshold' percent worse than in the
+baseline (times and latency percentiles: higher is worse, items_per_second: lower is worse).
+Exits with 1 if any regression was found, so it can gate CI jobs.
+"""
+
+import argparse
+import json
+import os
+import sys
+
+HIGHER_IS_BETTER = {"items_per_second", "bytes_per_second"}
+DEFAULT_METRICS = "real_time,items_per_second,p99_ns"
+
+
+def load(path):
+    with open(path, encoding="utf-8") as f:
+        data = json.load(f)
+
+    results = {}
+    for bench in data.get("benchmarks", []):
+        # With --benchmark_repetitions only the median aggregate is compared
+        if bench.get("run_type") == "aggregate" and bench.get("aggregate_name") != "median":
+            continue
+        name = bench.get("run_name", bench["name"])
+        results[name] = bench
+    return results
+
+
+def change_percent(baseline, current, metric):
+    if baseline == 0:
+        return 0.0
+    change = (current - baseline) / baseline * 100.0
+    return -change if metric in HIGHER_IS_BETTER else change
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("baseline")
+    parser.add_argument("current")
+    parser.add_argument("--threshold", type=float, default=10.0, help="allowed slowdown in percent (default 10)")
+    parser.add_argument("--metrics", default=DEFAULT_METRICS, help="comma separated metrics (default %(default)s)")
+    args = parser.parse_args()
+
+    if not os.path.exists(args.baseline):
+        print(f"Baseline {args.baseline} not found, record one with: "
+              "GearBench --benchmark_out=<baseline.json> --benchmark_out_format=json")
+        return 2
+
+    baseline = load(args.baseline)
+    current = load(args.current)
+    metrics = [m.strip() for m in args.metrics.split(",") if m.strip()]
+
+    regressions = 0
+    print(f"{'Benchmark':<45} {'Metric':<18} {'Baseline':>14} {'Current':>14} {'Change':>9}")
+    for name, bench in current.items():
+        base = baseline.get(name)
+        if base is None:
+            print(f"{name:<45} {'(new)':<18}")
+            continue
+
+        for metric in metrics:
+            if metric not in bench or metric not in base:
+                continue
+            worse = change_percent(base[metric], bench[metric], metric)
+            flag = ""
+            if worse > args.threshold:
+                flag = "  REGRESSION"
+                regressions += 1
+            print(f"{name:<45} {metric:<18} {base[metric]:>14.1f} {bench[metric]:>14.1f} {worse:>+8.1f}%{flag}")
+
+    for name in baseline:
+        if name not in current:
+            print(f"{name:<45} {'(missing)':<18}")
+
+    if regressions:
+        print(f"\n{regressions} regression(s) beyond {args.threshold:.1f}%")
+        return 1
+    print("\nNo regressions")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -1,4 +1,5 @@
 ﻿#include <GLFW/glfw3.h>
+#include <algorithm>
 #include <stdexcept>
 
 #define STB_IMAGE_IMPLEMENTATION
@@ -16,6 +17,9 @@
 #include "Application.h"
 #include "GUI/GuiLayer.h"
 #include "Logger/Logger.h"
+#include "Profiler/FrameProfiler.h"
+#include "Trace/TraceRecorder.h"
+#include "Utils/RedrawScheduler.h"
 
 #ifdef _WIN32
 #include "Platform/Windows/WinBorderless.h"
@@ -37,6 +41,10 @@ static void glfwErrorCallback(int error, const char* description)
 
 namespace // internal linkage
 {
+	// Frames drawn after input or a redraw request before the loop may idle again, so hover states, popups and
+	// layout changes triggered by the last event settle
+	constexpr int SETTLE_FRAMES = 3;
+
 	GLFWimage MakeImage(const unsigned char* data, int len)
 	{
 		int w, h, comp;
@@ -141,15 +149,63 @@ namespace gear
 	void Application::Run()
 	{
 		LOG_INFO("Application started.");
+		TraceRecorder::SetThreadName("Main");
+		Logger::SetThreadName("Main");
+
+		// Requests from other threads interrupt glfwWaitEventsTimeout()
+		RedrawScheduler::SetWakeFunction([]() { glfwPostEmptyEvent(); });
+		int settleFrames = SETTLE_FRAMES;
+
 		while (!glfwWindowShouldClose(window))
 		{
-			glfwPollEvents();
+			// Idle rendering: nothing requested a redraw and the last input has settled, so block until new input,
+			// a request or the max idle interval. The profiler measures frame times and keeps the loop running.
+			const bool redrawRequested = RedrawScheduler::ConsumeRequest();
+			const bool idle = RedrawScheduler::IsIdleEnabled() && !redrawRequested && settleFrames == 0 && !FrameProfiler::IsEnabled();
+			if (idle)
+			{
+				GEAR_TRACE_SCOPE("WaitEvents");
+				const double timeout = RedrawScheduler::GetMaxIdleSeconds();
+				const double waitStart = glfwGetTime();
+				glfwWaitEventsTimeout(timeout);
+				// Woken early by input or a request: let it settle; a timeout only refreshes clocks and statistics
+				settleFrames = glfwGetTime() - waitStart < timeout * 0.9 ? SETTLE_FRAMES : 1;
+			}
+
+			{
+				GEAR_TRACE_SCOPE("Frame");
+				if (!idle)
+				{
+					GEAR_TRACE_SCOPE("PollEvents");
+					glfwPollEvents();
+				}
+
+				{
+					GEAR_TRACE_SCOPE("BeginFrame");
+					guiLayer.BeginFrame(window);
+				}
 
-			guiLayer.BeginFrame(window);
-			guiLayer.Render(window);
-			guiLayer.EndFrame(window);
+				// Held buttons, drags and text edits keep the loop running
+				if (ImGui::IsAnyItemActive() || ImGui::IsAnyMouseDown())
+					settleFrames = std::max(settleFrames, SETTLE_FRAMES);
+				{
+					GEAR_TRACE_SCOPE("Render");
+					guiLayer.Render(window);
+				}
+				{
+					GEAR_TRACE_SCOPE("EndFrame");
+					guiLayer.EndFrame(window);
+				}
+
+				GEAR_TRACE_SCOPE("SwapBuffers");
+				glfwSwapBuffers(window);
+			}
 
-			glfwSwapBuffers(window);
+			// After the "Frame" zone has ended, so it is part of the frame it measures
+			FrameProfiler::EndFrame();
+
+			if (settleFrames > 0)
+				--settleFrames;
 		}
 	}
 
@@ -284,10 +340,21 @@ namespace gear
 		}
 #endif
 
+#ifndef _WIN32
+		// Attach as consumer of the shared-memory log ring, worker processes log into the Logger window through it
+		shmLogConsumer = std::make_unique<ShmLogConsumer>(SHM_LOG_DEFAULT_NAME,
+			[](std::vector<LogMessage>& batch) { Logger::PushExternal(batch, true); });
+		if (shmLogConsumer->IsOpen())
+			LOG_INFO("Shared-memory log ring '{}' ready for worker processes", shmLogConsumer->GetName());
+		else
+			LOG_WARN("Shared-memory log ring unavailable: {}", shmLogConsumer->GetError());
+#endif
 	}
 
 	void Application::Shutdown()
 	{
+		RedrawScheduler::SetWakeFunction(nullptr); // No glfwPostEmptyEvent() after glfwTerminate()
+		shmLogConsumer.reset();
 		guiLayer.Shutdown();
 
 		glfwDestroyWindow(window);
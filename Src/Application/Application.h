@@ -1,6 +1,9 @@
 #pragma once
 
+#include <memory>
+
 #include "GUI/GuiLayer.h"
+#include "Ipc/ShmLogConsumer.h"
 
 namespace gear
 {
@@ -18,5 +21,6 @@ namespace gear
 
 		GLFWwindow* window = nullptr;
 		GuiLayer guiLayer;
+		std::unique_ptr<ShmLogConsumer> shmLogConsumer; // Log records of worker processes (ShmLogProducer)
 	};
 }
@@ -1,8 +1,9 @@
 ﻿#include <string>
-#include <algorithm>
+#include <string_view>
 
 #include "GuiIconListViewer.h"
 #include "Logger/Logger.h"
+#include "Utils/StringSearch.h"
 
 // Array with all regular icons (from Font Awesome 7 https://fontawesome.com/download)
 ImGuiIconDef ImGuiIconDefs[] = {
@@ -1970,9 +1971,7 @@ namespace gear
 		ImGui::SetNextItemWidth(250);
 		ImGui::InputText("Filter", filterText, IM_ARRAYSIZE(filterText));
 
-		// lowercase filter string
-		std::string filterLower = filterText;
-		std::transform(filterLower.begin(), filterLower.end(), filterLower.begin(), ::tolower);
+		const std::string_view filter = filterText;
 
 		// lambda to render icons
 		auto drawIconList = [&](ImGuiIconDef* list, int count)
@@ -1981,11 +1980,8 @@ namespace gear
 				{
 					const auto& entry = list[i];
 
-					std::string entryNameLower = entry.name;
-					std::transform(entryNameLower.begin(), entryNameLower.end(), entryNameLower.begin(), ::tolower);
-
-					// skip if filter does not match
-					if (!filterLower.empty() && entryNameLower.find(filterLower) == std::string::npos)
+					// skip if filter does not match (case-insensitive, no allocation per entry)
+					if (!filter.empty() && !gear::ContainsNoCase(entry.name, filter))
 						continue;
 
 					// wrap if no space
@@ -2,11 +2,16 @@
 #include <stb_image.h>
 #include <functional>
 #include <chrono>
+#include <ctime>
+#include <filesystem>
 
 #include "GuiLayer.h"
 #include "GuiMath.h"
 #include "GuiIconListViewer.h"
 #include "Logger/Logger.h"
+#include "Trace/TraceRecorder.h"
+#include "Platform/ProcessCpu.h"
+#include "Utils/RedrawScheduler.h"
 #include "imgui.h"
 #include "imgui_internal.h"
 #include "backends/imgui_impl_glfw.h"
@@ -375,8 +380,14 @@ namespace gear
 		}
 
 		// Render docked windows
-		ShowMainWindow();
-		ShowLoggerWindow();
+		{
+			GEAR_TRACE_SCOPE("ShowMainWindow");
+			ShowMainWindow();
+		}
+		{
+			GEAR_TRACE_SCOPE("ShowLoggerWindow");
+			ShowLoggerWindow();
+		}
 
 		if (showImGuiDemoWindow)
 			ImGui::ShowDemoWindow(&showImGuiDemoWindow);
@@ -385,9 +396,14 @@ namespace gear
 			ImPlot::ShowDemoWindow(&showImPlotDemoWindow);
 
 		if (showIconListViewerWindow)
+		{
+			GEAR_TRACE_SCOPE("ShowIconListView");
 			ShowIconListView(&showIconListViewerWindow);
+		}
 
 		ShowPixelInspector(&showPixelInspector);
+		ShowLoggerMetricsWindow(&showLoggerMetricsWindow);
+		ShowProfilerWindow(&showProfilerWindow);
 	}
 
 	void GuiLayer::EndFrame(GLFWwindow* window)
@@ -424,11 +440,45 @@ namespace gear
 			MenuItem{ "Show ImGui Demo", std::nullopt,       [this]() { showImGuiDemoWindow = true; }, false },
 			MenuItem{ "Show ImPlot Demo", std::nullopt,      [this]() { showImPlotDemoWindow = true; }, false },
 			MenuItem{ "Show Icon List Viewer", std::nullopt, [this]() { showIconListViewerWindow = true; }, false },
-			MenuItem{ "Show Pixel Inspector", std::nullopt,  [this]() { showPixelInspector = true; }, false }
+			MenuItem{ "Show Pixel Inspector", std::nullopt,  [this]() { showPixelInspector = true; }, false },
+			MenuItem{ "Show Logger Metrics", std::nullopt,   [this]() { showLoggerMetricsWindow = true; }, false },
+			MenuItem{ "Show Profiler", std::nullopt,         [this]() { showProfilerWindow = true; }, false }
+		} };
+
+		// Trace capture (GEAR_TRACE_* spans of all threads), exported as Chrome Trace JSON into the log folder
+		MenuDef traceMenu{ "Trace", {
+			MenuItem{ "Start Capture", std::nullopt, []() {
+				TraceRecorder::Start();
+				LOG_INFO("Trace capture started");
+			}, false },
+			MenuItem{ "Stop Capture and Export", std::nullopt, []() {
+				if (!TraceRecorder::IsCapturing())
+					return;
+				TraceRecorder::Stop();
+
+				const std::time_t now = std::time(nullptr);
+				std::tm localTime{};
+#ifdef _WIN32
+				localtime_s(&localTime, &now);
+#else
+				localtime_r(&now, &localTime);
+#endif
+				char fileName[64];
+				std::strftime(fileName, sizeof(fileName), "Trace_%Y%m%d_%H%M%S.json", &localTime);
+				const std::filesystem::path path = std::filesystem::path(Logger::LOG_FOLDER) / fileName;
+
+				std::string error;
+				if (TraceRecorder::ExportChromeTrace(path, &error))
+					LOG_INFO("Trace exported: {} ({} events, {} dropped), open it in ui.perfetto.dev or chrome://tracing",
+						path.string(), TraceRecorder::GetEventCount(), TraceRecorder::GetDroppedCount());
+				else
+					LOG_ERROR("Trace export failed: {}", error);
+			}, false }
 		} };
 
 		menus.push_back(std::move(fileMenu));
 		menus.push_back(std::move(viewMenu));
+		menus.push_back(std::move(traceMenu));
 	}
 
 	void GuiLayer::ApplyCustomDarkTheme()
@@ -928,12 +978,41 @@ namespace gear
 	{
 		ImGui::Begin("Main");
 
+		ImGui::SeparatorText("Frame Loop");
+
+		// Idle rendering: the loop waits for input or RedrawScheduler requests instead of drawing at vsync
+		bool idleRendering = RedrawScheduler::IsIdleEnabled();
+		if (ImGui::Checkbox("Idle rendering", &idleRendering))
+			RedrawScheduler::SetIdleEnabled(idleRendering);
+		ImGui::SetItemTooltip("Redraw only on input, new log messages, data updates and running animations");
+		ImGui::SameLine();
+		int maxIdleMs = static_cast<int>(RedrawScheduler::GetMaxIdleSeconds() * 1000.0 + 0.5);
+		ImGui::SetNextItemWidth(160.0f);
+		if (ImGui::SliderInt("Max idle [ms]", &maxIdleMs, 50, 2000))
+			RedrawScheduler::SetMaxIdleSeconds(maxIdleMs / 1000.0);
+		ImGui::SetItemTooltip("Longest time without a redraw while idle");
+
+		// Process CPU and frame rate over the last second, to compare both modes
+		static ProcessCpuMeter cpuMeter;
+		static int framesDrawn = 0;
+		static float framesPerSecond = 0.0f;
+		static double frameCountStart = ImGui::GetTime();
+		++framesDrawn;
+		if (ImGui::GetTime() - frameCountStart >= 1.0)
+		{
+			framesPerSecond = static_cast<float>(framesDrawn / (ImGui::GetTime() - frameCountStart));
+			framesDrawn = 0;
+			frameCountStart = ImGui::GetTime();
+		}
+		ImGui::Text("Process CPU %.1f %% of one core, %.1f frames/s", cpuMeter.Update(), framesPerSecond);
+
 		ImGui::SeparatorText("Plotting Tests");
 
 		// --- static globals for demo ---
 		static std::vector<double> xs, ys1, ys2;
 		static std::mutex data_mutex;
 		static std::atomic<bool> running{ false };
+		static std::atomic<bool> streaming{ true };
 		static std::thread worker;
 
 		// start worker once
@@ -945,6 +1024,11 @@ namespace gear
 				const int max_points = 500;
 
 				while (running) {
+					if (!streaming) {
+						std::this_thread::sleep_for(std::chrono::milliseconds(20));
+						continue;
+					}
+
 					t += dt;
 					double a = std::sin(t * 2.0) + 0.1 * ((std::rand() % 2000) / 1000.0 - 1.0);
 					double b = 0.5 * std::cos(t * 1.5) + 0.5;
@@ -960,6 +1044,7 @@ namespace gear
 							ys2.erase(ys2.begin());
 						}
 					}
+					RedrawScheduler::RequestRedraw(); // New samples to plot
 
 					std::this_thread::sleep_for(std::chrono::milliseconds(20));
 				}
@@ -975,6 +1060,10 @@ namespace gear
 			local_ys2 = ys2;
 		}
 
+		bool stream = streaming;
+		if (ImGui::Checkbox("Stream signals", &stream))
+			streaming = stream;
+
 		// plot
 		if (!local_xs.empty()) {
 			if (ImPlot::BeginPlot("Live Signals", ImVec2(-1, 200))) {
@@ -1025,6 +1114,7 @@ namespace gear
 
 		if (ImGui::Button("Generate 10k Logs"))
 		{
+			GEAR_TRACE_SCOPE("Generate 10k Logs");
 			auto start = std::chrono::high_resolution_clock::now();
 
 			for (int i = 0; i < 10000; ++i)
@@ -1038,6 +1128,7 @@ namespace gear
 
 		if (ImGui::Button("Benchmark (fmt-format, total 20k logs)"))
 		{
+			GEAR_TRACE_SCOPE("Benchmark fmt");
 			constexpr int totalLogs = 10000;
 
 			auto logVariants = [](int i) {
@@ -1072,6 +1163,8 @@ namespace gear
 			for (int t = 0; t < numThreads; ++t)
 			{
 				threads.emplace_back([=]() {
+					Logger::SetThreadName(fmt::format("Benchmark worker {}", t));
+					GEAR_TRACE_SCOPE("Benchmark worker");
 					for (int i = 0; i < logsPerThread; ++i)
 						logVariants(t * logsPerThread + i);
 					});
@@ -1085,6 +1178,7 @@ namespace gear
 
 		if (ImGui::Button("Benchmark (manual concat, total 20k logs)"))
 		{
+			GEAR_TRACE_SCOPE("Benchmark manual concat");
 			constexpr int totalLogs = 10000;
 
 			auto logVariantsNoFmt = [](int i) {
@@ -1119,6 +1213,8 @@ namespace gear
 			for (int t = 0; t < numThreads; ++t)
 			{
 				threads.emplace_back([=]() {
+					Logger::SetThreadName(fmt::format("Benchmark worker {}", t));
+					GEAR_TRACE_SCOPE("Benchmark worker");
 					for (int i = 0; i < logsPerThread; ++i)
 						logVariantsNoFmt(t * logsPerThread + i);
 					});
@@ -1144,161 +1240,6 @@ namespace gear
 		}
 	}
 
-	void GuiLayer::ShowLoggerWindow()
-	{
-		ImGui::Begin("Logger");
-
-		static bool autoScroll = true;
-		ImGui::Checkbox("Auto Scroll", &autoScroll);
-
-		static bool showFilter = false;
-		static ImGuiTextFilter filter;
-		ImGui::SameLine();
-		ImGui::Checkbox("Enable Filter", &showFilter);
-
-		const auto& buffer = Logger::GetBuffer();
-		const size_t readIndex = Logger::GetReadIndex();
-		const size_t logCount = Logger::GetSize();
-		const size_t capacity = buffer.size();
-
-		constexpr ImGuiTableFlags tableFlags = ImGuiTableFlags_ScrollY | ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_RowBg;
-		const float availHeight = ImGui::GetContentRegionAvail().y;
-		static float levelWidth = ImGui::CalcTextSize("ERROR").x;
-		static float timeWidth = ImGui::CalcTextSize("[2099:05:23 15:37:51.051]").x;
-		float topHeight = showFilter ? (availHeight * 0.66f - ImGui::GetFrameHeightWithSpacing()) : availHeight;
-		static size_t scrollToIndex = SIZE_MAX;
-
-		auto toImVec4 = [](const LogMessageColor& c) -> ImVec4 {
-			return ImVec4(c.r, c.g, c.b, c.a);
-			};
-
-		// Main log table (top)
-		if (ImGui::BeginChild("##LogMain", ImVec2(0, topHeight), ImGuiChildFlags_Borders))
-		{
-			if (ImGui::BeginTable("LogTable", 3, tableFlags))
-			{
-				ImGui::TableSetupScrollFreeze(0, 1);
-				ImGui::TableSetupColumn("Level", ImGuiTableColumnFlags_WidthFixed, levelWidth);
-				ImGui::TableSetupColumn("Time", ImGuiTableColumnFlags_WidthFixed, timeWidth);
-				ImGui::TableSetupColumn("Message", ImGuiTableColumnFlags_WidthStretch);
-				ImGui::TableHeadersRow();
-
-				if (scrollToIndex != SIZE_MAX)
-				{
-					int relativeRow = static_cast<int>((scrollToIndex + capacity - readIndex) % capacity);
-					float rowHeight = ImGui::GetTextLineHeightWithSpacing();
-					float targetY = relativeRow * rowHeight;
-					float scrollY = std::max(0.0f, targetY - ImGui::GetWindowHeight() * 0.5f + rowHeight); // + rowHeight because of header!
-					ImGui::SetScrollY(scrollY);
-					scrollToIndex = SIZE_MAX;
-				}
-
-				ImGuiListClipper clipper;
-				clipper.Begin(static_cast<int>(logCount));
-
-				while (clipper.Step())
-				{
-					for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i)
-					{
-						// Calculate actual index in the ring buffer
-						size_t bufferIndex = (readIndex + i) % capacity;
-						const LogMessage& msg = buffer[bufferIndex];
-
-						// Create time string
-						char timeString[80];
-						msg.FormatTimestamp(timeString, sizeof(timeString));
-
-						ImGui::TableNextRow();
-
-						ImGui::PushStyleColor(ImGuiCol_Text, toImVec4(msg.LevelColor()));
-
-						ImGui::TableSetColumnIndex(0);
-						ImGui::TextUnformatted(msg.FormatLevel());
-
-						ImGui::TableSetColumnIndex(1);
-						ImGui::TextUnformatted(timeString);
-
-						ImGui::TableSetColumnIndex(2);
-						ImGui::TextUnformatted(msg.message.c_str());
-
-						ImGui::PopStyleColor();
-					}
-				}
-				if (autoScroll && Logger::ShouldScrollToBottom())
-					ImGui::SetScrollHereY(1.0f);
-				ImGui::EndTable();
-			}
-		}
-		ImGui::EndChild();
-
-		// Filtered log table (bottom)
-		if (showFilter)
-		{
-			filter.Draw("Filter", 200.0f);
-
-			static std::vector<size_t> filteredIndices;
-			filteredIndices.clear();
-
-			if (filter.IsActive())
-			{
-				for (size_t i = 0; i < logCount; ++i)
-				{
-					const size_t index = (readIndex + i) % capacity;
-					const LogMessage& msg = buffer[index];
-					if (filter.PassFilter(msg.message.c_str()))
-						filteredIndices.push_back(index);
-				}
-			}
-
-			if (ImGui::BeginChild("##Filtered", ImVec2(0, 0), ImGuiChildFlags_Borders))
-			{
-				if (ImGui::BeginTable("FilteredTable", 3, tableFlags))
-				{
-					ImGui::TableSetupColumn("Level", ImGuiTableColumnFlags_WidthFixed, levelWidth);
-					ImGui::TableSetupColumn("Time", ImGuiTableColumnFlags_WidthFixed, timeWidth);
-					ImGui::TableSetupColumn("Message", ImGuiTableColumnFlags_WidthStretch);
-
-					ImGuiListClipper clipper;
-					clipper.Begin(static_cast<int>(filteredIndices.size()));
-
-					while (clipper.Step())
-					{
-						for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i)
-						{
-							// Get the filtered entry
-							const size_t index = filteredIndices[i];
-							const LogMessage& msg = buffer[index];
-
-							// Create time string
-							char timeString[80];
-							msg.FormatTimestamp(timeString, sizeof(timeString));
-
-							ImGui::TableNextRow();
-
-							ImGui::PushStyleColor(ImGuiCol_Text, toImVec4(msg.LevelColor()));
-
-							ImGui::TableSetColumnIndex(0);
-							ImGui::TextUnformatted(msg.FormatLevel());
-
-							ImGui::TableSetColumnIndex(1);
-							ImGui::TextUnformatted(timeString);
-
-							ImGui::TableSetColumnIndex(2);
-							ImGui::TextUnformatted(msg.message.c_str());
-							if (ImGui::IsItemClicked())
-								scrollToIndex = index;
-
-							ImGui::PopStyleColor();
-						}
-					}
-					ImGui::EndTable();
-				}
-			}
-			ImGui::EndChild();
-		}
-		ImGui::End();
-	}
-
 	GLuint CaptureScreenRegionToTexture(const ImRect& rect)
 	{
 		const ImGuiViewport* vp = ImGui::GetMainViewport();
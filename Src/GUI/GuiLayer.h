@@ -56,6 +56,8 @@ namespace gear
 		void ShowMainWindow();
 		void ShowLoggerWindow();
 		void ShowPixelInspector(bool* p_open = nullptr);
+		void ShowLoggerMetricsWindow(bool* p_open);
+		void ShowProfilerWindow(bool* p_open);
 
 		// State
 		float titleBarHeight = 32.0f; // Windows Standard
@@ -67,6 +69,8 @@ namespace gear
 		bool showImPlotDemoWindow = false;
 		bool showIconListViewerWindow = false;
 		bool showPixelInspector = false;
+		bool showLoggerMetricsWindow = false;
+		bool showProfilerWindow = false;
 
 		// Menu-Registry
 		std::vector<MenuDef> menus;
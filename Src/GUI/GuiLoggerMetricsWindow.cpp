@@ -0,0 +1,165 @@
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include "GuiLayer.h"
+#include "Logger/Logger.h"
+#include "Logger/LoggerMetrics.h"
+#include "imgui.h"
+#include "implot.h"
+
+namespace
+{
+	constexpr double SAMPLE_INTERVAL_S = 0.25;
+	constexpr size_t MAX_SAMPLES = 240; // 60 s of history
+
+	// Rolling series derived from consecutive snapshots
+	struct MetricsHistory
+	{
+		std::vector<double> times;
+		std::vector<double> pushesPerSecond;
+		std::vector<double> queueDepth;
+		std::vector<double> p99Us;
+
+		void Add(double t, double rate, double depth, double p99)
+		{
+			if (times.size() >= MAX_SAMPLES)
+			{
+				times.erase(times.begin());
+				pushesPerSecond.erase(pushesPerSecond.begin());
+				queueDepth.erase(queueDepth.begin());
+				p99Us.erase(p99Us.begin());
+			}
+			times.push_back(t);
+			pushesPerSecond.push_back(rate);
+			queueDepth.push_back(depth);
+			p99Us.push_back(p99);
+		}
+	};
+
+	double ToMicroseconds(uint64_t ns) { return static_cast<double>(ns) / 1000.0; }
+}
+
+namespace gear
+{
+	void GuiLayer::ShowLoggerMetricsWindow(bool* p_open)
+	{
+		if (!*p_open)
+			return;
+
+		static LoggerMetricsSnapshot current = Logger::GetMetrics();
+		static LoggerMetricsSnapshot previous = current;
+		static const auto startTime = current.takenAt;
+		static MetricsHistory history;
+
+		// Sample at a fixed rate, rates are computed from the delta between two snapshots
+		const auto now = std::chrono::steady_clock::now();
+		if (std::chrono::duration<double>(now - current.takenAt).count() >= SAMPLE_INTERVAL_S)
+		{
+			previous = current;
+			current = Logger::GetMetrics();
+
+			const double dt = std::chrono::duration<double>(current.takenAt - previous.takenAt).count();
+			const double rate = dt > 0.0 ? static_cast<double>(current.ringPushes - previous.ringPushes) / dt : 0.0;
+			history.Add(std::chrono::duration<double>(current.takenAt - startTime).count(), rate,
+				static_cast<double>(current.file.queueDepth), ToMicroseconds(current.enqueueLatency.GetPercentile(99.0)));
+		}
+
+		ImGui::SetNextWindowSize(ImVec2(640, 560), ImGuiCond_FirstUseEver);
+		if (!ImGui::Begin("Logger Metrics", p_open))
+		{
+			ImGui::End();
+			return;
+		}
+
+		const LatencyHistogram& latency = current.enqueueLatency;
+		const LogFileStats& file = current.file;
+
+		if (ImGui::BeginTable("##LoggerMetricsTable", 4, ImGuiTableFlags_SizingStretchSame))
+		{
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn(); ImGui::Text("Pushes/s: %.0f", history.pushesPerSecond.empty() ? 0.0 : history.pushesPerSecond.back());
+			ImGui::TableNextColumn(); ImGui::Text("Total: %llu", static_cast<unsigned long long>(current.ringPushes));
+			ImGui::TableNextColumn(); ImGui::Text("Threads: %zu", current.producerThreads);
+			ImGui::TableNextColumn(); ImGui::Text("Samples: %llu", static_cast<unsigned long long>(latency.GetCount()));
+
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn(); ImGui::Text("p50: %.2f us", ToMicroseconds(latency.GetPercentile(50.0)));
+			ImGui::TableNextColumn(); ImGui::Text("p99: %.2f us", ToMicroseconds(latency.GetPercentile(99.0)));
+			ImGui::TableNextColumn(); ImGui::Text("p99.9: %.2f us", ToMicroseconds(latency.GetPercentile(99.9)));
+			ImGui::TableNextColumn(); ImGui::Text("max: %.2f us", ToMicroseconds(latency.GetMax()));
+
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn(); ImGui::Text("Queue: %llu", static_cast<unsigned long long>(file.queueDepth));
+			ImGui::TableNextColumn(); ImGui::Text("High-water: %llu", static_cast<unsigned long long>(file.queueHighWater));
+			ImGui::TableNextColumn();
+			if (file.droppedMessages > 0)
+				ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), "Dropped: %llu", static_cast<unsigned long long>(file.droppedMessages));
+			else
+				ImGui::Text("Dropped: 0");
+			ImGui::TableNextColumn(); ImGui::Text("Written: %.2f MB", static_cast<double>(file.bytesWritten) / (1024.0 * 1024.0));
+
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn(); ImGui::Text("Rotations: %llu", static_cast<unsigned long long>(file.rotations));
+			ImGui::TableNextColumn(); ImGui::Text("Last rotation: %.2f ms", static_cast<double>(file.lastRotationNs) / 1e6);
+			ImGui::TableNextColumn(); ImGui::Text("Max rotation: %.2f ms", static_cast<double>(file.maxRotationNs) / 1e6);
+			ImGui::TableNextColumn(); ImGui::Text("Lines: %llu", static_cast<unsigned long long>(file.linesWritten));
+
+			ImGui::TableNextRow();
+			ImGui::TableNextColumn(); ImGui::Text("Syncs: %llu", static_cast<unsigned long long>(file.syncs));
+			ImGui::TableNextColumn();
+			if (file.writeErrors > 0)
+				ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), "Write errors: %llu", static_cast<unsigned long long>(file.writeErrors));
+			else
+				ImGui::Text("Write errors: 0");
+			ImGui::EndTable();
+		}
+
+		const int sampleCount = static_cast<int>(history.times.size());
+		if (sampleCount > 0 && ImPlot::BeginPlot("Throughput", ImVec2(-1, 180)))
+		{
+			const double tmax = history.times.back();
+			ImPlot::SetupAxes("Time [s]", "Pushes/s", 0, ImPlotAxisFlags_AutoFit);
+			ImPlot::SetupAxis(ImAxis_Y2, "Queue depth", ImPlotAxisFlags_AuxDefault | ImPlotAxisFlags_AutoFit);
+			ImPlot::SetupAxisLimits(ImAxis_X1, tmax - MAX_SAMPLES * SAMPLE_INTERVAL_S, tmax, ImGuiCond_Always);
+
+			ImPlot::PlotLine("Pushes/s", history.times.data(), history.pushesPerSecond.data(), sampleCount);
+			ImPlot::SetAxes(ImAxis_X1, ImAxis_Y2);
+			ImPlot::PlotLine("Queue depth", history.times.data(), history.queueDepth.data(), sampleCount);
+			ImPlot::EndPlot();
+		}
+
+		// Enqueue latency distribution: bucket lower bounds on a log axis, empty tail buckets trimmed
+		static std::vector<double> bucketXs, bucketYs;
+		bucketXs.clear();
+		bucketYs.clear();
+		const auto& buckets = latency.GetBuckets();
+		size_t lastUsed = 0;
+		for (size_t i = 0; i < buckets.size(); ++i)
+			if (buckets[i])
+				lastUsed = i;
+		for (size_t i = 1; i <= std::min(lastUsed + 1, buckets.size() - 1); ++i)
+		{
+			bucketXs.push_back(static_cast<double>(LatencyHistogram::BucketLowerBound(i)));
+			bucketYs.push_back(static_cast<double>(buckets[i]));
+		}
+
+		if (!bucketXs.empty() && ImPlot::BeginPlot("Enqueue Latency", ImVec2(-1, -1)))
+		{
+			ImPlot::SetupAxes("Latency [ns]", "Count", ImPlotAxisFlags_AutoFit, ImPlotAxisFlags_AutoFit);
+			ImPlot::SetupAxisScale(ImAxis_X1, ImPlotScale_Log10);
+			ImPlot::PlotStairs("Enqueue", bucketXs.data(), bucketYs.data(), static_cast<int>(bucketXs.size()), ImPlotStairsFlags_Shaded);
+
+			// Percentile markers
+			const double markers[] = {
+				static_cast<double>(latency.GetPercentile(50.0)),
+				static_cast<double>(latency.GetPercentile(99.0)),
+				static_cast<double>(latency.GetPercentile(99.9)) };
+			ImPlot::PlotInfLines("p50 / p99 / p99.9", markers, 3);
+			ImPlot::EndPlot();
+		}
+
+		ImGui::End();
+	}
+}
@@ -0,0 +1,1365 @@
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <memory>
+#include <filesystem>
+#include <chrono>
+#include <climits>
+#include <cstdint>
+#include <cmath>
+#include <cstdio>
+#include <cfloat>
+#include <cstdlib>
+#include <string_view>
+
+#include "GuiLayer.h"
+#include "Logger/Logger.h"
+#include "Logger/LogSearchWorker.h"
+#include "Logger/LogHistory.h"
+#include "Logger/LogFileTail.h"
+#include "Logger/LogSources.h"
+#include "Logger/LogSymbols.h"
+#include "Logger/LogRateSeries.h"
+#include "Logger/LogGroups.h"
+#include "Logger/LogExporter.h"
+#include "Utils/FenwickTree.h"
+#include "Utils/RedrawScheduler.h"
+#include "Ipc/LogSocketServer.h"
+#include "imgui.h"
+#include "implot.h"
+
+namespace
+{
+	ImVec4 ToImVec4(const LogMessageColor& c)
+	{
+		return ImVec4(c.r, c.g, c.b, c.a);
+	}
+
+	// External log files followed into the Logger window (source list above the tables)
+	void ShowTailSources(std::vector<std::unique_ptr<LogFileTail>>& tails)
+	{
+		static char tailPath[512] = "";
+		static bool tailFromStart = false;
+
+		ImGui::SetNextItemWidth(300.0f);
+		ImGui::InputTextWithHint("##TailPath", "/var/log/daemon.log", tailPath, IM_ARRAYSIZE(tailPath));
+		ImGui::SameLine();
+		ImGui::Checkbox("From start", &tailFromStart);
+		ImGui::SameLine();
+		if (ImGui::Button("Tail File") && tailPath[0] != '\0')
+		{
+			const std::filesystem::path path = tailPath;
+			const uint16_t sourceId = LogSources::Register(path.filename().string(), LogSources::DefaultColor(tails.size()));
+			tails.push_back(std::make_unique<LogFileTail>(path, sourceId,
+				[](std::vector<LogMessage>& batch) { Logger::PushExternal(batch); }, tailFromStart));
+			tailPath[0] = '\0';
+		}
+
+		for (size_t i = 0; i < tails.size(); )
+		{
+			const LogFileTail& tail = *tails[i];
+			ImGui::PushID(static_cast<int>(i));
+
+			LogMessageColor color = LogSources::GetColor(tail.GetSourceId());
+			float rgb[3] = { color.r, color.g, color.b };
+			if (ImGui::ColorEdit3("##Color", rgb, ImGuiColorEditFlags_NoInputs))
+				LogSources::SetColor(tail.GetSourceId(), LogMessageColor(rgb[0], rgb[1], rgb[2]));
+
+			ImGui::SameLine();
+			ImGui::Text("%s  (%llu lines, %.1f MB)", tail.GetPath().string().c_str(),
+				static_cast<unsigned long long>(tail.GetLineCount()), tail.GetByteCount() / (1024.0 * 1024.0));
+
+			std::string error = tail.GetError();
+			if (!error.empty())
+			{
+				ImGui::SameLine();
+				ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), "%s", error.c_str());
+			}
+
+			ImGui::SameLine();
+			const bool remove = ImGui::SmallButton("Remove");
+			ImGui::PopID();
+
+			if (remove)
+				tails.erase(tails.begin() + i); // Joins the worker thread
+			else
+				++i;
+		}
+
+		// Socket ingestion: batched binary datagrams from local tools (see Ipc/LogDatagram.h)
+		static std::unique_ptr<gear::LogSocketServer> socketServer;
+		static char socketAddress[256] = "";
+		if (socketAddress[0] == '\0')
+			std::snprintf(socketAddress, sizeof(socketAddress), "%s", gear::LogSocketServer::DEFAULT_ADDRESS);
+
+		bool socketEnabled = socketServer != nullptr;
+		if (ImGui::Checkbox("Socket ingest", &socketEnabled))
+		{
+			if (socketEnabled)
+				socketServer = std::make_unique<gear::LogSocketServer>(socketAddress,
+					[](LogMessage* messages, size_t count) { Logger::PushExternal(messages, count); });
+			else
+				socketServer.reset(); // Joins the ingestion thread and removes the socket file
+		}
+		ImGui::SetItemTooltip("Receive log datagrams on a Unix socket path or udp://PORT (loopback only)");
+
+		ImGui::SameLine();
+		ImGui::BeginDisabled(socketServer != nullptr);
+		ImGui::SetNextItemWidth(220.0f);
+		ImGui::InputText("##SocketAddress", socketAddress, IM_ARRAYSIZE(socketAddress));
+		ImGui::EndDisabled();
+
+		if (socketServer)
+		{
+			ImGui::SameLine();
+			if (socketServer->IsListening())
+				ImGui::Text("(%llu records, %llu datagrams, %llu rejected)",
+					static_cast<unsigned long long>(socketServer->GetRecordCount()),
+					static_cast<unsigned long long>(socketServer->GetDatagramCount()),
+					static_cast<unsigned long long>(socketServer->GetRejectedCount()));
+			else
+				ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), "%s", socketServer->GetError().c_str());
+		}
+	}
+
+	// Compact per-level rate strip (stacked bars, one per second). Returns true if a bucket was clicked,
+	// 'clicked' then holds that second and the first ring sequence pushed in it.
+	bool ShowRateStrip(LogRateSeries::Bucket& clicked)
+	{
+		static const char* const levelLabels[LOG_LEVEL_COUNT] = { "Info", "Warn", "Error", "Debug" };
+		static const int windowSeconds[] = { 60, 600, 3600 };
+		static int windowChoice = 1;
+		static std::vector<LogRateSeries::Bucket> buckets;
+		static std::vector<float> values; // Level-major, as PlotBarGroups expects
+
+		ImGui::SetNextItemWidth(80.0f);
+		ImGui::Combo("##RateWindow", &windowChoice, "1 min\0" "10 min\0" "60 min\0");
+		ImGui::SetItemTooltip("Time range of the rate strip, click a bar to jump to that second");
+
+		const int64_t nowSecond = LogRateSeries::ToEpochSecond(std::chrono::system_clock::now());
+		const size_t seconds = static_cast<size_t>(windowSeconds[windowChoice]);
+		Logger::GetRateSeries().Snapshot(nowSecond, seconds, buckets);
+
+		values.resize(LOG_LEVEL_COUNT * seconds);
+		for (size_t level = 0; level < LOG_LEVEL_COUNT; ++level)
+			for (size_t i = 0; i < seconds; ++i)
+				values[level * seconds + i] = static_cast<float>(buckets[i].counts[level]);
+
+		// Level colors as a colormap, registered once
+		static ImPlotColormap levelColormap = -1;
+		if (levelColormap < 0)
+		{
+			ImVec4 colors[LOG_LEVEL_COUNT];
+			for (size_t level = 0; level < LOG_LEVEL_COUNT; ++level)
+				colors[level] = ToImVec4(LogMessage(static_cast<LogLevel>(level), "").LevelColor());
+			levelColormap = ImPlot::GetColormapIndex("LogLevels");
+			if (levelColormap < 0)
+				levelColormap = ImPlot::AddColormap("LogLevels", colors, LOG_LEVEL_COUNT);
+		}
+
+		bool wasClicked = false;
+		constexpr ImPlotFlags plotFlags = ImPlotFlags_NoTitle | ImPlotFlags_NoMenus | ImPlotFlags_NoBoxSelect | ImPlotFlags_NoMouseText;
+		ImPlot::PushColormap(levelColormap);
+		if (ImPlot::BeginPlot("##LogRates", ImVec2(-1, 90.0f * ImGui::GetIO().FontGlobalScale), plotFlags))
+		{
+			// x = seconds relative to now (0 = current second)
+			const double first = -static_cast<double>(seconds - 1);
+			ImPlot::SetupAxes(nullptr, nullptr, ImPlotAxisFlags_NoLabel, ImPlotAxisFlags_AutoFit | ImPlotAxisFlags_NoLabel);
+			ImPlot::SetupAxisLimits(ImAxis_X1, first - 0.5, 0.5, ImGuiCond_Always);
+			ImPlot::SetupLegend(ImPlotLocation_NorthWest, ImPlotLegendFlags_Horizontal);
+			ImPlot::PlotBarGroups(levelLabels, values.data(), static_cast<int>(LOG_LEVEL_COUNT), static_cast<int>(seconds), 1.0, first, ImPlotBarGroupsFlags_Stacked);
+
+			if (ImPlot::IsPlotHovered())
+			{
+				const double mouseX = ImPlot::GetPlotMousePos().x;
+				const long long index = static_cast<long long>(std::floor(mouseX - first + 0.5));
+				if (index >= 0 && index < static_cast<long long>(seconds))
+				{
+					const LogRateSeries::Bucket& bucket = buckets[static_cast<size_t>(index)];
+					char timeString[80];
+					LogMessage stamp;
+					stamp.timestamp = std::chrono::system_clock::time_point(std::chrono::seconds(bucket.second));
+					stamp.FormatTimestamp(timeString, sizeof(timeString));
+					ImGui::SetTooltip("%s\n%u info, %u warnings, %u errors, %u debug", timeString,
+						bucket.counts[0], bucket.counts[1], bucket.counts[2], bucket.counts[3]);
+
+					if (ImGui::IsMouseClicked(ImGuiMouseButton_Left) && bucket.Total() > 0)
+					{
+						clicked = bucket;
+						wasClicked = true;
+					}
+				}
+			}
+			ImPlot::EndPlot();
+		}
+		ImPlot::PopColormap();
+		return wasClicked;
+	}
+
+	// Ring capacity selector with the memory cost of each choice: the entries themselves plus the heap text
+	// of an average message (sampled from the newest entries, short texts live inside the entry)
+	void ShowCapacitySelector()
+	{
+		static const size_t choices[] = { 10000, 100000, 1000000, 10000000 };
+		static const char* const labels[] = { "10k", "100k", "1M", "10M" };
+
+		// Swaps in the storage of a running resize once it is ready, before this frame reads the ring
+		Logger::FinishBufferResize();
+		const bool resizing = Logger::IsBufferResizing();
+		if (resizing)
+			gear::RedrawScheduler::RequestRedraw();
+
+		const size_t current = Logger::GetBufferCapacity();
+		const char* preview = "Custom";
+		for (size_t i = 0; i < IM_ARRAYSIZE(choices); ++i)
+			if (choices[i] == current)
+				preview = labels[i];
+
+		ImGui::SetNextItemWidth(70.0f);
+		ImGui::BeginDisabled(resizing);
+		const bool comboOpen = ImGui::BeginCombo("##Capacity", resizing ? "Resizing" : preview);
+		ImGui::EndDisabled();
+		if (comboOpen)
+		{
+			const auto& buffer = Logger::GetBuffer();
+			const size_t size = Logger::GetSize();
+			const size_t samples = std::min<size_t>(size, 256);
+			double heapBytes = 0.0;
+			for (size_t i = 0; i < samples; ++i)
+			{
+				const std::string& text = buffer[(Logger::GetReadIndex() + size - 1 - i) % buffer.size()].message;
+				if (text.capacity() > std::string().capacity())
+					heapBytes += static_cast<double>(text.capacity() + 1);
+			}
+			const double bytesPerEntry = sizeof(LogMessage) + (samples > 0 ? heapBytes / samples : 0.0);
+
+			for (size_t i = 0; i < IM_ARRAYSIZE(choices); ++i)
+			{
+				char item[64];
+				std::snprintf(item, sizeof(item), "%s  (~%.0f MB)", labels[i], choices[i] * bytesPerEntry / (1024.0 * 1024.0));
+				if (ImGui::Selectable(item, choices[i] == current))
+					Logger::SetBufferCapacity(choices[i]);
+			}
+			ImGui::EndCombo();
+		}
+		ImGui::SetItemTooltip("Entries kept in memory (%zu). Resizing keeps the newest entries.", current);
+	}
+
+	// Rows of the main table an export can cover: history rows [0, historyCount) above the ring sequences
+	// [oldestSequence, oldestSequence + logCount). Visible rows are the rows drawn in the last frame.
+	struct ExportRows
+	{
+		std::shared_ptr<const LogHistory::Snapshot> history; // Null while history is hidden
+		size_t historyCount = 0;
+		uint64_t oldestSequence = 0;
+		size_t logCount = 0;
+		size_t firstVisibleRow = 0;
+		size_t endVisibleRow = 0;
+	};
+
+	// Export popup (opened by the "Export..." button): format, rows and target file. The file is written by
+	// 'exporter' in the background, the progress shows next to the button.
+	void ShowExportPopup(LogExporter& exporter, const ExportRows& rows, const char* queryText)
+	{
+		static int format = 0;
+		static int scope = 0;
+		static char path[512] = "";
+		if (path[0] == '\0')
+			std::snprintf(path, sizeof(path), "%s/Export%s", Logger::LOG_FOLDER, LogExporter::GetExtension(LogExporter::Format::Text));
+
+		if (!ImGui::BeginPopup("Export"))
+			return;
+
+		static const char* const formatLabels[] = { "Text (Gear.log format)", "JSON lines", "Binary (LogDatagram)" };
+		ImGui::SetNextItemWidth(220.0f);
+		if (ImGui::Combo("Format", &format, formatLabels, IM_ARRAYSIZE(formatLabels)))
+		{
+			std::filesystem::path target = path;
+			target.replace_extension(LogExporter::GetExtension(static_cast<LogExporter::Format>(format)));
+			std::snprintf(path, sizeof(path), "%s", target.string().c_str());
+		}
+
+		const bool hasQuery = queryText[0] != '\0';
+		if (!hasQuery && scope == 1)
+			scope = 0;
+		ImGui::RadioButton("Visible rows", &scope, 0);
+		ImGui::SameLine();
+		ImGui::BeginDisabled(!hasQuery);
+		ImGui::RadioButton("Filter matches", &scope, 1);
+		ImGui::EndDisabled();
+		ImGui::SetItemTooltip("Rows matching the filter query (%s)", hasQuery ? queryText : "no query");
+		ImGui::SameLine();
+		ImGui::RadioButton("All rows", &scope, 2);
+		ImGui::SetItemTooltip("Every entry in memory, and the log files while History is shown");
+
+		ImGui::SetNextItemWidth(360.0f);
+		ImGui::InputText("File", path, IM_ARRAYSIZE(path));
+
+		if (ImGui::Button("Start") && path[0] != '\0')
+		{
+			LogExporter::Job job;
+			job.path = path;
+			job.format = static_cast<LogExporter::Format>(format);
+			size_t first = 0;
+			size_t end = rows.historyCount + rows.logCount;
+			if (scope == 0)
+			{
+				first = std::min(rows.firstVisibleRow, end);
+				end = std::clamp(rows.endVisibleRow, first, end);
+			}
+			else if (scope == 1)
+				job.query = queryText;
+
+			if (rows.history && first < rows.historyCount)
+			{
+				job.history = rows.history;
+				job.historyBegin = first;
+				job.historyEnd = std::min(end, rows.historyCount);
+			}
+			job.ringBegin = rows.oldestSequence + (std::max(first, rows.historyCount) - rows.historyCount);
+			job.ringEnd = rows.oldestSequence + (std::max(end, rows.historyCount) - rows.historyCount);
+			exporter.Start(std::move(job));
+			ImGui::CloseCurrentPopup();
+		}
+		ImGui::SameLine();
+		if (ImGui::Button("Close"))
+			ImGui::CloseCurrentPopup();
+		ImGui::EndPopup();
+	}
+
+	// Grouped view: one row per log site ("Function(): format string") with its count, rate over the last
+	// two minutes and first/last time. LogGroups keeps the aggregates as messages arrive, the window only copies
+	// them 4 times per second. Returns the last sequence of a clicked group (to jump there), UINT64_MAX otherwise.
+	uint64_t ShowGroupsTable(float height, float timeWidth)
+	{
+		static std::vector<LogGroups::Group> groups;
+		static double lastRefresh = -1.0;
+		bool refreshed = false;
+		if (lastRefresh < 0.0 || ImGui::GetTime() - lastRefresh > 0.25)
+		{
+			Logger::GetGroups().Snapshot(LogRateSeries::ToEpochSecond(std::chrono::system_clock::now()), groups);
+			lastRefresh = ImGui::GetTime();
+			refreshed = true;
+		}
+
+		auto formatTime = [](int64_t ns, char* out, size_t size)
+			{
+				LogMessage stamp;
+				stamp.timestamp = FromEpochNanoseconds(ns);
+				stamp.FormatTimestamp(out, size);
+			};
+
+		uint64_t clickedSequence = UINT64_MAX;
+		constexpr ImGuiTableFlags flags = ImGuiTableFlags_ScrollY | ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_RowBg | ImGuiTableFlags_Sortable;
+		if (ImGui::BeginTable("GroupTable", 5, flags, ImVec2(0, height)))
+		{
+			ImGui::TableSetupScrollFreeze(0, 1);
+			ImGui::TableSetupColumn("Count", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_DefaultSort | ImGuiTableColumnFlags_PreferSortDescending,
+				ImGui::CalcTextSize("0000000000").x);
+			ImGui::TableSetupColumn("Rate (2 min)", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_NoSort, 120.0f);
+			ImGui::TableSetupColumn("First", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_PreferSortDescending, timeWidth);
+			ImGui::TableSetupColumn("Last", ImGuiTableColumnFlags_WidthFixed | ImGuiTableColumnFlags_PreferSortDescending, timeWidth);
+			ImGui::TableSetupColumn("Log site", ImGuiTableColumnFlags_WidthStretch);
+			ImGui::TableHeadersRow();
+
+			ImGuiTableSortSpecs* specs = ImGui::TableGetSortSpecs();
+			if (specs && specs->SpecsCount > 0 && (specs->SpecsDirty || refreshed))
+			{
+				const ImGuiTableColumnSortSpecs sort = specs->Specs[0];
+				std::stable_sort(groups.begin(), groups.end(), [sort](const LogGroups::Group& a, const LogGroups::Group& b)
+					{
+						const LogGroups::Group& x = sort.SortDirection == ImGuiSortDirection_Ascending ? a : b;
+						const LogGroups::Group& y = sort.SortDirection == ImGuiSortDirection_Ascending ? b : a;
+						switch (sort.ColumnIndex)
+						{
+						case 0: return x.count < y.count;
+						case 2: return x.firstNs < y.firstNs;
+						case 3: return x.lastNs < y.lastNs;
+						default: return LogSymbols::GetText(x.siteId) < LogSymbols::GetText(y.siteId);
+						}
+					});
+				specs->SpecsDirty = false;
+			}
+
+			ImGuiListClipper clipper;
+			clipper.Begin(static_cast<int>(groups.size()));
+			while (clipper.Step())
+			{
+				for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i)
+				{
+					const LogGroups::Group& group = groups[i];
+					ImGui::PushID(i);
+					ImGui::TableNextRow();
+
+					LogMessage levelOf(group.level, "");
+					ImGui::PushStyleColor(ImGuiCol_Text, ToImVec4(levelOf.LevelColor()));
+
+					ImGui::TableSetColumnIndex(0);
+					char count[32];
+					std::snprintf(count, sizeof(count), "%llu", static_cast<unsigned long long>(group.count));
+					if (ImGui::Selectable(count, false, ImGuiSelectableFlags_SpanAllColumns))
+						clickedSequence = group.lastSequence;
+					ImGui::SetItemTooltip("Click to jump to the last message of this site");
+
+					ImGui::TableSetColumnIndex(1);
+					float rates[LogGroups::SPARK_SECONDS];
+					for (size_t second = 0; second < LogGroups::SPARK_SECONDS; ++second)
+						rates[second] = static_cast<float>(group.perSecond[second]);
+					ImGui::PlotHistogram("##Rate", rates, static_cast<int>(LogGroups::SPARK_SECONDS), 0, nullptr, 0.0f, FLT_MAX,
+						ImVec2(-FLT_MIN, ImGui::GetTextLineHeight()));
+
+					char time[80];
+					ImGui::TableSetColumnIndex(2);
+					formatTime(group.firstNs, time, sizeof(time));
+					ImGui::TextUnformatted(time);
+
+					ImGui::TableSetColumnIndex(3);
+					formatTime(group.lastNs, time, sizeof(time));
+					ImGui::TextUnformatted(time);
+
+					ImGui::TableSetColumnIndex(4);
+					const std::string_view site = LogSymbols::GetText(group.siteId);
+					ImGui::TextUnformatted(site.data(), site.data() + site.size());
+
+					ImGui::PopStyleColor();
+					ImGui::PopID();
+				}
+			}
+			ImGui::EndTable();
+		}
+		return clickedSequence;
+	}
+
+	// Threads that logged so far (LogThreads) with their message count and rate over the last second. Returns the
+	// index of a clicked thread (to filter by it), LogThreads::NONE otherwise.
+	uint16_t ShowThreadsTable(float height)
+	{
+		static std::vector<uint64_t> lastCounts;
+		static std::vector<double> rates;
+		static double lastRefresh = -1.0;
+
+		const size_t count = LogThreads::GetCount();
+		lastCounts.resize(count + 1, 0);
+		rates.resize(count + 1, 0.0);
+		const double now = ImGui::GetTime();
+		if (lastRefresh < 0.0 || now - lastRefresh >= 1.0)
+		{
+			for (uint16_t index = 1; index <= count; ++index)
+			{
+				const uint64_t messages = LogThreads::GetMessageCount(index);
+				rates[index] = lastRefresh < 0.0 ? 0.0 : (messages - lastCounts[index]) / (now - lastRefresh);
+				lastCounts[index] = messages;
+			}
+			lastRefresh = now;
+		}
+
+		uint16_t clicked = LogThreads::NONE;
+		constexpr ImGuiTableFlags flags = ImGuiTableFlags_ScrollY | ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_RowBg;
+		if (ImGui::BeginTable("ThreadTable", 4, flags, ImVec2(0, height)))
+		{
+			ImGui::TableSetupScrollFreeze(0, 1);
+			ImGui::TableSetupColumn("Thread", ImGuiTableColumnFlags_WidthStretch);
+			ImGui::TableSetupColumn("Index", ImGuiTableColumnFlags_WidthFixed, ImGui::CalcTextSize("00000").x);
+			ImGui::TableSetupColumn("Messages", ImGuiTableColumnFlags_WidthFixed, ImGui::CalcTextSize("0000000000").x);
+			ImGui::TableSetupColumn("Per second", ImGuiTableColumnFlags_WidthFixed, ImGui::CalcTextSize("00000000.0").x);
+			ImGui::TableHeadersRow();
+
+			ImGuiListClipper clipper;
+			clipper.Begin(static_cast<int>(count));
+			while (clipper.Step())
+			{
+				for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row)
+				{
+					const uint16_t index = static_cast<uint16_t>(row + 1);
+					ImGui::PushID(row);
+					ImGui::TableNextRow();
+
+					ImGui::TableSetColumnIndex(0);
+					ImGui::PushStyleColor(ImGuiCol_Text, ToImVec4(LogThreads::GetColor(index)));
+					if (ImGui::Selectable(LogThreads::GetName(index).c_str(), false, ImGuiSelectableFlags_SpanAllColumns))
+						clicked = index;
+					ImGui::PopStyleColor();
+					ImGui::SetItemTooltip("Click to show only this thread's messages in the filter table");
+
+					ImGui::TableSetColumnIndex(1);
+					ImGui::Text("%u", static_cast<unsigned>(index));
+					ImGui::TableSetColumnIndex(2);
+					ImGui::Text("%llu", static_cast<unsigned long long>(lastCounts[index]));
+					ImGui::TableSetColumnIndex(3);
+					ImGui::Text("%.1f", rates[index]);
+					ImGui::PopID();
+				}
+			}
+			ImGui::EndTable();
+		}
+		return clicked;
+	}
+
+	// Replaces the 'key' term (e.g. "obj=") of the query text (if any) with one for 'value' (empty = remove it)
+	void SetQueryTerm(char* query, size_t querySize, std::string_view key, std::string_view value)
+	{
+		const std::string quotedKey = std::string(key) + "\"";
+		std::string result;
+		std::string_view rest = query;
+		while (!rest.empty())
+		{
+			const size_t start = rest.find_first_not_of(' ');
+			if (start == std::string_view::npos)
+				break;
+			rest.remove_prefix(start);
+
+			// Quoted values may contain spaces: obj="Left Motor"
+			size_t end = rest.find(' ');
+			if (rest.substr(0, quotedKey.size()) == quotedKey)
+			{
+				const size_t closing = rest.find('"', quotedKey.size());
+				end = closing == std::string_view::npos ? std::string_view::npos : closing + 1;
+			}
+			const std::string_view token = rest.substr(0, end);
+			rest.remove_prefix(token.size());
+
+			if (token.substr(0, key.size()) != key)
+			{
+				result += result.empty() ? "" : " ";
+				result += token;
+			}
+		}
+
+		if (!value.empty())
+		{
+			result += result.empty() ? "" : " ";
+			result += key;
+			if (value.find(' ') != std::string_view::npos)
+				result += "\"" + std::string(value) + "\"";
+			else
+				result += value;
+		}
+		std::snprintf(query, querySize, "%s", result.c_str());
+	}
+
+	// What a row needs besides the message text: formatted time, packed level color, the prefix of LOG_* calls
+	// rendered into the text and the laid-out size of the message. Built the first time an entry is drawn
+	// instead of every frame.
+	struct RowDisplay
+	{
+		uint64_t sequence = UINT64_MAX; // Entry the data belongs to
+		float fontSize = 0.0f;          // Font the sizes were measured with
+		ImU32 color = 0;
+		ImVec2 levelSize;
+		ImVec2 timeSize;
+		ImVec2 textSize;                // Whole message, all lines
+		ImVec2 locationSize;
+		int lineCount = 0;
+		char time[80] = "";
+		char location[64] = "";         // "File.cpp:123" of LOG_* calls
+		std::string text;               // Prefix and message of LOG_* calls, empty for other messages
+
+		std::string_view Text(const LogMessage& msg) const { return msg.location ? std::string_view(text) : std::string_view(msg.message); }
+	};
+
+	// Display data of ring entries, direct-mapped by sequence. Visible rows have consecutive sequences, so they
+	// never evict each other; an entry is rebuilt when its slot was taken by another sequence (the ring entry
+	// was overwritten) or the font changed. History rows have no sequence and are built on every draw.
+	class RowDisplayCache
+	{
+	public:
+		static constexpr size_t SIZE = 4096;
+
+		const RowDisplay& Get(const LogMessage& msg, bool ringEntry)
+		{
+			const float fontSize = ImGui::GetFontSize();
+			RowDisplay& display = ringEntry ? entries[msg.sequence % SIZE] : scratch;
+			if (!ringEntry || display.sequence != msg.sequence || display.fontSize != fontSize)
+				Build(msg, fontSize, display);
+			return display;
+		}
+
+	private:
+		static void Build(const LogMessage& msg, float fontSize, RowDisplay& display)
+		{
+			display.sequence = msg.sequence;
+			display.fontSize = fontSize;
+			display.color = ImGui::ColorConvertFloat4ToU32(ToImVec4(msg.LevelColor()));
+			display.levelSize = ImGui::CalcTextSize(msg.FormatLevel());
+			msg.FormatTimestamp(display.time, sizeof(display.time));
+			display.timeSize = ImGui::CalcTextSize(display.time);
+
+			display.location[0] = '\0';
+			display.text.clear();
+			if (msg.location)
+			{
+				const std::string_view file = msg.location->GetFileName();
+				std::snprintf(display.location, sizeof(display.location), "%.*s:%u", static_cast<int>(file.size()), file.data(),
+					static_cast<unsigned>(msg.location->source.line()));
+				fmt::memory_buffer scratch;
+				display.text.assign(msg.GetText(scratch));
+			}
+			display.locationSize = ImGui::CalcTextSize(display.location);
+
+			const std::string_view text = display.Text(msg);
+			display.textSize = ImGui::CalcTextSize(text.data(), text.data() + text.size());
+			display.lineCount = 1 + static_cast<int>(std::count(text.begin(), text.end(), '\n'));
+		}
+
+		std::vector<RowDisplay> entries = std::vector<RowDisplay>(SIZE);
+		RowDisplay scratch;
+	};
+
+	RowDisplayCache rowDisplayCache;
+
+	// Text with a known size drawn straight into the window: no style push and no CalcTextSize() per frame.
+	// The Dummy() is the item, so IsItemClicked() and tooltips work as for ImGui::TextUnformatted().
+	void DrawCachedText(ImU32 color, const char* begin, const char* end, const ImVec2& size)
+	{
+		ImGui::GetWindowDrawList()->AddText(ImGui::GetCursorScreenPos(), color, begin, end);
+		ImGui::Dummy(size);
+	}
+
+	// Width of the message column in the last wrapped row, the wrap width of the next frame
+	float messageColumnWidth = 0.0f;
+
+	// "Location" option of the window: file:line column of LOG_* calls in both tables
+	bool locationColumn = false;
+	// "Threads" option: column with the name of the logging thread (LogThreads)
+	bool threadColumn = false;
+
+	// Quotes 'value' as one word for the platform shell (sh: '...', cmd: "..."). False if cmd can't quote it:
+	// '"' is not allowed in Windows paths and '%' expands even inside quotes.
+	bool QuoteShellArgument(std::string_view value, std::string& quoted)
+	{
+#ifdef _WIN32
+		if (value.find_first_of("\"%") != std::string_view::npos)
+			return false;
+		quoted = "\"" + std::string(value) + "\"";
+#else
+		quoted = "'";
+		for (char c : value)
+		{
+			if (c == '\'')
+				quoted += "'\\''"; // Close, escaped quote, reopen
+			else
+				quoted += c;
+		}
+		quoted += "'";
+#endif
+		return true;
+	}
+
+	// Jumps to a log call: runs the editor command in GEAR_SOURCE_EDITOR (e.g. "code -g {file}:{line}", {file}
+	// is inserted quoted) or, without one, copies "path:line" to the clipboard
+	void OpenSourceLocation(const LogLocation& location)
+	{
+		const std::string file = location.source.file_name();
+		const std::string line = std::to_string(location.source.line());
+		const char* editor = std::getenv("GEAR_SOURCE_EDITOR");
+		std::string quotedFile;
+		if (!editor || editor[0] == '\0' || !QuoteShellArgument(file, quotedFile))
+		{
+			ImGui::SetClipboardText((file + ":" + line).c_str());
+			return;
+		}
+
+		std::string command = editor;
+		auto replace = [&command](std::string_view key, const std::string& value)
+			{
+				for (size_t pos = command.find(key); pos != std::string::npos; pos = command.find(key, pos + value.size()))
+					command.replace(pos, key.size(), value);
+			};
+		replace("{file}", quotedFile);
+		replace("{line}", line); // Digits only
+#ifdef _WIN32
+		command = "start \"\" " + command;
+#else
+		command += " &";
+#endif
+		std::system(command.c_str());
+	}
+
+	// Draws one table row (level, time, [source,] message). 'ringEntry' = 'msg' is (a copy of) a ring entry,
+	// whose display data is cached by sequence. With a 'wrapWidth' the message is word-wrapped into a row of
+	// 'rowHeight'. Returns true if the message cell was clicked.
+	bool DrawLogRow(const LogMessage& msg, bool sourceColumn, bool ringEntry = true, float rowHeight = 0.0f, float wrapWidth = 0.0f)
+	{
+		const RowDisplay& display = rowDisplayCache.Get(msg, ringEntry);
+
+		ImGui::TableNextRow(ImGuiTableRowFlags_None, rowHeight);
+
+		ImGui::TableSetColumnIndex(0);
+		DrawCachedText(display.color, msg.FormatLevel(), nullptr, display.levelSize);
+
+		ImGui::TableSetColumnIndex(1);
+		DrawCachedText(display.color, display.time, nullptr, display.timeSize);
+
+		int column = 2;
+		if (locationColumn)
+		{
+			ImGui::TableSetColumnIndex(column++);
+			if (msg.location)
+			{
+				DrawCachedText(ImGui::GetColorU32(ImGuiCol_TextDisabled), display.location, nullptr, display.locationSize);
+				ImGui::SetItemTooltip("%s:%u\n%s\nClick to open (GEAR_SOURCE_EDITOR) or copy the path", msg.location->source.file_name(),
+					static_cast<unsigned>(msg.location->source.line()), msg.location->source.function_name());
+				if (ImGui::IsItemClicked())
+					OpenSourceLocation(*msg.location);
+			}
+		}
+		if (threadColumn)
+		{
+			ImGui::TableSetColumnIndex(column++);
+			if (msg.threadIndex != LogThreads::NONE)
+				ImGui::TextColored(ToImVec4(LogThreads::GetColor(msg.threadIndex)), "%s", LogThreads::GetName(msg.threadIndex).c_str());
+		}
+		if (sourceColumn)
+		{
+			// Origin of the message, e.g. "worker:4711" for shared-memory producers
+			ImGui::TableSetColumnIndex(column++);
+			ImGui::TextColored(ToImVec4(LogSources::GetColor(msg.sourceId)), "%s", LogSources::GetName(msg.sourceId).c_str());
+		}
+		ImGui::TableSetColumnIndex(column);
+		if (rowHeight > 0.0f) // Wrapped rows of the main table
+			messageColumnWidth = ImGui::GetContentRegionAvail().x;
+		if (!sourceColumn && msg.sourceId != LogSources::GEAR_SOURCE)
+		{
+			// Messages of other sources (tailed files) are tagged with the source name in its color
+			ImGui::TextColored(ToImVec4(LogSources::GetColor(msg.sourceId)), "[%s]", LogSources::GetName(msg.sourceId).c_str());
+			ImGui::SameLine();
+		}
+		const std::string_view text = display.Text(msg);
+		if (wrapWidth > 0.0f)
+		{
+			ImGui::GetWindowDrawList()->AddText(ImGui::GetFont(), ImGui::GetFontSize(), ImGui::GetCursorScreenPos(), display.color,
+				text.data(), text.data() + text.size(), wrapWidth);
+			ImGui::Dummy(ImVec2(wrapWidth, rowHeight - ImGui::GetStyle().CellPadding.y * 2.0f));
+		}
+		else
+			DrawCachedText(display.color, text.data(), text.data() + text.size(), display.textSize);
+		bool clicked = ImGui::IsItemClicked();
+		if (msg.fullLength != 0)
+		{
+			// Cut at Logger::SetMaxMessageLength(), the full text may be in the attachments file
+			ImGui::SetItemTooltip("Truncated from %u bytes%s", msg.fullLength, msg.attachmentOffset >= 0 ? ", right-click to copy the full text" : "");
+			std::string full;
+			if (msg.attachmentOffset >= 0 && ImGui::IsItemClicked(ImGuiMouseButton_Right) && Logger::ReadAttachment(msg, full))
+				ImGui::SetClipboardText(full.c_str());
+		}
+
+		return clicked;
+	}
+
+	// Pixel heights of the ring entries as word-wrapped rows, in ring slot order (FenwickTree). The table shows
+	// the entries from the read index on, so the height above a row is a circular range sum; that and the row
+	// at a scroll position take O(log n), so only the visible rows are touched even with 1M entries.
+	//
+	// New entries are measured when they are pushed (tracked by sequence), replacing the height of the entry
+	// they overwrote. A new wrap width, or a frame without Update() (wrap mode was off), marks all heights stale:
+	// visible rows are re-measured when drawn, the others for up to SWEEP_BUDGET per frame, keeping their previous
+	// height until then. A new font or ring capacity starts over with single-line heights.
+	class WrappedRowIndex
+	{
+	public:
+		static constexpr auto SWEEP_BUDGET = std::chrono::microseconds(2000);
+		static constexpr size_t SWEEP_CLOCK_INTERVAL = 64; // Measurements between clock reads
+
+		// Call once per frame before drawing, with the ring state the rows are drawn from
+		void Update(const std::vector<LogMessage>& buffer, size_t ringReadIndex, size_t ringSize, uint64_t endSequence, float newWrapWidth)
+		{
+			readIndex = ringReadIndex;
+			size = ringSize;
+			const float fontSize = ImGui::GetFontSize();
+			const int frame = ImGui::GetFrameCount();
+			const bool missedFrames = lastUpdateFrame != frame - 1;
+			lastUpdateFrame = frame;
+			if (buffer.size() != heights.Size() || fontSize != measuredFontSize)
+			{
+				measuredFontSize = fontSize;
+				heights.Reset(buffer.size(), SingleLineHeight());
+				generations.assign(buffer.size(), 0);
+				generation = 1;
+				nextSequence = endSequence; // Entries already in the ring are left to the sweep
+				wrapWidth = newWrapWidth;
+				sweepSlot = 0;
+			}
+			else if (newWrapWidth != wrapWidth || missedFrames)
+			{
+				// Entries pushed while not updated are left to the sweep as well
+				wrapWidth = newWrapWidth;
+				nextSequence = std::max(nextSequence, endSequence);
+				if (++generation == 0)
+				{
+					std::fill(generations.begin(), generations.end(), uint16_t(0));
+					generation = 1;
+				}
+				sweepSlot = 0;
+			}
+
+			// Entries pushed since the last frame
+			const uint64_t oldestSequence = endSequence - size;
+			for (uint64_t sequence = std::max(nextSequence, oldestSequence); sequence < endSequence; ++sequence)
+				Measure(buffer, (readIndex + (sequence - oldestSequence)) % buffer.size());
+			nextSequence = endSequence;
+
+			// Stale heights after a width change, within the frame's time budget
+			const auto sweepEnd = std::chrono::steady_clock::now() + SWEEP_BUDGET;
+			for (size_t measured = 0; sweepSlot < buffer.size(); ++sweepSlot)
+			{
+				if (generations[sweepSlot] != generation && (sweepSlot + buffer.size() - readIndex) % buffer.size() < size)
+				{
+					Measure(buffer, sweepSlot);
+					if (++measured % SWEEP_CLOCK_INTERVAL == 0 && std::chrono::steady_clock::now() >= sweepEnd)
+					{
+						++sweepSlot;
+						break;
+					}
+				}
+			}
+		}
+
+		// Height of ring row 'row' (0 = oldest entry), measured now if stale
+		float Refresh(const std::vector<LogMessage>& buffer, size_t row)
+		{
+			const size_t slot = (readIndex + row) % buffer.size();
+			if (generations[slot] != generation)
+				Measure(buffer, slot);
+			return static_cast<float>(heights.Get(slot));
+		}
+
+		// Height of the rows above ring row 'row'
+		float HeightBefore(size_t row) const
+		{
+			const int64_t base = heights.PrefixSum(readIndex);
+			if (readIndex + row <= heights.Size())
+				return static_cast<float>(heights.PrefixSum(readIndex + row) - base);
+			return static_cast<float>(heights.Total() - base + heights.PrefixSum(readIndex + row - heights.Size()));
+		}
+
+		// Ring row at 'y' (relative to the first ring row), clamped to the last row
+		size_t RowAt(float y) const
+		{
+			if (size == 0)
+				return 0;
+
+			const int64_t target = static_cast<int64_t>(std::max(0.0f, y));
+			const size_t firstPartRows = std::min(size, heights.Size() - readIndex); // Rows up to the end of the storage
+			const int64_t base = heights.PrefixSum(readIndex);
+			const int64_t firstPartHeight = heights.PrefixSum(readIndex + firstPartRows) - base;
+
+			size_t row;
+			if (target < firstPartHeight)
+				row = heights.UpperBound(base + target) - readIndex;
+			else
+				row = firstPartRows + heights.UpperBound(target - firstPartHeight);
+			return std::min(row, size - 1);
+		}
+
+		float GetWrapWidth() const { return wrapWidth; }
+
+	private:
+		// Table rows are their content plus the cell padding above and below
+		static int64_t RowHeight(float textHeight)
+		{
+			return static_cast<int64_t>(std::lround(textHeight + ImGui::GetStyle().CellPadding.y * 2.0f));
+		}
+
+		static int64_t SingleLineHeight() { return RowHeight(ImGui::GetTextLineHeight()); }
+
+		void Measure(const std::vector<LogMessage>& buffer, size_t slot)
+		{
+			const std::string_view text = buffer[slot].GetText(scratch);
+			heights.Set(slot, RowHeight(ImGui::CalcTextSize(text.data(), text.data() + text.size(), false, wrapWidth).y));
+			generations[slot] = generation;
+		}
+
+		gear::FenwickTree<int64_t> heights;
+		fmt::memory_buffer scratch;        // Texts with their rendered prefix
+		std::vector<uint16_t> generations; // Wrap width generation each height was measured with
+		uint16_t generation = 1;
+		float wrapWidth = 0.0f;
+		float measuredFontSize = 0.0f;
+		uint64_t nextSequence = 0;         // First entry not measured yet
+		size_t sweepSlot = 0;
+		size_t readIndex = 0;
+		size_t size = 0;
+		int lastUpdateFrame = -1;
+	};
+
+	// Rows of the main table in wrap mode: history rows (single line) above the ring rows with their heights
+	// from 'rowIndex'. Top of 'row':
+	float WrappedRowTop(const WrappedRowIndex& rowIndex, size_t historyCount, size_t row)
+	{
+		const float lineRowHeight = ImGui::GetTextLineHeightWithSpacing();
+		return row <= historyCount ? row * lineRowHeight : historyCount * lineRowHeight + rowIndex.HeightBefore(row - historyCount);
+	}
+
+	// Only the visible rows are drawn, the rows above and below them are one spacer row each.
+	// Returns the end of the drawn rows, 'firstRow' is set to the first one.
+	size_t DrawWrappedRows(WrappedRowIndex& rowIndex, const LogHistory::Snapshot* history, size_t historyCount, LogMessage& historyRow,
+		const std::vector<LogMessage>& buffer, size_t readIndex, size_t logCount, bool sourceColumn, size_t& firstRow)
+	{
+		const float lineRowHeight = ImGui::GetTextLineHeightWithSpacing();
+		const float historyHeight = historyCount * lineRowHeight;
+		const size_t rowCount = historyCount + logCount;
+		auto rowTop = [&](size_t row) { return WrappedRowTop(rowIndex, historyCount, row); };
+
+		const float top = ImGui::GetScrollY();
+		const float bottom = top + ImGui::GetWindowHeight();
+		size_t row = top < historyHeight ? static_cast<size_t>(top / lineRowHeight) : historyCount + rowIndex.RowAt(top - historyHeight);
+		row = std::min(row, rowCount);
+		firstRow = row;
+
+		const float skipped = rowTop(row);
+		if (skipped > 0.0f)
+			ImGui::TableNextRow(ImGuiTableRowFlags_None, skipped);
+
+		// Spacer rows shift the automatic striping, so every row sets its own background by row number
+		const ImU32 rowColors[2] = { ImGui::GetColorU32(ImGuiCol_TableRowBg), ImGui::GetColorU32(ImGuiCol_TableRowBgAlt) };
+		float y = skipped;
+		for (; row < rowCount && y < bottom; ++row)
+		{
+			if (row < historyCount)
+			{
+				history->GetRow(row, historyRow);
+				DrawLogRow(historyRow, sourceColumn, false);
+				y += lineRowHeight;
+			}
+			else
+			{
+				const float height = rowIndex.Refresh(buffer, row - historyCount);
+				DrawLogRow(buffer[(readIndex + (row - historyCount)) % buffer.size()], sourceColumn, true, height, rowIndex.GetWrapWidth());
+				y += height;
+			}
+			ImGui::TableSetBgColor(ImGuiTableBgTarget_RowBg0, rowColors[row & 1]);
+		}
+
+		const float remaining = rowTop(rowCount) - y;
+		if (row < rowCount && remaining > 0.0f)
+			ImGui::TableNextRow(ImGuiTableRowFlags_None, remaining);
+		return row;
+	}
+}
+
+namespace gear
+{
+	void GuiLayer::ShowLoggerWindow()
+	{
+		ImGui::Begin("Logger");
+
+		static bool autoScroll = true;
+		ImGui::Checkbox("Auto Scroll", &autoScroll);
+
+		static bool showFilter = false;
+		ImGui::SameLine();
+		ImGui::Checkbox("Enable Filter", &showFilter);
+
+		static bool showHistory = false;
+		ImGui::SameLine();
+		ImGui::Checkbox("History", &showHistory);
+		ImGui::SetItemTooltip("Show older entries from the log files above the live entries");
+
+		static bool showSources = false;
+		static std::vector<std::unique_ptr<LogFileTail>> tails;
+		ImGui::SameLine();
+		ImGui::Checkbox("Sources", &showSources);
+		ImGui::SetItemTooltip("Follow external log files in this window");
+		if (showSources)
+			ShowTailSources(tails);
+
+		static bool wrapRows = false;
+		ImGui::SameLine();
+		ImGui::Checkbox("Wrap", &wrapRows);
+		ImGui::SetItemTooltip("Word-wrap messages in the log table (multi-line rows)");
+
+		static bool showGroups = false;
+		ImGui::SameLine();
+		ImGui::Checkbox("Groups", &showGroups);
+		ImGui::SetItemTooltip("Messages grouped by log site (function and format string)");
+
+		ImGui::SameLine();
+		ImGui::Checkbox("Location", &locationColumn);
+		ImGui::SetItemTooltip("Source file and line of each log call; click one to open it");
+
+		ImGui::SameLine();
+		ImGui::Checkbox("Threads", &threadColumn);
+		ImGui::SetItemTooltip("Thread column and per-thread message rates (names: Logger::SetThreadName())");
+
+		static bool showRates = true;
+		ImGui::SameLine();
+		ImGui::Checkbox("Rates", &showRates);
+		ImGui::SetItemTooltip("Messages per second and level for the last hour");
+
+		ImGui::SameLine();
+		ShowCapacitySelector();
+
+		static LogExporter exporter{ Logger::GetStore() };
+		ImGui::SameLine();
+		if (ImGui::Button("Export..."))
+			ImGui::OpenPopup("Export");
+		if (exporter.IsBusy())
+		{
+			RedrawScheduler::RequestRedraw(); // Keep the progress moving while the loop would idle
+			ImGui::SameLine();
+			ImGui::ProgressBar(exporter.GetProgress(), ImVec2(120.0f, 0.0f));
+			ImGui::SameLine();
+			if (ImGui::SmallButton("Cancel"))
+				exporter.Cancel();
+		}
+		else
+		{
+			const LogExporter::Result exportResult = exporter.GetResult();
+			if (!exportResult.error.empty())
+			{
+				ImGui::SameLine();
+				ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), "%s", exportResult.error.c_str());
+			}
+			else if (!exportResult.path.empty())
+			{
+				ImGui::SameLine();
+				ImGui::TextDisabled("%llu rows exported", static_cast<unsigned long long>(exportResult.rowsWritten));
+				if (exportResult.rowsSkipped > 0)
+					ImGui::SetItemTooltip("%s\n%llu entries were overwritten before they could be written", exportResult.path.string().c_str(),
+						static_cast<unsigned long long>(exportResult.rowsSkipped));
+				else
+					ImGui::SetItemTooltip("%s", exportResult.path.string().c_str());
+			}
+		}
+
+		// Jump targets: a ring entry (by sequence) or, for seconds already overwritten in the ring, a history row
+		static uint64_t scrollToSequence = UINT64_MAX;
+		static int64_t scrollToSecond = INT64_MIN;
+		if (showRates)
+		{
+			LogRateSeries::Bucket clicked;
+			if (ShowRateStrip(clicked))
+			{
+				scrollToSequence = clicked.firstSequence;
+				scrollToSecond = clicked.second;
+				autoScroll = false;
+			}
+		}
+
+		// Thread to filter by, applied to the filter query below
+		static uint16_t filterThread = LogThreads::NONE;
+		if (threadColumn)
+		{
+			const uint16_t clickedThread = ShowThreadsTable(std::min(ImGui::GetContentRegionAvail().y * 0.2f,
+				ImGui::GetTextLineHeightWithSpacing() * (LogThreads::GetCount() + 1.5f)));
+			if (clickedThread != LogThreads::NONE)
+			{
+				filterThread = clickedThread;
+				showFilter = true;
+			}
+		}
+
+		if (showGroups)
+		{
+			const uint64_t clickedSequence = ShowGroupsTable(ImGui::GetContentRegionAvail().y * 0.35f, ImGui::CalcTextSize("[2099:05:23 15:37:51.051]").x);
+			if (clickedSequence != UINT64_MAX)
+			{
+				scrollToSequence = clickedSequence;
+				autoScroll = false;
+			}
+		}
+
+		const auto& buffer = Logger::GetBuffer();
+		const size_t readIndex = Logger::GetReadIndex();
+		const size_t logCount = Logger::GetSize();
+		const size_t capacity = buffer.size();
+		const uint64_t oldestSequence = Logger::GetTotalPushed() - logCount;
+
+		// Disk history: mapped log files, indexed in the background and re-scanned once per second while shown.
+		// Only lines older than the oldest ring entry are drawn from the files, everything newer comes from the ring.
+		// The files only store milliseconds, so lines from the same millisecond as the oldest ring entry are skipped.
+		static LogHistory history{ Logger::LOG_FOLDER, Logger::LOG_FILE_NAME, Logger::LOG_MAX_BACKUPS };
+		static double lastHistoryRefresh = -1.0;
+		static LogMessage historyRow;
+		std::shared_ptr<const LogHistory::Snapshot> historySnapshot;
+		size_t historyCount = 0;
+		if (showHistory)
+		{
+			if (lastHistoryRefresh < 0.0 || ImGui::GetTime() - lastHistoryRefresh > 1.0)
+			{
+				history.Refresh();
+				lastHistoryRefresh = ImGui::GetTime();
+			}
+
+			historySnapshot = history.GetSnapshot();
+			historyCount = historySnapshot->GetLineCount();
+			if (logCount > 0)
+				historyCount = historySnapshot->LowerBound(std::chrono::floor<std::chrono::milliseconds>(buffer[readIndex].timestamp));
+
+			// ImGuiListClipper counts rows as int
+			historyCount = std::min(historyCount, static_cast<size_t>(INT_MAX) - logCount);
+
+			ImGui::SameLine();
+			if (history.IsIndexing())
+			{
+				RedrawScheduler::RequestRedraw();
+				ImGui::TextDisabled("Indexing log files...");
+			}
+			else
+			{
+				ImGui::TextDisabled("%zu older lines in %zu files (%.1f MB)", historyCount, historySnapshot->GetSegmentCount(),
+					historySnapshot->GetByteCount() / (1024.0 * 1024.0));
+
+				// Per-level totals come from the sidecar indexes, no need to parse the files
+				const auto levelCounts = historySnapshot->GetLevelCounts();
+				ImGui::SetItemTooltip("In log files: %llu info, %llu warnings, %llu errors, %llu debug",
+					static_cast<unsigned long long>(levelCounts[static_cast<size_t>(LogLevel::Info)]),
+					static_cast<unsigned long long>(levelCounts[static_cast<size_t>(LogLevel::Warning)]),
+					static_cast<unsigned long long>(levelCounts[static_cast<size_t>(LogLevel::Error)]),
+					static_cast<unsigned long long>(levelCounts[static_cast<size_t>(LogLevel::Debug)]));
+			}
+
+			std::string historyError = history.GetError();
+			if (!historyError.empty())
+			{
+				ImGui::SameLine();
+				ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), "%s", historyError.c_str());
+			}
+		}
+		else
+			lastHistoryRefresh = -1.0;
+
+		constexpr ImGuiTableFlags tableFlags = ImGuiTableFlags_ScrollY | ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_RowBg;
+		const float availHeight = ImGui::GetContentRegionAvail().y;
+		static float levelWidth = ImGui::CalcTextSize("ERROR").x;
+		static float timeWidth = ImGui::CalcTextSize("[2099:05:23 15:37:51.051]").x;
+		static float sourceWidth = ImGui::CalcTextSize("worker-name:123456").x;
+
+		// The source column appears once anything besides GEAR itself logs into this window
+		const bool sourceColumn = LogSources::GetCount() > 1;
+		const int columnCount = 3 + (sourceColumn ? 1 : 0) + (locationColumn ? 1 : 0) + (threadColumn ? 1 : 0);
+		static float locationWidth = ImGui::CalcTextSize("GuiLoggerWindow.cpp:1234").x;
+		static float threadWidth = ImGui::CalcTextSize("Benchmark worker").x;
+		float topHeight = showFilter ? (availHeight * 0.66f - ImGui::GetFrameHeightWithSpacing()) : availHeight;
+
+		static ExportRows exportRows;
+		exportRows.history = historySnapshot;
+		exportRows.historyCount = historyCount;
+		exportRows.oldestSequence = oldestSequence;
+		exportRows.logCount = logCount;
+
+		// Main log table (top)
+		if (ImGui::BeginChild("##LogMain", ImVec2(0, topHeight), ImGuiChildFlags_Borders))
+		{
+			if (ImGui::BeginTable("LogTable", columnCount, tableFlags))
+			{
+				ImGui::TableSetupScrollFreeze(0, 1);
+				ImGui::TableSetupColumn("Level", ImGuiTableColumnFlags_WidthFixed, levelWidth);
+				ImGui::TableSetupColumn("Time", ImGuiTableColumnFlags_WidthFixed, timeWidth);
+				if (locationColumn)
+					ImGui::TableSetupColumn("Location", ImGuiTableColumnFlags_WidthFixed, locationWidth);
+				if (threadColumn)
+					ImGui::TableSetupColumn("Thread", ImGuiTableColumnFlags_WidthFixed, threadWidth);
+				if (sourceColumn)
+					ImGui::TableSetupColumn("Source", ImGuiTableColumnFlags_WidthFixed, sourceWidth);
+				ImGui::TableSetupColumn("Message", ImGuiTableColumnFlags_WidthStretch);
+				ImGui::TableHeadersRow();
+
+				// Entries that were overwritten in the meantime can only be scrolled to in the history rows
+				int targetRow = -1;
+				if (scrollToSequence != UINT64_MAX && scrollToSequence >= oldestSequence)
+					targetRow = static_cast<int>(historyCount + (scrollToSequence - oldestSequence));
+				else if (scrollToSecond != INT64_MIN && historySnapshot)
+					targetRow = static_cast<int>(std::min(historyCount, historySnapshot->LowerBound(
+						std::chrono::system_clock::time_point(std::chrono::seconds(scrollToSecond)))));
+
+				static WrappedRowIndex wrappedRows;
+				if (wrapRows)
+					wrappedRows.Update(buffer, readIndex, logCount, oldestSequence + logCount, messageColumnWidth);
+
+				if (targetRow >= 0)
+				{
+					int relativeRow = targetRow;
+					float rowHeight = ImGui::GetTextLineHeightWithSpacing();
+					float targetY = wrapRows ? WrappedRowTop(wrappedRows, historyCount, relativeRow) : relativeRow * rowHeight;
+					float scrollY = std::max(0.0f, targetY - ImGui::GetWindowHeight() * 0.5f + rowHeight); // + rowHeight because of header!
+					ImGui::SetScrollY(scrollY);
+				}
+				scrollToSequence = UINT64_MAX;
+				scrollToSecond = INT64_MIN;
+
+				if (wrapRows)
+					exportRows.endVisibleRow = DrawWrappedRows(wrappedRows, historySnapshot.get(), historyCount, historyRow, buffer, readIndex, logCount,
+						sourceColumn, exportRows.firstVisibleRow);
+				else
+				{
+					ImGuiListClipper clipper;
+					clipper.Begin(static_cast<int>(historyCount + logCount));
+
+					// The clipper may first step through a single row to measure it, the visible range is the largest step
+					exportRows.firstVisibleRow = exportRows.endVisibleRow = 0;
+					while (clipper.Step())
+					{
+						if (clipper.DisplayEnd - clipper.DisplayStart > static_cast<int>(exportRows.endVisibleRow - exportRows.firstVisibleRow))
+						{
+							exportRows.firstVisibleRow = static_cast<size_t>(clipper.DisplayStart);
+							exportRows.endVisibleRow = static_cast<size_t>(clipper.DisplayEnd);
+						}
+						for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i)
+						{
+							// History rows first (parsed from the mapped files on demand), then the ring
+							if (static_cast<size_t>(i) < historyCount)
+							{
+								historySnapshot->GetRow(static_cast<size_t>(i), historyRow);
+								DrawLogRow(historyRow, sourceColumn, false);
+								continue;
+							}
+
+							// Calculate actual index in the ring buffer
+							size_t bufferIndex = (readIndex + (i - historyCount)) % capacity;
+							DrawLogRow(buffer[bufferIndex], sourceColumn);
+						}
+					}
+				}
+				if (autoScroll && Logger::ShouldScrollToBottom())
+					ImGui::SetScrollHereY(1.0f);
+				ImGui::EndTable();
+			}
+		}
+		ImGui::EndChild();
+
+		// Filtered log table (bottom). The query runs on a background worker over a snapshot of the
+		// log store and keeps following new entries; matches are streamed into 'searchResults'.
+		static LogSearchWorker searchWorker{ Logger::GetStore() };
+		static std::vector<LogMessage> searchResults;
+		static char queryText[256] = "";
+		static bool searchActive = false;
+
+		const bool wantSearch = showFilter && queryText[0] != '\0';
+		if (wantSearch != searchActive)
+		{
+			searchResults.clear();
+			if (wantSearch)
+				searchWorker.Submit(queryText);
+			else
+				searchWorker.Cancel();
+			searchActive = wantSearch;
+		}
+
+		if (showFilter)
+		{
+			// Restart on every edit: the worker cancels the running scan, so typing stays responsive
+			auto restartSearch = [&]()
+				{
+					searchResults.clear();
+					searchActive = queryText[0] != '\0';
+					if (searchActive)
+						searchWorker.Submit(queryText);
+					else
+						searchWorker.Cancel();
+				};
+
+			ImGui::SetNextItemWidth(400.0f);
+			if (ImGui::InputTextWithHint("Filter", "text -exclude level:error,warn obj:Motor name:Left last:10m re:/regex/", queryText, IM_ARRAYSIZE(queryText)))
+				restartSearch();
+
+			// Objects of LOG1..LOG3 calls, matched by their interned id (obj=)
+			ImGui::SameLine();
+			ImGui::SetNextItemWidth(160.0f);
+			if (ImGui::BeginCombo("##Object", "Object", ImGuiComboFlags_HeightLarge))
+			{
+				if (ImGui::Selectable("(any)"))
+				{
+					SetQueryTerm(queryText, IM_ARRAYSIZE(queryText), "obj=", {});
+					restartSearch();
+				}
+				for (uint32_t id : LogSymbols::List(LogSymbols::ROLE_OBJECT))
+				{
+					const std::string object(LogSymbols::GetText(id));
+					if (ImGui::Selectable(object.c_str()))
+					{
+						SetQueryTerm(queryText, IM_ARRAYSIZE(queryText), "obj=", object);
+						restartSearch();
+					}
+				}
+				ImGui::EndCombo();
+			}
+			ImGui::SetItemTooltip("Show only messages of one object (LOG1..LOG3 prefix)");
+
+			// Threads registered in LogThreads, matched by their index (thread=)
+			ImGui::SameLine();
+			ImGui::SetNextItemWidth(160.0f);
+			if (ImGui::BeginCombo("##Thread", "Thread", ImGuiComboFlags_HeightLarge))
+			{
+				if (ImGui::Selectable("(any)"))
+				{
+					SetQueryTerm(queryText, IM_ARRAYSIZE(queryText), "thread=", {});
+					restartSearch();
+				}
+				const size_t threadCount = LogThreads::GetCount();
+				for (uint16_t index = 1; index <= threadCount; ++index)
+				{
+					ImGui::PushID(index);
+					if (ImGui::Selectable(LogThreads::GetName(index).c_str()))
+						filterThread = index;
+					ImGui::PopID();
+				}
+				ImGui::EndCombo();
+			}
+			ImGui::SetItemTooltip("Show only messages logged by one thread");
+
+			if (filterThread != LogThreads::NONE)
+			{
+				SetQueryTerm(queryText, IM_ARRAYSIZE(queryText), "thread=", std::to_string(filterThread));
+				filterThread = LogThreads::NONE;
+				restartSearch();
+			}
+
+			searchWorker.FetchResults(searchResults);
+
+			// The ring can't hold more matches than its capacity, drop results that were overwritten there
+			if (searchResults.size() > capacity)
+				searchResults.erase(searchResults.begin(), searchResults.begin() + (searchResults.size() - capacity));
+
+			ImGui::SameLine();
+			if (searchWorker.IsBusy())
+			{
+				RedrawScheduler::RequestRedraw();
+				ImGui::ProgressBar(searchWorker.GetProgress(), ImVec2(150.0f, 0.0f));
+			}
+			else if (searchActive)
+				ImGui::TextDisabled("%zu matches", searchResults.size());
+
+			std::string queryError = searchWorker.GetError();
+			if (!queryError.empty())
+			{
+				ImGui::SameLine();
+				ImGui::TextColored(ImVec4(1.0f, 0.3f, 0.3f, 1.0f), "%s", queryError.c_str());
+			}
+
+			if (ImGui::BeginChild("##Filtered", ImVec2(0, 0), ImGuiChildFlags_Borders))
+			{
+				if (ImGui::BeginTable("FilteredTable", columnCount, tableFlags))
+				{
+					ImGui::TableSetupColumn("Level", ImGuiTableColumnFlags_WidthFixed, levelWidth);
+					ImGui::TableSetupColumn("Time", ImGuiTableColumnFlags_WidthFixed, timeWidth);
+					if (locationColumn)
+						ImGui::TableSetupColumn("Location", ImGuiTableColumnFlags_WidthFixed, locationWidth);
+					if (threadColumn)
+						ImGui::TableSetupColumn("Thread", ImGuiTableColumnFlags_WidthFixed, threadWidth);
+					if (sourceColumn)
+						ImGui::TableSetupColumn("Source", ImGuiTableColumnFlags_WidthFixed, sourceWidth);
+					ImGui::TableSetupColumn("Message", ImGuiTableColumnFlags_WidthStretch);
+
+					ImGuiListClipper clipper;
+					clipper.Begin(static_cast<int>(searchResults.size()));
+
+					while (clipper.Step())
+					{
+						for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i)
+						{
+							const LogMessage& msg = searchResults[i];
+							if (DrawLogRow(msg, sourceColumn))
+								scrollToSequence = msg.sequence;
+						}
+					}
+					ImGui::EndTable();
+				}
+			}
+			ImGui::EndChild();
+		}
+
+		ShowExportPopup(exporter, exportRows, showFilter ? queryText : "");
+		ImGui::End();
+	}
+}
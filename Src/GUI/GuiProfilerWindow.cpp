@@ -0,0 +1,286 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "GuiLayer.h"
+#include "Profiler/FrameProfiler.h"
+#include "imgui.h"
+#include "implot.h"
+
+namespace
+{
+	constexpr double FRAME_BUDGET_MS = 1000.0 / 60.0;
+
+	double ToMilliseconds(int64_t ns) { return static_cast<double>(ns) / 1e6; }
+
+	// Stable color per zone name
+	ImU32 ZoneColor(const char* name)
+	{
+		uint32_t hash = 2166136261u;
+		for (const char* c = name; *c; ++c)
+			hash = (hash ^ static_cast<unsigned char>(*c)) * 16777619u;
+		ImVec4 color = ImPlot::GetColormapColor(static_cast<int>(hash % 10), ImPlotColormap_Deep);
+		color.w = 0.85f;
+		return ImGui::ColorConvertFloat4ToU32(color);
+	}
+
+	// Per-zone statistics over several frames; a zone called several times in one frame counts with its frame total
+	struct ZoneStats
+	{
+		const char* name = nullptr;
+		double minMs = std::numeric_limits<double>::max();
+		double maxMs = 0.0;
+		double totalMs = 0.0;
+		uint64_t calls = 0;
+		size_t frames = 0;
+
+		double frameMs = 0.0;  // Accumulator of the frame being folded
+		size_t lastFrame = SIZE_MAX;
+	};
+
+	void CollectZoneStats(size_t firstFrame, size_t frameCount, std::vector<ZoneStats>& stats)
+	{
+		stats.clear();
+		for (size_t f = firstFrame; f < firstFrame + frameCount; ++f)
+		{
+			for (const gear::ProfileZone& zone : gear::FrameProfiler::GetFrame(f).zones)
+			{
+				auto it = std::find_if(stats.begin(), stats.end(), [&](const ZoneStats& s)
+					{
+						return s.name == zone.name || std::strcmp(s.name, zone.name) == 0;
+					});
+				if (it == stats.end())
+				{
+					stats.emplace_back().name = zone.name;
+					it = stats.end() - 1;
+				}
+				if (it->lastFrame != f)
+				{
+					it->lastFrame = f;
+					it->frameMs = 0.0;
+					++it->frames;
+				}
+				it->frameMs += ToMilliseconds(zone.endNs - zone.startNs);
+				++it->calls;
+			}
+
+			for (ZoneStats& s : stats)
+			{
+				if (s.lastFrame != f)
+					continue;
+				s.minMs = std::min(s.minMs, s.frameMs);
+				s.maxMs = std::max(s.maxMs, s.frameMs);
+				s.totalMs += s.frameMs;
+			}
+		}
+	}
+
+	// Flame graph of one frame: one lane per thread, one row per nesting level, drawn into an ImPlot plot
+	// so it can be zoomed and panned
+	void ShowFlameGraph(const gear::ProfileFrame& frame, bool frameChanged)
+	{
+		static std::vector<int> laneDepth; // Deepest level per thread, -1 = no zones
+		static std::vector<int> laneBase;  // First row of each thread's lane
+		uint16_t maxThread = 0;
+		for (const gear::ProfileZone& zone : frame.zones)
+			maxThread = std::max(maxThread, zone.thread);
+
+		laneDepth.assign(frame.zones.empty() ? 0 : maxThread + 1, -1);
+		for (const gear::ProfileZone& zone : frame.zones)
+			laneDepth[zone.thread] = std::max(laneDepth[zone.thread], static_cast<int>(zone.depth));
+
+		laneBase.assign(laneDepth.size(), 0);
+		int rows = 0;
+		for (size_t t = 0; t < laneDepth.size(); ++t)
+		{
+			laneBase[t] = rows;
+			if (laneDepth[t] >= 0)
+				rows += laneDepth[t] + 2; // Levels + one gap row for the thread label
+		}
+		rows = std::max(rows, 1);
+
+		const float rowHeight = ImGui::GetTextLineHeightWithSpacing() + 2.0f;
+		const float plotHeight = std::clamp(rows * rowHeight + 50.0f, 120.0f, 400.0f);
+		if (!ImPlot::BeginPlot("##FlameGraph", ImVec2(-1, plotHeight), ImPlotFlags_NoLegend | ImPlotFlags_NoMenus))
+			return;
+
+		const double frameMs = ToMilliseconds(frame.durationNs);
+		ImPlot::SetupAxes("Time [ms]", nullptr, 0, ImPlotAxisFlags_Invert | ImPlotAxisFlags_NoTickLabels | ImPlotAxisFlags_NoGridLines | ImPlotAxisFlags_Lock);
+		ImPlot::SetupAxisLimits(ImAxis_X1, 0.0, std::max(frameMs, 0.001), frameChanged ? ImPlotCond_Always : ImPlotCond_Once);
+		ImPlot::SetupAxisLimits(ImAxis_Y1, 0.0, rows, ImPlotCond_Always);
+
+		ImDrawList* drawList = ImPlot::GetPlotDrawList();
+		ImPlot::PushPlotClipRect();
+
+		const ImVec2 mouse = ImGui::GetMousePos();
+		const gear::ProfileZone* hovered = nullptr;
+		for (const gear::ProfileZone& zone : frame.zones)
+		{
+			const double row = laneBase[zone.thread] + 1 + zone.depth;
+			const ImVec2 p0 = ImPlot::PlotToPixels(ToMilliseconds(zone.startNs), row);
+			const ImVec2 p1 = ImPlot::PlotToPixels(ToMilliseconds(zone.endNs), row + 1.0);
+			if (p1.x - p0.x < 1.0f)
+				continue; // Sub-pixel
+
+			drawList->AddRectFilled(p0, ImVec2(p1.x, p1.y - 1.0f), ZoneColor(zone.name));
+			const float textWidth = ImGui::CalcTextSize(zone.name).x;
+			if (p1.x - p0.x > textWidth + 6.0f)
+				drawList->AddText(ImVec2(p0.x + 3.0f, p0.y + 1.0f), IM_COL32_WHITE, zone.name);
+
+			if (ImPlot::IsPlotHovered() && mouse.x >= p0.x && mouse.x < p1.x && mouse.y >= p0.y && mouse.y < p1.y)
+				hovered = &zone;
+		}
+
+		// Thread labels in the gap row above each lane
+		for (size_t t = 0; t < laneDepth.size(); ++t)
+		{
+			if (laneDepth[t] < 0)
+				continue;
+			const ImVec2 p = ImPlot::PlotToPixels(ImPlot::GetPlotLimits().X.Min, laneBase[t]);
+			drawList->AddText(ImVec2(p.x + 3.0f, p.y + 1.0f), ImGui::GetColorU32(ImGuiCol_TextDisabled),
+				gear::FrameProfiler::GetThreadName(static_cast<uint16_t>(t)).c_str());
+		}
+		ImPlot::PopPlotClipRect();
+
+		if (hovered)
+		{
+			ImGui::BeginTooltip();
+			ImGui::TextUnformatted(hovered->name);
+			ImGui::Text("%.3f ms  (at %.3f ms)", ToMilliseconds(hovered->endNs - hovered->startNs), ToMilliseconds(hovered->startNs));
+			ImGui::TextDisabled("%s, depth %u", gear::FrameProfiler::GetThreadName(hovered->thread).c_str(), static_cast<unsigned>(hovered->depth));
+			ImGui::EndTooltip();
+		}
+		ImPlot::EndPlot();
+	}
+}
+
+namespace gear
+{
+	void GuiLayer::ShowProfilerWindow(bool* p_open)
+	{
+		static bool paused = false;
+		static int statsFrames = 120;
+		static uint64_t selectedFrame = UINT64_MAX; // ProfileFrame::index, UINT64_MAX = latest
+		static uint64_t shownFrame = UINT64_MAX;
+
+		// Recording only runs while the window is open; pausing keeps the ring as it is
+		FrameProfiler::SetEnabled(*p_open && !paused);
+		if (!*p_open)
+			return;
+
+		ImGui::SetNextWindowSize(ImVec2(760, 720), ImGuiCond_FirstUseEver);
+		if (!ImGui::Begin("Profiler", p_open))
+		{
+			ImGui::End();
+			return;
+		}
+
+		const size_t frameCount = FrameProfiler::GetFrameCount();
+		if (ImGui::Checkbox("Pause", &paused) && !paused)
+			selectedFrame = UINT64_MAX;
+		ImGui::SameLine();
+		ImGui::SetNextItemWidth(200.0f);
+		ImGui::SliderInt("Stats frames", &statsFrames, 10, static_cast<int>(FrameProfiler::MAX_FRAMES));
+		ImGui::SameLine();
+		ImGui::TextDisabled("Zones come from GEAR_TRACE_SCOPE, click a frame to inspect it");
+
+		if (frameCount == 0)
+		{
+			ImGui::TextUnformatted("Waiting for frames...");
+			ImGui::End();
+			return;
+		}
+
+		// Frame times of the ring, oldest first
+		static std::vector<double> frameMs;
+		frameMs.resize(frameCount);
+		double sumMs = 0.0, maxMs = 0.0;
+		for (size_t i = 0; i < frameCount; ++i)
+		{
+			frameMs[i] = ToMilliseconds(FrameProfiler::GetFrame(i).durationNs);
+			sumMs += frameMs[i];
+			maxMs = std::max(maxMs, frameMs[i]);
+		}
+
+		// Resolve the selection to a ring position (a selected frame may have left the ring)
+		const uint64_t firstIndex = FrameProfiler::GetFrame(0).index;
+		size_t selected = frameCount - 1;
+		if (selectedFrame != UINT64_MAX && selectedFrame >= firstIndex && selectedFrame - firstIndex < frameCount)
+			selected = static_cast<size_t>(selectedFrame - firstIndex);
+
+		ImGui::Text("Avg %.2f ms (%.0f FPS), max %.2f ms over %zu frames", sumMs / frameCount, 1000.0 * frameCount / std::max(sumMs, 1e-9), maxMs, frameCount);
+
+		if (ImPlot::BeginPlot("Frame Times", ImVec2(-1, 150), ImPlotFlags_NoLegend))
+		{
+			ImPlot::SetupAxes("Frame", "ms", ImPlotAxisFlags_AutoFit, ImPlotAxisFlags_AutoFit);
+			ImPlot::PlotBars("Frame", frameMs.data(), static_cast<int>(frameCount), 0.8);
+			const double selectedX = static_cast<double>(selected);
+			ImPlot::PlotInfLines("Selected", &selectedX, 1);
+			ImPlot::PlotInfLines("Budget", &FRAME_BUDGET_MS, 1, ImPlotInfLinesFlags_Horizontal);
+
+			if (ImPlot::IsPlotHovered() && ImGui::IsMouseClicked(ImGuiMouseButton_Left))
+			{
+				const double x = ImPlot::GetPlotMousePos().x + 0.5;
+				if (x >= 0.0 && x < static_cast<double>(frameCount))
+				{
+					selected = static_cast<size_t>(x);
+					selectedFrame = FrameProfiler::GetFrame(selected).index;
+					paused = true;
+				}
+			}
+			ImPlot::EndPlot();
+		}
+
+		const ProfileFrame& frame = FrameProfiler::GetFrame(selected);
+		ImGui::SeparatorText(("Frame " + std::to_string(frame.index)).c_str());
+		ShowFlameGraph(frame, frame.index != shownFrame);
+		shownFrame = frame.index;
+
+		// Per-zone statistics over the last 'statsFrames' frames (up to the selected one)
+		const size_t statsCount = std::min<size_t>(static_cast<size_t>(statsFrames), selected + 1);
+		static std::vector<ZoneStats> stats;
+		CollectZoneStats(selected + 1 - statsCount, statsCount, stats);
+		std::sort(stats.begin(), stats.end(), [](const ZoneStats& a, const ZoneStats& b) { return a.totalMs / a.frames > b.totalMs / b.frames; });
+
+		const float tableHeight = std::min(ImGui::GetTextLineHeightWithSpacing() * (stats.size() + 2), 260.0f);
+		if (ImGui::BeginTable("##ZoneStats", 5, ImGuiTableFlags_RowBg | ImGuiTableFlags_BordersInnerV | ImGuiTableFlags_ScrollY | ImGuiTableFlags_Resizable,
+			ImVec2(0.0f, tableHeight)))
+		{
+			ImGui::TableSetupScrollFreeze(0, 1);
+			ImGui::TableSetupColumn("Zone", ImGuiTableColumnFlags_WidthStretch);
+			ImGui::TableSetupColumn("Calls/frame", ImGuiTableColumnFlags_WidthFixed, 80.0f);
+			ImGui::TableSetupColumn("Min [ms]", ImGuiTableColumnFlags_WidthFixed, 70.0f);
+			ImGui::TableSetupColumn("Avg [ms]", ImGuiTableColumnFlags_WidthFixed, 70.0f);
+			ImGui::TableSetupColumn("Max [ms]", ImGuiTableColumnFlags_WidthFixed, 70.0f);
+			ImGui::TableHeadersRow();
+
+			for (const ZoneStats& s : stats)
+			{
+				ImGui::TableNextRow();
+				ImGui::TableNextColumn();
+				ImGui::ColorButton("##Color", ImGui::ColorConvertU32ToFloat4(ZoneColor(s.name)), ImGuiColorEditFlags_NoTooltip, ImVec2(10, 10));
+				ImGui::SameLine();
+				ImGui::TextUnformatted(s.name);
+				ImGui::TableNextColumn(); ImGui::Text("%.1f", static_cast<double>(s.calls) / s.frames);
+				ImGui::TableNextColumn(); ImGui::Text("%.3f", s.minMs);
+				ImGui::TableNextColumn(); ImGui::Text("%.3f", s.totalMs / s.frames);
+				ImGui::TableNextColumn(); ImGui::Text("%.3f", s.maxMs);
+			}
+			ImGui::EndTable();
+		}
+
+		if (ImPlot::BeginPlot("Frame Time Histogram", ImVec2(-1, -1), ImPlotFlags_NoLegend))
+		{
+			ImPlot::SetupAxes("Frame time [ms]", "Frames", ImPlotAxisFlags_AutoFit, ImPlotAxisFlags_AutoFit);
+			ImPlot::PlotHistogram("Frames", frameMs.data(), static_cast<int>(frameCount), 40);
+			ImPlot::PlotInfLines("Budget", &FRAME_BUDGET_MS, 1);
+			ImPlot::EndPlot();
+		}
+
+		ImGui::End();
+	}
+}
@@ -0,0 +1,101 @@
+#pragma once
+
+// Binary log datagram format for the socket ingestion server (LogSocketServer).
+//
+// Self-contained (std only), so tools can include it without GEAR. Every datagram carries a batch of
+// records from one process; all integers are little-endian and fields are packed without padding:
+//
+//   Header (28 bytes)
+//     uint32  magic        LOG_DATAGRAM_MAGIC ("GLDG")
+//     uint16  version      LOG_DATAGRAM_VERSION
+//     uint16  recordCount
+//     uint32  pid
+//     char[16] processName zero padded, shown as "name:pid" in the Logger window
+//   Record (12 bytes + text), repeated recordCount times
+//     int64   timestampNs  system clock, ns since epoch; 0 = time of arrival
+//     uint8   level        ShmLogLevel values: 0 Info, 1 Warning, 2 Error, 3 Debug
+//     uint8   reserved     0
+//     uint16  textLength
+//     char[]  text         textLength bytes, no terminator
+//
+// Python example:
+//   header = struct.pack("<IHHI16s", 0x47444C47, 1, len(texts), os.getpid(), b"myscript")
+//   records = b"".join(struct.pack("<qBBH", 0, 0, 0, len(t)) + t for t in texts)
+//   sock.sendto(header + records, "/tmp/gear_log.sock")
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+#include "ShmLogLayout.h"
+
+namespace gear
+{
+	inline constexpr uint32_t LOG_DATAGRAM_MAGIC = 0x47444C47; // "GLDG"
+	inline constexpr uint16_t LOG_DATAGRAM_VERSION = 1;
+	inline constexpr size_t LOG_DATAGRAM_HEADER_SIZE = 28;
+	inline constexpr size_t LOG_DATAGRAM_RECORD_HEADER_SIZE = 12;
+	inline constexpr size_t LOG_DATAGRAM_MAX_SIZE = 65507; // Largest UDP payload, also used for Unix sockets
+
+	// Little-endian field access (memcpy, so unaligned offsets are fine; every supported target is little-endian)
+	template<typename T>
+	inline T LoadLE(const char* p)
+	{
+		T value;
+		std::memcpy(&value, p, sizeof(T));
+		return value;
+	}
+
+	template<typename T>
+	inline void StoreLE(char* p, T value)
+	{
+		std::memcpy(p, &value, sizeof(T));
+	}
+
+	// Builds one datagram in a caller-provided buffer (no allocation). Used by the load generator and tests.
+	class LogDatagramWriter
+	{
+	public:
+		LogDatagramWriter(char* buffer, size_t capacity, uint32_t pid, std::string_view processName)
+			: buffer(buffer), capacity(capacity)
+		{
+			StoreLE<uint32_t>(buffer, LOG_DATAGRAM_MAGIC);
+			StoreLE<uint16_t>(buffer + 4, LOG_DATAGRAM_VERSION);
+			StoreLE<uint16_t>(buffer + 6, 0);
+			StoreLE<uint32_t>(buffer + 8, pid);
+			std::memset(buffer + 12, 0, SHM_LOG_NAME_SIZE);
+			std::memcpy(buffer + 12, processName.data(), std::min(processName.size(), SHM_LOG_NAME_SIZE - 1));
+			size = LOG_DATAGRAM_HEADER_SIZE;
+		}
+
+		// Returns false (and adds nothing) if the record does not fit anymore
+		bool Add(ShmLogLevel level, std::string_view text, int64_t timestampNs = 0)
+		{
+			if (text.size() > UINT16_MAX || recordCount == UINT16_MAX
+				|| size + LOG_DATAGRAM_RECORD_HEADER_SIZE + text.size() > capacity)
+				return false;
+
+			char* record = buffer + size;
+			StoreLE<int64_t>(record, timestampNs);
+			record[8] = static_cast<char>(level);
+			record[9] = 0;
+			StoreLE<uint16_t>(record + 10, static_cast<uint16_t>(text.size()));
+			std::memcpy(record + LOG_DATAGRAM_RECORD_HEADER_SIZE, text.data(), text.size());
+
+			size += LOG_DATAGRAM_RECORD_HEADER_SIZE + text.size();
+			StoreLE<uint16_t>(buffer + 6, ++recordCount);
+			return true;
+		}
+
+		const char* Data() const { return buffer; }
+		size_t Size() const { return size; }
+		uint16_t GetRecordCount() const { return recordCount; }
+
+	private:
+		char* buffer;
+		size_t capacity;
+		size_t size = 0;
+		uint16_t recordCount = 0;
+	};
+}
@@ -0,0 +1,305 @@
+#include "LogSocketServer.h"
+
+#include <array>
+#include <cstring>
+
+#include "Logger/LogSources.h"
+
+#ifndef _WIN32
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#endif
+
+namespace gear
+{
+	namespace
+	{
+		constexpr std::string_view UDP_PREFIX = "udp://";
+	}
+
+	LogSocketServer::LogSocketServer(std::string address, Sink sink)
+		: address(std::move(address)), sink(std::move(sink))
+	{
+		// Every slot keeps its string capacity between batches
+		batch.resize(MAX_BATCH_SIZE);
+
+		if (Listen())
+			workerThread = std::thread(&LogSocketServer::Run, this);
+	}
+
+	LogSocketServer::~LogSocketServer()
+	{
+		stopFlag = true;
+#ifndef _WIN32
+		if (wakeWriteFd >= 0)
+		{
+			const uint64_t one = 1;
+			[[maybe_unused]] ssize_t written = ::write(wakeWriteFd, &one, sizeof(one));
+		}
+#endif
+		if (workerThread.joinable())
+			workerThread.join();
+
+#ifndef _WIN32
+		if (socketFd >= 0)
+			::close(socketFd);
+		if (wakeFd >= 0)
+			::close(wakeFd);
+		if (wakeWriteFd >= 0 && wakeWriteFd != wakeFd)
+			::close(wakeWriteFd);
+		if (!socketPath.empty())
+			::unlink(socketPath.c_str());
+#endif
+	}
+
+	std::string LogSocketServer::GetError() const
+	{
+		std::lock_guard lock(errorMutex);
+		return lastError;
+	}
+
+	void LogSocketServer::SetError(std::string error)
+	{
+		std::lock_guard lock(errorMutex);
+		lastError = std::move(error);
+	}
+
+	bool LogSocketServer::Listen()
+	{
+#ifdef _WIN32
+		SetError("Log socket ingestion is only supported on POSIX systems");
+		return false;
+#else
+		auto fail = [this](const std::string& what, int fd)
+			{
+				SetError(what + " '" + address + "': " + std::strerror(errno));
+				if (fd >= 0)
+					::close(fd);
+				return false;
+			};
+
+		int fd = -1;
+		if (std::string_view(address).substr(0, UDP_PREFIX.size()) == UDP_PREFIX)
+		{
+			const int port = std::atoi(address.c_str() + UDP_PREFIX.size());
+			if (port <= 0 || port > 65535)
+			{
+				SetError("Invalid UDP port in '" + address + "'");
+				return false;
+			}
+
+			fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+			if (fd < 0)
+				return fail("socket", fd);
+
+			// Loopback only, the format has no authentication
+			sockaddr_in addr{};
+			addr.sin_family = AF_INET;
+			addr.sin_port = htons(static_cast<uint16_t>(port));
+			addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+			if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0)
+				return fail("bind", fd);
+		}
+		else
+		{
+			sockaddr_un addr{};
+			if (address.empty() || address.size() >= sizeof(addr.sun_path))
+			{
+				SetError("Invalid Unix socket path '" + address + "'");
+				return false;
+			}
+
+			fd = ::socket(AF_UNIX, SOCK_DGRAM, 0);
+			if (fd < 0)
+				return fail("socket", fd);
+
+			// A socket file left by a crashed run would make bind() fail
+			::unlink(address.c_str());
+			addr.sun_family = AF_UNIX;
+			std::memcpy(addr.sun_path, address.c_str(), address.size());
+			if (::bind(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr)) != 0)
+				return fail("bind", fd);
+			socketPath = address;
+		}
+
+		// Absorb bursts while the ingestion thread is busy; the kernel may clamp this (net.core.rmem_max)
+		const int receiveBuffer = RECEIVE_BUFFER_SIZE;
+		::setsockopt(fd, SOL_SOCKET, SO_RCVBUF, &receiveBuffer, sizeof(receiveBuffer));
+		::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+
+#ifdef __linux__
+		wakeFd = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+		if (wakeFd < 0)
+			return fail("eventfd", fd);
+		wakeWriteFd = wakeFd;
+#else
+		int pipeFds[2];
+		if (::pipe(pipeFds) != 0)
+			return fail("pipe", fd);
+		wakeFd = pipeFds[0];
+		wakeWriteFd = pipeFds[1];
+#endif
+
+		socketFd = fd;
+		return true;
+#endif
+	}
+
+	void LogSocketServer::Run()
+	{
+#ifndef _WIN32
+		// Receive buffers are allocated once; datagrams are parsed in place
+		std::vector<char> storage(RECV_BATCH * LOG_DATAGRAM_MAX_SIZE);
+
+#ifdef __linux__
+		const int epollFd = ::epoll_create1(EPOLL_CLOEXEC);
+		if (epollFd < 0)
+		{
+			SetError(std::string("epoll_create1: ") + std::strerror(errno));
+			return;
+		}
+		epoll_event event{};
+		event.events = EPOLLIN;
+		event.data.fd = socketFd;
+		::epoll_ctl(epollFd, EPOLL_CTL_ADD, socketFd, &event);
+		event.data.fd = wakeFd;
+		::epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &event);
+
+		std::array<mmsghdr, RECV_BATCH> headers{};
+		std::array<iovec, RECV_BATCH> vectors{};
+		for (size_t i = 0; i < RECV_BATCH; ++i)
+		{
+			vectors[i].iov_base = storage.data() + i * LOG_DATAGRAM_MAX_SIZE;
+			vectors[i].iov_len = LOG_DATAGRAM_MAX_SIZE;
+			headers[i].msg_hdr.msg_iov = &vectors[i];
+			headers[i].msg_hdr.msg_iovlen = 1;
+		}
+#endif
+
+		while (!stopFlag)
+		{
+#ifdef __linux__
+			std::array<epoll_event, 2> events;
+			if (::epoll_wait(epollFd, events.data(), static_cast<int>(events.size()), -1) <= 0)
+				continue; // EINTR
+#else
+			std::array<pollfd, 2> fds{ { { socketFd, POLLIN, 0 }, { wakeFd, POLLIN, 0 } } };
+			if (::poll(fds.data(), fds.size(), -1) <= 0)
+				continue;
+#endif
+			if (stopFlag)
+				break;
+
+			// Drain the socket completely before waiting again; one sink call per RECV_BATCH datagrams at most
+			for (;;)
+			{
+#ifdef __linux__
+				const int received = ::recvmmsg(socketFd, headers.data(), RECV_BATCH, MSG_DONTWAIT, nullptr);
+				if (received <= 0)
+					break;
+				const auto now = std::chrono::system_clock::now();
+				for (int i = 0; i < received; ++i)
+					ParseDatagram(storage.data() + i * LOG_DATAGRAM_MAX_SIZE, headers[i].msg_len, now);
+#else
+				const ssize_t received = ::recv(socketFd, storage.data(), LOG_DATAGRAM_MAX_SIZE, MSG_DONTWAIT);
+				if (received < 0)
+					break;
+				ParseDatagram(storage.data(), static_cast<size_t>(received), std::chrono::system_clock::now());
+#endif
+				Flush();
+			}
+		}
+
+#ifdef __linux__
+		::close(epollFd);
+#endif
+#endif
+	}
+
+	bool LogSocketServer::ParseDatagram(const char* data, size_t size, std::chrono::system_clock::time_point now)
+	{
+		if (size < LOG_DATAGRAM_HEADER_SIZE
+			|| LoadLE<uint32_t>(data) != LOG_DATAGRAM_MAGIC
+			|| LoadLE<uint16_t>(data + 4) != LOG_DATAGRAM_VERSION)
+		{
+			rejectedCount.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+
+		// Validate the whole datagram first, so a truncated one is rejected without forwarding a part of it
+		const uint16_t count = LoadLE<uint16_t>(data + 6);
+		size_t offset = LOG_DATAGRAM_HEADER_SIZE;
+		uint16_t valid = 0;
+		while (valid < count && offset + LOG_DATAGRAM_RECORD_HEADER_SIZE <= size)
+		{
+			offset += LOG_DATAGRAM_RECORD_HEADER_SIZE + LoadLE<uint16_t>(data + offset + 10);
+			++valid;
+		}
+		if (valid != count || offset != size)
+		{
+			rejectedCount.fetch_add(1, std::memory_order_relaxed);
+			return false;
+		}
+
+		const uint32_t pid = LoadLE<uint32_t>(data + 8);
+		const char* name = data + 12;
+		const uint16_t sourceId = SourceFor(pid, std::string_view(name, ::strnlen(name, SHM_LOG_NAME_SIZE)));
+
+		offset = LOG_DATAGRAM_HEADER_SIZE;
+		for (uint16_t i = 0; i < count; ++i)
+		{
+			if (batchCount == batch.size())
+				Flush();
+
+			const char* record = data + offset;
+			const int64_t timestampNs = LoadLE<int64_t>(record);
+			const uint16_t textLength = LoadLE<uint16_t>(record + 10);
+
+			LogMessage& message = batch[batchCount++];
+			message.level = static_cast<LogLevel>(record[8] & 3);
+			message.timestamp = timestampNs != 0 ? FromEpochNanoseconds(timestampNs) : now;
+			message.sourceId = sourceId;
+			message.message.assign(record + LOG_DATAGRAM_RECORD_HEADER_SIZE, textLength); // Reuses the slot's capacity
+
+			offset += LOG_DATAGRAM_RECORD_HEADER_SIZE + textLength;
+		}
+
+		datagramCount.fetch_add(1, std::memory_order_relaxed);
+		recordCount.fetch_add(count, std::memory_order_relaxed);
+		byteCount.fetch_add(size, std::memory_order_relaxed);
+		return true;
+	}
+
+	void LogSocketServer::Flush()
+	{
+		if (batchCount == 0)
+			return;
+		sink(batch.data(), batchCount);
+		batchCount = 0;
+	}
+
+	uint16_t LogSocketServer::SourceFor(uint32_t pid, std::string_view name)
+	{
+		// The key is a reused member, so known senders cost no allocation
+		sourceKey.first = pid;
+		sourceKey.second.assign(name);
+		auto it = sources.find(sourceKey);
+		if (it != sources.end())
+			return it->second;
+
+		const std::string sourceName = sourceKey.second + ":" + std::to_string(pid);
+		const uint16_t id = LogSources::Register(sourceName, LogSources::DefaultColor(LogSources::GetCount()));
+		sources.emplace(sourceKey, id);
+		return id;
+	}
+}
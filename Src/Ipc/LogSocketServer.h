@@ -0,0 +1,87 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "LogDatagram.h"
+#include "Logger/LogMessage.h"
+
+namespace gear
+{
+	// Receives batched log datagrams (LogDatagram.h) on a local socket and forwards them as LogMessages.
+	//
+	// 'address' is either a filesystem path (Unix datagram socket, created and removed by the server) or
+	// "udp://<port>" (UDP bound to 127.0.0.1 only). A single ingestion thread waits on epoll (poll outside
+	// Linux), reads up to RECV_BATCH datagrams per syscall (recvmmsg) into fixed buffers and parses them into
+	// a preallocated LogMessage batch. The sink gets the batch as an array; with Logger::PushExternal the texts
+	// are swapped into the ring, so steady-state ingestion does not allocate per message.
+	// Malformed datagrams are counted and skipped. POSIX only.
+	class LogSocketServer
+	{
+	public:
+		static constexpr const char* DEFAULT_ADDRESS = "/tmp/gear_log.sock";
+		static constexpr size_t RECV_BATCH = 32;      // Datagrams per recvmmsg() call
+		static constexpr size_t MAX_BATCH_SIZE = 4096; // Messages per sink call
+		static constexpr int RECEIVE_BUFFER_SIZE = 8 * 1024 * 1024;
+
+		using Sink = std::function<void(LogMessage* messages, size_t count)>;
+
+		LogSocketServer(std::string address, Sink sink);
+		~LogSocketServer();
+
+		LogSocketServer(const LogSocketServer&) = delete;
+		LogSocketServer& operator=(const LogSocketServer&) = delete;
+
+		bool IsListening() const { return socketFd >= 0; }
+		const std::string& GetAddress() const { return address; }
+		std::string GetError() const;
+
+		uint64_t GetDatagramCount() const { return datagramCount.load(std::memory_order_relaxed); }
+		uint64_t GetRecordCount() const { return recordCount.load(std::memory_order_relaxed); }
+		uint64_t GetByteCount() const { return byteCount.load(std::memory_order_relaxed); }
+		uint64_t GetRejectedCount() const { return rejectedCount.load(std::memory_order_relaxed); }
+
+	private:
+		bool Listen();
+		void Run();
+		void SetError(std::string error);
+
+		// Parses one datagram into 'batch' (flushing to the sink when it is full). Returns false if malformed.
+		bool ParseDatagram(const char* data, size_t size, std::chrono::system_clock::time_point now);
+		void Flush();
+		uint16_t SourceFor(uint32_t pid, std::string_view name);
+
+		std::string address;
+		std::string socketPath; // Unix socket file to remove on shutdown
+		Sink sink;
+
+		int socketFd = -1;
+		int wakeFd = -1;      // eventfd (Linux) or pipe read end, signalled by the destructor
+		int wakeWriteFd = -1; // pipe write end (same as wakeFd on Linux)
+
+		std::vector<LogMessage> batch; // Preallocated, reused; 'batchCount' entries are valid
+		size_t batchCount = 0;
+		std::map<std::pair<uint32_t, std::string>, uint16_t> sources; // Ingestion thread only
+		std::pair<uint32_t, std::string> sourceKey;
+
+		std::atomic<uint64_t> datagramCount{ 0 };
+		std::atomic<uint64_t> recordCount{ 0 };
+		std::atomic<uint64_t> byteCount{ 0 };
+		std::atomic<uint64_t> rejectedCount{ 0 };
+		std::atomic<bool> stopFlag{ false };
+
+		mutable std::mutex errorMutex;
+		std::string lastError;
+
+		std::thread workerThread;
+	};
+}
@@ -0,0 +1,211 @@
+#include "ShmLogConsumer.h"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+#include "Logger/LogSources.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace gear
+{
+	static_assert(static_cast<int>(ShmLogLevel::Info) == static_cast<int>(LogLevel::Info)
+		&& static_cast<int>(ShmLogLevel::Warning) == static_cast<int>(LogLevel::Warning)
+		&& static_cast<int>(ShmLogLevel::Error) == static_cast<int>(LogLevel::Error)
+		&& static_cast<int>(ShmLogLevel::Debug) == static_cast<int>(LogLevel::Debug),
+		"ShmLogLevel must match LogLevel");
+
+	ShmLogConsumer::ShmLogConsumer(std::string shmName, Sink sink, uint32_t slotCount, uint32_t slotSize)
+		: shmName(std::move(shmName)), sink(std::move(sink))
+	{
+		if (Open(slotCount, slotSize))
+			workerThread = std::thread(&ShmLogConsumer::Run, this);
+	}
+
+	ShmLogConsumer::~ShmLogConsumer()
+	{
+		stopFlag = true;
+		if (workerThread.joinable())
+			workerThread.join();
+
+#ifndef _WIN32
+		if (header)
+			::munmap(header, mappingSize);
+#endif
+	}
+
+	std::string ShmLogConsumer::GetError() const
+	{
+		std::lock_guard lock(errorMutex);
+		return lastError;
+	}
+
+	void ShmLogConsumer::Unlink(const std::string& shmName)
+	{
+#ifndef _WIN32
+		::shm_unlink(shmName.c_str());
+#endif
+	}
+
+	bool ShmLogConsumer::Open(uint32_t slotCount, uint32_t slotSize)
+	{
+#ifdef _WIN32
+		std::lock_guard lock(errorMutex);
+		lastError = "Shared-memory log ring is only supported on POSIX systems";
+		return false;
+#else
+		auto fail = [this](const std::string& what)
+			{
+				std::lock_guard lock(errorMutex);
+				lastError = what + " '" + shmName + "': " + std::strerror(errno);
+				return false;
+			};
+
+		slotCount = std::bit_ceil(std::max<uint32_t>(slotCount, 2));
+		slotSize = (std::max<uint32_t>(slotSize, sizeof(ShmLogSlot) + 64) + 63) & ~63u;
+
+		const int fd = ::shm_open(shmName.c_str(), O_CREAT | O_RDWR, 0600);
+		if (fd < 0)
+			return fail("shm_open");
+
+		struct stat st {};
+		if (::fstat(fd, &st) != 0)
+		{
+			::close(fd);
+			return fail("fstat");
+		}
+
+		// Reuse a ring left by a previous GEAR run: producers may still have it mapped
+		bool reuse = false;
+		if (static_cast<size_t>(st.st_size) >= SHM_LOG_SLOTS_OFFSET)
+		{
+			void* existing = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+			if (existing != MAP_FAILED)
+			{
+				auto* h = static_cast<ShmLogHeader*>(existing);
+				reuse = h->magic.load(std::memory_order_acquire) == SHM_LOG_MAGIC
+					&& h->version == SHM_LOG_VERSION
+					&& h->slotCount > 0 && (h->slotCount & (h->slotCount - 1)) == 0
+					&& h->slotSize > sizeof(ShmLogSlot)
+					&& ShmLogMappingSize(h->slotCount, h->slotSize) <= static_cast<size_t>(st.st_size);
+				if (reuse)
+				{
+					header = h;
+					mappingSize = static_cast<size_t>(st.st_size);
+				}
+				else
+					::munmap(existing, static_cast<size_t>(st.st_size));
+			}
+		}
+
+		if (!reuse)
+		{
+			mappingSize = ShmLogMappingSize(slotCount, slotSize);
+			if (::ftruncate(fd, static_cast<off_t>(mappingSize)) != 0)
+			{
+				::close(fd);
+				return fail("ftruncate");
+			}
+
+			void* mapping = ::mmap(nullptr, mappingSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+			if (mapping == MAP_FAILED)
+			{
+				::close(fd);
+				return fail("mmap");
+			}
+
+			// Producers only use the ring once the magic is published
+			header = static_cast<ShmLogHeader*>(mapping);
+			header->magic.store(0, std::memory_order_relaxed);
+			header->version = SHM_LOG_VERSION;
+			header->slotCount = slotCount;
+			header->slotSize = slotSize;
+			header->writePosition.store(0, std::memory_order_relaxed);
+			header->readPosition.store(0, std::memory_order_relaxed);
+			header->droppedRecords.store(0, std::memory_order_relaxed);
+			for (uint64_t i = 0; i < slotCount; ++i)
+				ShmLogSlotAt(header, i)->sequence.store(i, std::memory_order_relaxed);
+			header->magic.store(SHM_LOG_MAGIC, std::memory_order_release);
+		}
+
+		::close(fd);
+		return true;
+#endif
+	}
+
+	void ShmLogConsumer::Run()
+	{
+		std::vector<LogMessage> batch;
+		batch.reserve(MAX_BATCH_SIZE);
+		auto idleSleep = std::chrono::milliseconds(1);
+
+		while (!stopFlag)
+		{
+			if (Drain(batch) > 0)
+			{
+				sink(batch);
+				batch.clear();
+				idleSleep = std::chrono::milliseconds(1);
+				continue;
+			}
+
+			// Nothing to read: back off up to MAX_IDLE_SLEEP, producers are never blocked by this
+			std::this_thread::sleep_for(idleSleep);
+			idleSleep = std::min(idleSleep * 2, std::chrono::duration_cast<std::chrono::milliseconds>(MAX_IDLE_SLEEP));
+		}
+
+		// Forward what is left when shutting down
+		while (Drain(batch) > 0)
+		{
+			sink(batch);
+			batch.clear();
+		}
+	}
+
+	size_t ShmLogConsumer::Drain(std::vector<LogMessage>& batch)
+	{
+		uint64_t position = header->readPosition.load(std::memory_order_relaxed);
+		const size_t textCapacity = header->slotSize - sizeof(ShmLogSlot);
+
+		while (batch.size() < MAX_BATCH_SIZE)
+		{
+			ShmLogSlot* slot = ShmLogSlotAt(header, position);
+			if (slot->sequence.load(std::memory_order_acquire) != position + 1)
+				break; // Not published yet
+
+			LogMessage& message = batch.emplace_back();
+			message.level = static_cast<LogLevel>(slot->level & 3);
+			message.timestamp = FromEpochNanoseconds(slot->timestampNs);
+			message.message.assign(slot->Text(), std::min<size_t>(slot->textLength, textCapacity));
+			message.sourceId = SourceFor(slot->pid, slot->processName, std::min<size_t>(slot->nameLength, SHM_LOG_NAME_SIZE));
+
+			// Hand the slot back to the producers for the next round
+			slot->sequence.store(position + header->slotCount, std::memory_order_release);
+			++position;
+		}
+
+		header->readPosition.store(position, std::memory_order_release);
+		recordCount.fetch_add(batch.size(), std::memory_order_relaxed);
+		return batch.size();
+	}
+
+	uint16_t ShmLogConsumer::SourceFor(uint32_t pid, const char* name, size_t nameLength)
+	{
+		auto key = std::make_pair(pid, std::string(name, nameLength));
+		auto it = sources.find(key);
+		if (it != sources.end())
+			return it->second;
+
+		const std::string sourceName = key.second + ":" + std::to_string(pid);
+		const uint16_t id = LogSources::Register(sourceName, LogSources::DefaultColor(LogSources::GetCount()));
+		sources.emplace(std::move(key), id);
+		processCount.store(sources.size(), std::memory_order_relaxed);
+		return id;
+	}
+}
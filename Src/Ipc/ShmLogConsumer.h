@@ -0,0 +1,79 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "ShmLogLayout.h"
+#include "Logger/LogMessage.h"
+
+namespace gear
+{
+	// GEAR's side of the shared-memory log ring: creates (or re-attaches to) the ring and forwards
+	// records of worker processes (ShmLogProducer) as LogMessages.
+	//
+	// A worker thread drains the ring in batches and hands them to the sink (normally
+	// Logger::PushExternal). Every producer process gets its own LogSources entry "name:pid", so the
+	// Logger window can show where a message came from. The shm object is kept when GEAR exits, so
+	// running workers keep their mapping and buffer into the ring until GEAR attaches again.
+	// POSIX only; on Windows IsOpen() is false and GetError() says why.
+	class ShmLogConsumer
+	{
+	public:
+		static constexpr uint32_t DEFAULT_SLOT_COUNT = 4096;
+		static constexpr uint32_t DEFAULT_SLOT_SIZE = 512; // 472 bytes of text per record
+		static constexpr size_t MAX_BATCH_SIZE = 4096;
+		static constexpr auto MAX_IDLE_SLEEP = std::chrono::milliseconds(16);
+
+		using Sink = std::function<void(std::vector<LogMessage>& batch)>;
+
+		// An existing valid ring with this name is reused as is (including records still in it),
+		// otherwise it is created with the given geometry (slotCount rounded up to a power of two).
+		ShmLogConsumer(std::string shmName, Sink sink,
+			uint32_t slotCount = DEFAULT_SLOT_COUNT, uint32_t slotSize = DEFAULT_SLOT_SIZE);
+		~ShmLogConsumer();
+
+		ShmLogConsumer(const ShmLogConsumer&) = delete;
+		ShmLogConsumer& operator=(const ShmLogConsumer&) = delete;
+
+		bool IsOpen() const { return header != nullptr; }
+		const std::string& GetName() const { return shmName; }
+		std::string GetError() const;
+
+		uint64_t GetRecordCount() const { return recordCount.load(std::memory_order_relaxed); }
+		uint64_t GetDroppedCount() const { return header ? header->droppedRecords.load(std::memory_order_relaxed) : 0; }
+		size_t GetProcessCount() const { return processCount.load(std::memory_order_relaxed); }
+
+		// Removes the shm object (running producers keep their mapping but are no longer read)
+		static void Unlink(const std::string& shmName);
+
+	private:
+		bool Open(uint32_t slotCount, uint32_t slotSize);
+		void Run();
+		size_t Drain(std::vector<LogMessage>& batch);
+		uint16_t SourceFor(uint32_t pid, const char* name, size_t nameLength);
+
+		std::string shmName;
+		Sink sink;
+
+		ShmLogHeader* header = nullptr;
+		size_t mappingSize = 0;
+
+		std::map<std::pair<uint32_t, std::string>, uint16_t> sources; // (pid, name) -> LogSources id, worker thread only
+		std::atomic<uint64_t> recordCount{ 0 };
+		std::atomic<size_t> processCount{ 0 };
+		std::atomic<bool> stopFlag{ false };
+
+		mutable std::mutex errorMutex;
+		std::string lastError;
+
+		std::thread workerThread;
+	};
+}
@@ -0,0 +1,85 @@
+#pragma once
+
+// Memory layout of the shared-memory log ring (POSIX shm_open + mmap).
+//
+// Self-contained on purpose (std only): worker processes include it through ShmLogProducer.h without
+// linking anything from GEAR. GEAR creates the object and is the only consumer.
+//
+//   offset 0                : ShmLogHeader (256 bytes, hot counters on separate cache lines)
+//   offset 256 + i*slotSize : slot i = ShmLogSlot (40 bytes) followed by the text (slotSize - 40 bytes)
+//
+// The ring is a bounded multi-producer / single-consumer queue (Vyukov style), lock-free and without
+// syscalls on either side:
+//   - Each slot carries a sequence. Slot i starts with sequence i.
+//   - A producer reads writePosition 'p'. If slot (p % slotCount) has sequence == p it is free: the producer
+//     claims it by CAS on writePosition (p -> p+1), fills it and publishes it with sequence = p+1 (release).
+//     If the sequence is lower than p, the ring is full: the record is dropped and droppedRecords counted.
+//   - The consumer reads the slot at readPosition 'r' once its sequence == r+1 (acquire), copies it out,
+//     frees it with sequence = r + slotCount and advances readPosition.
+// Records are fixed size, longer texts are truncated. A producer that dies between claiming and publishing
+// a slot stalls the ring at that slot until GEAR recreates it (restart with the shm object removed).
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace gear
+{
+	inline constexpr const char* SHM_LOG_DEFAULT_NAME = "/gear_log";
+	inline constexpr uint32_t SHM_LOG_MAGIC = 0x4D485347; // "GSHM"
+	inline constexpr uint32_t SHM_LOG_VERSION = 1;
+	inline constexpr size_t SHM_LOG_NAME_SIZE = 16;       // Process name incl. terminating zero (Linux comm length)
+
+	// Same values as LogLevel
+	enum class ShmLogLevel : uint8_t
+	{
+		Info,
+		Warning,
+		Error,
+		Debug
+	};
+
+	struct ShmLogHeader
+	{
+		std::atomic<uint32_t> magic;   // SHM_LOG_MAGIC, written last by the consumer once the ring is initialized
+		uint32_t version;              // SHM_LOG_VERSION
+		uint32_t slotCount;            // Power of two
+		uint32_t slotSize;             // Bytes per slot incl. ShmLogSlot, multiple of 64
+
+		alignas(64) std::atomic<uint64_t> writePosition;  // Next position to claim (producers)
+		alignas(64) std::atomic<uint64_t> readPosition;   // Next position to read (consumer)
+		alignas(64) std::atomic<uint64_t> droppedRecords; // Records producers could not store (ring full)
+	};
+
+	struct ShmLogSlot
+	{
+		std::atomic<uint64_t> sequence; // See protocol above
+		int64_t timestampNs;            // system_clock, nanoseconds since epoch
+		uint32_t pid;
+		uint8_t level;                  // ShmLogLevel
+		uint8_t nameLength;
+		uint16_t textLength;
+		char processName[SHM_LOG_NAME_SIZE];
+
+		char* Text() { return reinterpret_cast<char*>(this + 1); }
+		const char* Text() const { return reinterpret_cast<const char*>(this + 1); }
+	};
+
+	inline constexpr size_t SHM_LOG_SLOTS_OFFSET = sizeof(ShmLogHeader);
+
+	static_assert(sizeof(ShmLogHeader) == 256, "ShmLogHeader layout changed, bump SHM_LOG_VERSION");
+	static_assert(sizeof(ShmLogSlot) == 40, "ShmLogSlot layout changed, bump SHM_LOG_VERSION");
+	static_assert(std::atomic<uint64_t>::is_always_lock_free && std::atomic<uint32_t>::is_always_lock_free,
+		"Shared-memory atomics must be lock-free (address-free) to work across processes");
+
+	inline constexpr size_t ShmLogMappingSize(uint32_t slotCount, uint32_t slotSize)
+	{
+		return SHM_LOG_SLOTS_OFFSET + static_cast<size_t>(slotCount) * slotSize;
+	}
+
+	inline ShmLogSlot* ShmLogSlotAt(ShmLogHeader* header, uint64_t position)
+	{
+		char* base = reinterpret_cast<char*>(header) + SHM_LOG_SLOTS_OFFSET;
+		return reinterpret_cast<ShmLogSlot*>(base + static_cast<size_t>(position & (header->slotCount - 1)) * header->slotSize);
+	}
+}
@@ -0,0 +1,175 @@
+#pragma once
+
+// Header-only producer for the GEAR shared-memory log ring (see ShmLogLayout.h).
+//
+// Usage in a worker process:
+//   gear::ShmLogProducer gearLog;                       // Attaches to "/gear_log" once GEAR runs
+//   gearLog.Log(gear::ShmLogLevel::Warning, "queue almost full");
+//
+// Log() is lock-free and makes no syscalls (the timestamp comes from the vDSO clock). If GEAR is not
+// running yet, attaching is retried at most once per second from within Log(); until then records are
+// discarded and Log() returns false. Only available on POSIX systems, on Windows Log() always returns false.
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+#include "ShmLogLayout.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <fstream>
+#endif
+
+namespace gear
+{
+	class ShmLogProducer
+	{
+	public:
+		// 'processName' is shown in GEAR next to the PID; empty = executable name
+		explicit ShmLogProducer(std::string shmName = SHM_LOG_DEFAULT_NAME, std::string processName = {})
+			: shmName(std::move(shmName)), processName(std::move(processName))
+		{
+#ifndef _WIN32
+			pid = static_cast<uint32_t>(::getpid());
+			if (this->processName.empty())
+			{
+				std::ifstream comm("/proc/self/comm");
+				std::getline(comm, this->processName);
+				if (this->processName.empty())
+					this->processName = "pid";
+			}
+#endif
+			if (this->processName.size() >= SHM_LOG_NAME_SIZE)
+				this->processName.resize(SHM_LOG_NAME_SIZE - 1);
+			TryAttach();
+		}
+
+		~ShmLogProducer()
+		{
+#ifndef _WIN32
+			if (ShmLogHeader* h = header.load(std::memory_order_acquire))
+				::munmap(h, mappingSize);
+#endif
+		}
+
+		ShmLogProducer(const ShmLogProducer&) = delete;
+		ShmLogProducer& operator=(const ShmLogProducer&) = delete;
+
+		bool IsAttached() const { return header.load(std::memory_order_acquire) != nullptr; }
+
+		// Records dropped because GEAR's ring was full (all producers together)
+		uint64_t GetDroppedCount() const
+		{
+			ShmLogHeader* h = header.load(std::memory_order_acquire);
+			return h ? h->droppedRecords.load(std::memory_order_relaxed) : 0;
+		}
+
+		// Thread-safe. Returns false if the record was not stored (not attached or ring full).
+		bool Log(ShmLogLevel level, std::string_view text)
+		{
+			ShmLogHeader* h = header.load(std::memory_order_acquire);
+			if (!h && !(h = TryAttach()))
+				return false;
+
+			// Claim a slot
+			uint64_t position = h->writePosition.load(std::memory_order_relaxed);
+			ShmLogSlot* slot;
+			for (;;)
+			{
+				slot = ShmLogSlotAt(h, position);
+				const uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+				const int64_t diff = static_cast<int64_t>(sequence - position);
+				if (diff == 0)
+				{
+					if (h->writePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+						break;
+				}
+				else if (diff < 0)
+				{
+					h->droppedRecords.fetch_add(1, std::memory_order_relaxed);
+					return false;
+				}
+				else
+					position = h->writePosition.load(std::memory_order_relaxed);
+			}
+
+			// Fill and publish
+			const size_t textCapacity = h->slotSize - sizeof(ShmLogSlot);
+			const size_t textLength = std::min({ text.size(), textCapacity, size_t{ UINT16_MAX } });
+			slot->timestampNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::system_clock::now().time_since_epoch()).count();
+			slot->pid = pid;
+			slot->level = static_cast<uint8_t>(level);
+			slot->nameLength = static_cast<uint8_t>(processName.size());
+			std::memcpy(slot->processName, processName.data(), processName.size());
+			slot->textLength = static_cast<uint16_t>(textLength);
+			std::memcpy(slot->Text(), text.data(), textLength);
+
+			slot->sequence.store(position + 1, std::memory_order_release);
+			return true;
+		}
+
+	private:
+		ShmLogHeader* TryAttach()
+		{
+#ifdef _WIN32
+			return nullptr;
+#else
+			std::lock_guard lock(attachMutex);
+			if (ShmLogHeader* h = header.load(std::memory_order_acquire))
+				return h;
+
+			const auto now = std::chrono::steady_clock::now();
+			if (now < nextAttachTry)
+				return nullptr;
+			nextAttachTry = now + std::chrono::seconds(1);
+
+			const int fd = ::shm_open(shmName.c_str(), O_RDWR, 0);
+			if (fd < 0)
+				return nullptr;
+
+			struct stat st {};
+			void* mapping = MAP_FAILED;
+			if (::fstat(fd, &st) == 0 && static_cast<size_t>(st.st_size) >= SHM_LOG_SLOTS_OFFSET)
+				mapping = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+			::close(fd);
+			if (mapping == MAP_FAILED)
+				return nullptr;
+
+			// Only use rings GEAR has finished initializing
+			auto* h = static_cast<ShmLogHeader*>(mapping);
+			const bool valid = h->magic.load(std::memory_order_acquire) == SHM_LOG_MAGIC
+				&& h->version == SHM_LOG_VERSION
+				&& h->slotCount > 0 && (h->slotCount & (h->slotCount - 1)) == 0
+				&& h->slotSize > sizeof(ShmLogSlot)
+				&& ShmLogMappingSize(h->slotCount, h->slotSize) <= static_cast<size_t>(st.st_size);
+			if (!valid)
+			{
+				::munmap(mapping, static_cast<size_t>(st.st_size));
+				return nullptr;
+			}
+
+			mappingSize = static_cast<size_t>(st.st_size);
+			header.store(h, std::memory_order_release);
+			return h;
+#endif
+		}
+
+		std::string shmName;
+		std::string processName;
+		uint32_t pid = 0;
+
+		std::atomic<ShmLogHeader*> header{ nullptr };
+		size_t mappingSize = 0;
+		std::mutex attachMutex;
+		std::chrono::steady_clock::time_point nextAttachTry{};
+	};
+}
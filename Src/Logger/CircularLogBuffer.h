@@ -1,9 +1,16 @@
 #pragma once
 
+#include <algorithm>
 #include <vector>
 #include <mutex>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <thread>
 
 #include "LogMessage.h"
+#include "ColumnarLogStore.h"
 
 class CircularLogBuffer
 {
@@ -14,20 +21,185 @@ public:
 	}
 
 	// Thread-safe push: writes are synchronized via mutex.
-	// Supports concurrent pushes from multiple threads.
-	void Push(const LogMessage& message)
+	// Supports concurrent pushes from multiple threads. Returns the sequence assigned to the message.
+	uint64_t Push(const LogMessage& message)
 	{
 		std::lock_guard<std::mutex> lock(mutex);
 
-		buffer[writeIndex] = message;
+		LogMessage& slot = buffer[writeIndex];
+		slot = message;
+		slot.sequence = totalPushed.load(std::memory_order_relaxed);
+		totalPushed.store(slot.sequence + 1, std::memory_order_release);
+
 		writeIndex = (writeIndex + 1) % capacity;
 
 		if (size < capacity)
 			++size;
 		else
 			readIndex = (readIndex + 1) % capacity; // Overwrite oldest
+
+		return slot.sequence;
+	}
+
+	// Pushes 'count' messages under a single lock (e.g. a chunk of lines from a tailed file).
+	// Texts are swapped into the ring: each message gets the text buffer of the entry it overwrote, so
+	// producers that reuse their batch (socket ingestion) stay allocation-free. Level, timestamp and source
+	// of 'messages' are left unchanged. Returns the sequence of the first one, the others follow consecutively.
+	uint64_t PushBatch(LogMessage* messages, size_t count)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+
+		const uint64_t firstSequence = totalPushed.load(std::memory_order_relaxed);
+		uint64_t sequence = firstSequence;
+		for (size_t i = 0; i < count; ++i)
+		{
+			LogMessage& slot = buffer[writeIndex];
+			slot.level = messages[i].level;
+			slot.timestamp = messages[i].timestamp;
+			slot.sourceId = messages[i].sourceId;
+			slot.threadIndex = messages[i].threadIndex;
+			slot.objectId = messages[i].objectId;
+			slot.nameId = messages[i].nameId;
+			slot.callerId = messages[i].callerId;
+			slot.siteId = messages[i].siteId;
+			slot.fullLength = messages[i].fullLength;
+			slot.attachmentOffset = messages[i].attachmentOffset;
+			slot.location = messages[i].location;
+			slot.message.swap(messages[i].message);
+			slot.sequence = sequence++;
+
+			writeIndex = (writeIndex + 1) % capacity;
+
+			if (size < capacity)
+				++size;
+			else
+				readIndex = (readIndex + 1) % capacity; // Overwrite oldest
+		}
+		totalPushed.store(sequence, std::memory_order_release);
+		return firstSequence;
+	}
+
+	// Copies up to 'maxCount' entries with sequence >= 'firstSequence' into 'out' (appended, oldest first).
+	// Entries that were already overwritten are skipped, so the first copied sequence may be larger.
+	// The lock is only held for the copy of this chunk, so callers scanning large ranges should
+	// call this repeatedly with small chunks instead of copying everything at once.
+	size_t CopySince(uint64_t firstSequence, size_t maxCount, std::vector<LogMessage>& out) const
+	{
+		return ForEachSince(firstSequence, maxCount, [&out](const LogMessage& message) { out.push_back(message); });
+	}
+
+	// Same as above, but appends into a columnar snapshot. Texts are copied into the store's
+	// text heap, so no per-message allocation happens once the store has grown to its working size.
+	size_t CopySince(uint64_t firstSequence, size_t maxCount, ColumnarLogStore& out) const
+	{
+		return ForEachSince(firstSequence, maxCount, [&out](const LogMessage& message) { out.Append(message); });
+	}
+
+	// Changes the capacity while producers keep pushing. The newest min(GetSize(), newCapacity) entries are kept
+	// in order with their sequence numbers.
+	//
+	// BeginResize() starts a background thread that allocates the new storage and copies the entries into it in
+	// chunks (short lock per chunk, like CopySince()), then keeps following new ones. FinishResize() swaps it in once
+	// the copy has caught up: under the lock it only copies the entries pushed since the thread's last chunk and swaps
+	// the storage. If producers outran the copy, the thread catches up again instead. The old storage is freed on
+	// the background thread. Both must be called on the thread that reads GetBuffer() (the GUI thread).
+	// False if 'newCapacity' is 0 or the current capacity, or a resize is still running.
+	bool BeginResize(size_t newCapacity)
+	{
+		if (newCapacity == 0 || newCapacity == GetCapacity() || IsResizing())
+			return false;
+		if (resizeThread.joinable())
+			resizeThread.join(); // Done freeing the previous storage
+
+		resizeJob = std::make_unique<ResizeJob>();
+		resizeJob->capacity = newCapacity;
+		StartResizeThread();
+		return true;
+	}
+
+	// Polled once per frame: true when the new storage was swapped in
+	bool FinishResize()
+	{
+		if (!resizeJob || !resizeJob->caughtUp.load(std::memory_order_acquire))
+			return false;
+
+		resizeJob->stop.store(true, std::memory_order_release);
+		resizeThread.join();
+		ResizeJob& job = *resizeJob;
+
+		std::vector<LogMessage> retired;
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+
+			const uint64_t endSequence = totalPushed.load(std::memory_order_relaxed);
+			const uint64_t oldestSequence = endSequence - size;
+			const uint64_t start = std::max(oldestSequence, endSequence - std::min<uint64_t>(endSequence - oldestSequence, job.capacity));
+			if (job.first == UINT64_MAX)
+				job.next = start; // Nothing copied yet (few or no entries)
+			if (job.next < start || endSequence - job.next > MAX_LOCKED_COPY)
+			{
+				// Overwritten meanwhile, or too many new entries to copy while producers wait: catch up again
+				job.stop.store(false, std::memory_order_relaxed);
+				job.caughtUp.store(false, std::memory_order_relaxed);
+				StartResizeThread();
+				return false;
+			}
+
+			size_t index = (readIndex + static_cast<size_t>(job.next - oldestSequence)) % capacity;
+			for (uint64_t sequence = job.next; sequence < endSequence; ++sequence)
+			{
+				job.Store(buffer[index]);
+				index = (index + 1) % capacity;
+			}
+
+			// The last job.capacity entries (or fewer) form the new window
+			const uint64_t windowStart = job.first == UINT64_MAX ? endSequence : std::max(job.first, endSequence - std::min<uint64_t>(endSequence, job.capacity));
+			buffer.swap(job.storage);
+			retired.swap(job.storage);
+			capacity = job.capacity;
+			size = static_cast<size_t>(endSequence - windowStart);
+			readIndex = job.first == UINT64_MAX ? 0 : static_cast<size_t>((windowStart - job.first) % job.capacity);
+			writeIndex = (readIndex + size) % job.capacity;
+		}
+		resizeJob.reset();
+
+		// Freeing millions of entries takes too long for a frame
+		resizeFreeing.store(true, std::memory_order_relaxed);
+		resizeThread = std::thread([this, retired = std::move(retired)]() mutable
+			{
+				std::vector<LogMessage>().swap(retired);
+				resizeFreeing.store(false, std::memory_order_release);
+			});
+		return true;
 	}
 
+	// A resize is being prepared or its old storage is still being freed
+	bool IsResizing() const { return resizeJob != nullptr || resizeFreeing.load(std::memory_order_acquire); }
+
+	// Capacity a running resize changes to, GetCapacity() otherwise
+	size_t GetPendingCapacity() const { return resizeJob ? resizeJob->capacity : capacity; }
+
+	// Blocking resize (BeginResize() and waiting for FinishResize()), for tools and tests
+	void Resize(size_t newCapacity)
+	{
+		while (IsResizing() && !FinishResize())
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		if (!BeginResize(newCapacity))
+			return;
+		while (!FinishResize())
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+
+	~CircularLogBuffer()
+	{
+		if (resizeJob)
+			resizeJob->stop.store(true, std::memory_order_release);
+		if (resizeThread.joinable())
+			resizeThread.join();
+	}
+
+	size_t GetCapacity() const { return capacity; }
+
 	// -------- Read Accessors --------
 
 	// Returns const reference to the internal ring buffer.
@@ -35,14 +207,18 @@ public:
 	// Caller must use GetReadIndex() and GetSize() to iterate in correct order.
 	const std::vector<LogMessage>& GetBuffer() const { return buffer; }
 
-	// Thread-safe: readIndex is only written inside Push() under lock.
-	// Read-only here. On modern 64-bit systems, aligned size_t reads are atomic.
+	// readIndex and size are only written under the lock: by Push(), PushBatch() and the storage swap in
+	// FinishResize(), which runs on the reading thread itself. Read here without the lock; on modern 64-bit
+	// systems, aligned size_t reads are atomic.
 	size_t GetReadIndex() const { return readIndex; }
 
-	// Thread-safe: size is only written inside Push() under lock.
-	// Read-only access here is safe and avoids unnecessary locking in GUI thread.
+	// Written under the lock like readIndex; read without it, which avoids locking in the GUI thread.
 	size_t GetSize() const { return size; }
 
+	// Number of messages pushed since start. Equals the sequence number of the next message,
+	// so the oldest entry still in the buffer has sequence GetTotalPushed() - GetSize().
+	uint64_t GetTotalPushed() const { return totalPushed.load(std::memory_order_acquire); }
+
 private:
 	size_t capacity;
 	std::vector<LogMessage> buffer;
@@ -50,6 +226,85 @@ private:
 	size_t readIndex = 0;
 	size_t writeIndex = 0;
 	size_t size = 0;
+	std::atomic<uint64_t> totalPushed{ 0 };
+
+	mutable std::mutex mutex; // Protects the ring state against concurrent writes
+
+	static constexpr size_t RESIZE_CHUNK = 4096;        // Entries the resize thread copies per lock
+	static constexpr size_t RESIZE_DELTA = 1024;        // Entries behind at which the copy counts as caught up
+	static constexpr size_t MAX_LOCKED_COPY = 16384;    // Entries FinishResize() may copy while holding the lock
+
+	// New storage being filled by the resize thread. The entry with sequence 'first' is in slot 0.
+	struct ResizeJob
+	{
+		size_t capacity = 0;
+		std::vector<LogMessage> storage;
+		uint64_t first = UINT64_MAX; // First sequence of the contiguous range copied so far
+		uint64_t next = 0;           // Sequence after it
+		std::atomic<bool> caughtUp{ false };
+		std::atomic<bool> stop{ false };
 
-	mutable std::mutex mutex; // protects Push() against concurrent writes
+		void Store(const LogMessage& message)
+		{
+			if (first == UINT64_MAX || message.sequence != next)
+				first = message.sequence; // Start, or entries were overwritten before we got to them
+			storage[(message.sequence - first) % capacity] = message;
+			next = message.sequence + 1;
+		}
+	};
+
+	std::unique_ptr<ResizeJob> resizeJob; // Owned by the reading thread
+	std::thread resizeThread;             // Fills resizeJob, then frees the old storage
+	std::atomic<bool> resizeFreeing{ false };
+
+	// Copies into resizeJob until it is told to stop, reporting when it has caught up with the producers
+	void StartResizeThread()
+	{
+		resizeThread = std::thread([this, &job = *resizeJob]()
+			{
+				if (job.storage.size() != job.capacity)
+				{
+					job.storage.resize(job.capacity);
+					const uint64_t total = GetTotalPushed();
+					job.next = total - std::min<uint64_t>(total, std::min(GetSize(), job.capacity));
+				}
+
+				while (!job.stop.load(std::memory_order_acquire))
+				{
+					const uint64_t total = GetTotalPushed();
+					if (total - job.next > job.capacity)
+						job.next = total - job.capacity; // Older entries wouldn't fit anyway
+					if (total - job.next > RESIZE_DELTA && ForEachSince(job.next, RESIZE_CHUNK, [&job](const LogMessage& message) { job.Store(message); }) > 0)
+						continue;
+
+					job.caughtUp.store(true, std::memory_order_release);
+					std::this_thread::sleep_for(std::chrono::milliseconds(1));
+				}
+			});
+	}
+
+	template<typename Fn>
+	size_t ForEachSince(uint64_t firstSequence, size_t maxCount, Fn&& fn) const
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+
+		const uint64_t endSequence = totalPushed.load(std::memory_order_relaxed);
+		const uint64_t oldestSequence = endSequence - size;
+		if (firstSequence < oldestSequence)
+			firstSequence = oldestSequence;
+		if (firstSequence >= endSequence)
+			return 0;
+
+		size_t count = static_cast<size_t>(endSequence - firstSequence);
+		if (count > maxCount)
+			count = maxCount;
+
+		size_t index = (readIndex + static_cast<size_t>(firstSequence - oldestSequence)) % capacity;
+		for (size_t i = 0; i < count; ++i)
+		{
+			fn(buffer[index]);
+			index = (index + 1) % capacity;
+		}
+		return count;
+	}
 };
@@ -0,0 +1,201 @@
+#include "ColumnarLogStore.h"
+
+#include <bit>
+
+#if GEAR_ARCH_X86
+#include <immintrin.h>
+#endif
+
+namespace
+{
+	constexpr int MAX_LEVELS = 8; // Level values that fit into the mask checks below
+
+	// Writes base + index of every set bit to 'out' (if not null). Returns the number of bits.
+	inline size_t EmitBits(uint32_t bits, size_t base, uint32_t* out)
+	{
+		if (!out)
+			return static_cast<size_t>(std::popcount(bits));
+
+		size_t count = 0;
+		while (bits)
+		{
+			out[count++] = static_cast<uint32_t>(base + std::countr_zero(bits));
+			bits &= bits - 1;
+		}
+		return count;
+	}
+
+	size_t ScanScalar(const uint8_t* levels, const int64_t* timestamps, size_t begin, size_t end,
+		uint32_t levelMask, int64_t minNs, int64_t maxNs, uint32_t* out)
+	{
+		size_t count = 0;
+		for (size_t i = begin; i < end; ++i)
+		{
+			// Branchless: lets the compiler vectorize this loop on its own where possible
+			const bool hit = ((levelMask >> levels[i]) & 1u) != 0 && timestamps[i] >= minNs && timestamps[i] < maxNs;
+			if (out)
+				out[count] = static_cast<uint32_t>(i);
+			count += hit ? 1 : 0;
+		}
+		return count;
+	}
+
+#if GEAR_ARCH_X86
+	// SSE2: 16 levels per compare. There is no 64-bit compare before SSE4.2, so timestamps are
+	// only checked (scalar) for entries whose level matched.
+	GEAR_TARGET_SSE2
+	size_t ScanSse2(const uint8_t* levels, const int64_t* timestamps, size_t begin, size_t end,
+		uint32_t levelMask, int64_t minNs, int64_t maxNs, uint32_t* out)
+	{
+		size_t count = 0;
+		size_t i = begin;
+		for (; i + 16 <= end; i += 16)
+		{
+			const __m128i lv = _mm_loadu_si128(reinterpret_cast<const __m128i*>(levels + i));
+			__m128i levelOk = _mm_setzero_si128();
+			for (int level = 0; level < MAX_LEVELS; ++level)
+			{
+				if (levelMask & (1u << level))
+					levelOk = _mm_or_si128(levelOk, _mm_cmpeq_epi8(lv, _mm_set1_epi8(static_cast<char>(level))));
+			}
+
+			uint32_t bits = static_cast<uint32_t>(_mm_movemask_epi8(levelOk));
+			uint32_t timeBits = 0;
+			for (uint32_t b = bits; b; b &= b - 1)
+			{
+				const int lane = std::countr_zero(b);
+				const int64_t ts = timestamps[i + lane];
+				timeBits |= (ts >= minNs && ts < maxNs) ? (1u << lane) : 0u;
+			}
+			count += EmitBits(bits & timeBits, i, out ? out + count : nullptr);
+		}
+		return count + ScanScalar(levels, timestamps, i, end, levelMask, minNs, maxNs, out ? out + count : nullptr);
+	}
+
+	// SSE4.2: 16 entries per iteration, timestamps are compared two at a time with pcmpgtq
+	GEAR_TARGET_SSE42
+	size_t ScanSse42(const uint8_t* levels, const int64_t* timestamps, size_t begin, size_t end,
+		uint32_t levelMask, int64_t minNs, int64_t maxNs, uint32_t* out)
+	{
+		const __m128i minV = _mm_set1_epi64x(minNs);
+		const __m128i maxV = _mm_set1_epi64x(maxNs);
+
+		size_t count = 0;
+		size_t i = begin;
+		for (; i + 16 <= end; i += 16)
+		{
+			const __m128i lv = _mm_loadu_si128(reinterpret_cast<const __m128i*>(levels + i));
+			__m128i levelOk = _mm_setzero_si128();
+			for (int level = 0; level < MAX_LEVELS; ++level)
+			{
+				if (levelMask & (1u << level))
+					levelOk = _mm_or_si128(levelOk, _mm_cmpeq_epi8(lv, _mm_set1_epi8(static_cast<char>(level))));
+			}
+
+			const uint32_t levelBits = static_cast<uint32_t>(_mm_movemask_epi8(levelOk));
+			if (levelBits == 0)
+				continue; // No level match: skip loading 128 bytes of timestamps
+
+			uint32_t timeBits = 0;
+			for (int k = 0; k < 8; ++k)
+			{
+				const __m128i ts = _mm_loadu_si128(reinterpret_cast<const __m128i*>(timestamps + i + 2 * k));
+				// minNs <= ts < maxNs  <=>  !(minNs > ts) && (maxNs > ts)
+				const __m128i inRange = _mm_andnot_si128(_mm_cmpgt_epi64(minV, ts), _mm_cmpgt_epi64(maxV, ts));
+				timeBits |= static_cast<uint32_t>(_mm_movemask_pd(_mm_castsi128_pd(inRange))) << (2 * k);
+			}
+			count += EmitBits(levelBits & timeBits, i, out ? out + count : nullptr);
+		}
+		return count + ScanScalar(levels, timestamps, i, end, levelMask, minNs, maxNs, out ? out + count : nullptr);
+	}
+
+	// AVX2: 32 entries per iteration, timestamps are compared four at a time
+	GEAR_TARGET_AVX2
+	size_t ScanAvx2(const uint8_t* levels, const int64_t* timestamps, size_t begin, size_t end,
+		uint32_t levelMask, int64_t minNs, int64_t maxNs, uint32_t* out)
+	{
+		const __m256i minV = _mm256_set1_epi64x(minNs);
+		const __m256i maxV = _mm256_set1_epi64x(maxNs);
+
+		size_t count = 0;
+		size_t i = begin;
+		for (; i + 32 <= end; i += 32)
+		{
+			const __m256i lv = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(levels + i));
+			__m256i levelOk = _mm256_setzero_si256();
+			for (int level = 0; level < MAX_LEVELS; ++level)
+			{
+				if (levelMask & (1u << level))
+					levelOk = _mm256_or_si256(levelOk, _mm256_cmpeq_epi8(lv, _mm256_set1_epi8(static_cast<char>(level))));
+			}
+
+			const uint32_t levelBits = static_cast<uint32_t>(_mm256_movemask_epi8(levelOk));
+			if (levelBits == 0)
+				continue; // No level match: skip loading 256 bytes of timestamps
+
+			uint32_t timeBits = 0;
+			for (int k = 0; k < 8; ++k)
+			{
+				const __m256i ts = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(timestamps + i + 4 * k));
+				const __m256i inRange = _mm256_andnot_si256(_mm256_cmpgt_epi64(minV, ts), _mm256_cmpgt_epi64(maxV, ts));
+				timeBits |= static_cast<uint32_t>(_mm256_movemask_pd(_mm256_castsi256_pd(inRange))) << (4 * k);
+			}
+			count += EmitBits(levelBits & timeBits, i, out ? out + count : nullptr);
+		}
+		return count + ScanScalar(levels, timestamps, i, end, levelMask, minNs, maxNs, out ? out + count : nullptr);
+	}
+#endif
+
+	size_t Scan(gear::SimdLevel simd, const uint8_t* levels, const int64_t* timestamps, size_t begin, size_t end,
+		uint32_t levelMask, int64_t minNs, int64_t maxNs, uint32_t* out)
+	{
+#if GEAR_ARCH_X86
+		switch (gear::ClampSimdLevel(simd))
+		{
+		case gear::SimdLevel::Avx2:  return ScanAvx2(levels, timestamps, begin, end, levelMask, minNs, maxNs, out);
+		case gear::SimdLevel::Sse42: return ScanSse42(levels, timestamps, begin, end, levelMask, minNs, maxNs, out);
+		case gear::SimdLevel::Sse2:  return ScanSse2(levels, timestamps, begin, end, levelMask, minNs, maxNs, out);
+		default: break;
+		}
+#endif
+		return ScanScalar(levels, timestamps, begin, end, levelMask, minNs, maxNs, out);
+	}
+}
+
+LogMessage ColumnarLogStore::ToLogMessage(size_t index) const
+{
+	LogMessage message(Level(index), std::string(Text(index)));
+	message.timestamp = FromEpochNanoseconds(TimestampNs(index));
+	message.sequence = Sequence(index);
+	message.sourceId = SourceId(index);
+	message.threadIndex = ThreadIndex(index);
+	message.objectId = ObjectId(index);
+	message.location = prefixes[index].location;
+	message.nameId = prefixes[index].nameId;
+	message.callerId = prefixes[index].callerId;
+	message.siteId = prefixes[index].siteId;
+	message.fullLength = FullLength(index);
+	message.attachmentOffset = AttachmentOffset(index);
+	return message;
+}
+
+size_t ColumnarLogStore::ScanLevelTime(uint32_t levelMask, int64_t minNs, int64_t maxNs, std::vector<uint32_t>& outIndices,
+	size_t begin, size_t end, gear::SimdLevel simd) const
+{
+	if (end > Size())
+		end = Size();
+	if (begin >= end)
+		return 0;
+
+	// Reserve the worst case up front, the kernels write without bounds checks
+	const size_t oldSize = outIndices.size();
+	outIndices.resize(oldSize + (end - begin));
+	const size_t count = Scan(simd, levels.data(), timestamps.data(), begin, end, levelMask, minNs, maxNs, outIndices.data() + oldSize);
+	outIndices.resize(oldSize + count);
+	return count;
+}
+
+size_t ColumnarLogStore::CountLevelTime(uint32_t levelMask, int64_t minNs, int64_t maxNs, gear::SimdLevel simd) const
+{
+	return Scan(simd, levels.data(), timestamps.data(), 0, Size(), levelMask, minNs, maxNs, nullptr);
+}
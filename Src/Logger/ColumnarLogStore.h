@@ -0,0 +1,152 @@
+#pragma once
+
+#include <vector>
+#include <string_view>
+#include <cstdint>
+
+#include "LogMessage.h"
+#include "Platform/CpuFeatures.h"
+
+// Column-oriented (SoA) log store.
+//
+// Instead of an array of LogMessage (level + timestamp + std::string header per entry), every field
+// lives in its own tightly packed array: levels as bytes, timestamps as int64 nanoseconds and the texts
+// back to back in one heap addressed by offsets. Level/time filters then only touch 9 bytes per entry
+// and can be evaluated 16 or 32 entries at a time with SSE4.2 / AVX2 (scalar fallback elsewhere).
+//
+// The store is append-only; it is used for snapshots of the ring buffer (search worker) and can
+// be reused without reallocating via Clear().
+class ColumnarLogStore
+{
+public:
+	void Reserve(size_t entryCount, size_t textBytes)
+	{
+		levels.reserve(entryCount);
+		timestamps.reserve(entryCount);
+		sequences.reserve(entryCount);
+		sourceIds.reserve(entryCount);
+		threadIndices.reserve(entryCount);
+		objectIds.reserve(entryCount);
+		prefixes.reserve(entryCount);
+		fullLengths.reserve(entryCount);
+		attachmentOffsets.reserve(entryCount);
+		textOffsets.reserve(entryCount + 1);
+		textHeap.reserve(textBytes);
+	}
+
+	// Keeps the allocated memory for the next fill
+	void Clear()
+	{
+		levels.clear();
+		timestamps.clear();
+		sequences.clear();
+		sourceIds.clear();
+		threadIndices.clear();
+		objectIds.clear();
+		prefixes.clear();
+		fullLengths.clear();
+		attachmentOffsets.clear();
+		textOffsets.assign(1, 0);
+		textHeap.clear();
+	}
+
+	void Append(LogLevel level, int64_t timestampNs, std::string_view text, uint64_t sequence = 0, uint16_t sourceId = 0, uint32_t objectId = 0)
+	{
+		levels.push_back(static_cast<uint8_t>(level));
+		timestamps.push_back(timestampNs);
+		sequences.push_back(sequence);
+		sourceIds.push_back(sourceId);
+		threadIndices.push_back(0);
+		objectIds.push_back(objectId);
+		prefixes.push_back(Prefix{});
+		fullLengths.push_back(0);
+		attachmentOffsets.push_back(-1);
+		textHeap.insert(textHeap.end(), text.begin(), text.end());
+		textOffsets.push_back(textHeap.size());
+	}
+
+	void Append(const LogMessage& message)
+	{
+		Append(message.level, ToEpochNanoseconds(message.timestamp), message.message, message.sequence, message.sourceId, message.objectId);
+		threadIndices.back() = message.threadIndex;
+		fullLengths.back() = message.fullLength;
+		attachmentOffsets.back() = message.attachmentOffset;
+		if (message.location)
+			prefixes.back() = Prefix{ message.location, message.nameId, message.callerId, message.siteId };
+	}
+
+	size_t Size() const { return levels.size(); }
+	bool Empty() const { return levels.empty(); }
+
+	LogLevel Level(size_t index) const { return static_cast<LogLevel>(levels[index]); }
+	int64_t TimestampNs(size_t index) const { return timestamps[index]; }
+	uint64_t Sequence(size_t index) const { return sequences[index]; }
+	uint16_t SourceId(size_t index) const { return sourceIds[index]; }
+	uint16_t ThreadIndex(size_t index) const { return threadIndices[index]; } // LogThreads index
+	uint32_t FullLength(size_t index) const { return fullLengths[index]; } // Length before truncation, 0 = complete
+	int64_t AttachmentOffset(size_t index) const { return attachmentOffsets[index]; } // LogAttachments offset, -1 = none
+	uint32_t ObjectId(size_t index) const { return objectIds[index]; } // LogSymbols id of the object; name, caller and site ids are kept with the prefix (ToLogMessage())
+	std::string_view Text(size_t index) const
+	{
+		return std::string_view(textHeap.data() + textOffsets[index], static_cast<size_t>(textOffsets[index + 1] - textOffsets[index]));
+	}
+
+	// Text as shown (see LogMessage::GetText()): Text() itself, or with the prefix of a LOG_* call rendered into 'scratch'
+	std::string_view DisplayText(size_t index, fmt::memory_buffer& scratch) const
+	{
+		const Prefix& prefix = prefixes[index];
+		if (!prefix.location)
+			return Text(index);
+		scratch.clear();
+		AppendLogPrefix(scratch, prefix.location, objectIds[index], prefix.nameId, prefix.callerId);
+		const std::string_view text = Text(index);
+		scratch.append(text.data(), text.data() + text.size());
+		return std::string_view(scratch.data(), scratch.size());
+	}
+
+	// Reconstructs a full LogMessage (allocates the message string)
+	LogMessage ToLogMessage(size_t index) const;
+
+	// Raw columns, e.g. for custom scans
+	const std::vector<uint8_t>& Levels() const { return levels; }
+	const std::vector<int64_t>& Timestamps() const { return timestamps; }
+
+	// Appends the indices of all entries in [begin, end) whose level bit is set in 'levelMask'
+	// (see LevelBit()) and whose timestamp is in [minNs, maxNs). Returns the number of matches.
+	// 'simd' selects the kernel, it is clamped to what the CPU supports (default: best available).
+	size_t ScanLevelTime(uint32_t levelMask, int64_t minNs, int64_t maxNs, std::vector<uint32_t>& outIndices,
+		size_t begin = 0, size_t end = SIZE_MAX, gear::SimdLevel simd = gear::SimdLevel::Avx2) const;
+
+	// Same as ScanLevelTime(), but only counts
+	size_t CountLevelTime(uint32_t levelMask, int64_t minNs, int64_t maxNs, gear::SimdLevel simd = gear::SimdLevel::Avx2) const;
+
+	// Approximate heap usage of all columns
+	size_t MemoryBytes() const
+	{
+		return levels.capacity() * sizeof(uint8_t) + timestamps.capacity() * sizeof(int64_t)
+			+ sequences.capacity() * sizeof(uint64_t) + sourceIds.capacity() * sizeof(uint16_t) + threadIndices.capacity() * sizeof(uint16_t) + objectIds.capacity() * sizeof(uint32_t) + prefixes.capacity() * sizeof(Prefix)
+			+ fullLengths.capacity() * sizeof(uint32_t) + attachmentOffsets.capacity() * sizeof(int64_t) + textOffsets.capacity() * sizeof(uint64_t) + textHeap.capacity();
+	}
+
+private:
+	std::vector<uint8_t> levels;
+	std::vector<int64_t> timestamps;
+	std::vector<uint64_t> sequences;
+	std::vector<uint16_t> sourceIds;
+	std::vector<uint16_t> threadIndices;
+	std::vector<uint32_t> objectIds;
+
+	// Call site and the other prefix ids of LOG_* messages, only read for matches and text filters
+	struct Prefix
+	{
+		const LogLocation* location = nullptr;
+		uint32_t nameId = 0;
+		uint32_t callerId = 0;
+		uint32_t siteId = 0;
+	};
+	std::vector<Prefix> prefixes;
+	std::vector<uint32_t> fullLengths;      // Truncated messages (LogMessage::fullLength)
+	std::vector<int64_t> attachmentOffsets; // Their full text in the attachments file
+	std::vector<uint64_t> textOffsets{ 0 }; // Size()+1 entries, text i is [offsets[i], offsets[i+1])
+	std::vector<char> textHeap;
+};
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <algorithm>
+#include <cstdint>
+
+// HDR-style log-linear histogram for latencies in nanoseconds.
+//
+// Values below 8 get their own bucket, above that every power of two is split into 8 linear
+// sub-buckets, so any recorded value is off by at most 12.5%. 304 buckets cover 1 ns .. ~18 min
+// (larger values are clamped into the last bucket). Plain counters, not thread-safe; concurrent
+// recording goes through LoggerMetrics, which merges its per-thread slots into one of these.
+class LatencyHistogram
+{
+public:
+	static constexpr int SUB_BUCKET_BITS = 3;
+	static constexpr uint64_t SUB_BUCKETS = 1ull << SUB_BUCKET_BITS;
+	static constexpr int MAX_EXPONENT = 40; // Values >= 2^40 ns land in the last bucket
+	static constexpr size_t BUCKET_COUNT = (MAX_EXPONENT - SUB_BUCKET_BITS + 1) * SUB_BUCKETS;
+
+	static constexpr size_t BucketIndex(uint64_t value)
+	{
+		if (value < SUB_BUCKETS)
+			return static_cast<size_t>(value);
+
+		const int exponent = std::bit_width(value) - 1;
+		if (exponent >= MAX_EXPONENT)
+			return BUCKET_COUNT - 1;
+
+		const uint64_t subBucket = (value >> (exponent - SUB_BUCKET_BITS)) & (SUB_BUCKETS - 1);
+		return static_cast<size_t>((exponent - SUB_BUCKET_BITS + 1) * SUB_BUCKETS + subBucket);
+	}
+
+	// Smallest value that maps to 'index'
+	static constexpr uint64_t BucketLowerBound(size_t index)
+	{
+		if (index < SUB_BUCKETS)
+			return index;
+
+		const int exponent = static_cast<int>(index / SUB_BUCKETS) + SUB_BUCKET_BITS - 1;
+		const uint64_t subBucket = index % SUB_BUCKETS;
+		return (SUB_BUCKETS + subBucket) << (exponent - SUB_BUCKET_BITS);
+	}
+
+	// Largest value that maps to 'index'
+	static constexpr uint64_t BucketUpperBound(size_t index)
+	{
+		return index + 1 < BUCKET_COUNT ? BucketLowerBound(index + 1) - 1 : UINT64_MAX;
+	}
+
+	void Record(uint64_t value)
+	{
+		++counts[BucketIndex(value)];
+		++count;
+		sum += value;
+		maxValue = std::max(maxValue, value);
+	}
+
+	void AddBucket(size_t index, uint64_t bucketCount) { counts[index] += bucketCount; }
+	void AddTotals(uint64_t addCount, uint64_t addSum, uint64_t addMax)
+	{
+		count += addCount;
+		sum += addSum;
+		maxValue = std::max(maxValue, addMax);
+	}
+
+	void Merge(const LatencyHistogram& other)
+	{
+		for (size_t i = 0; i < BUCKET_COUNT; ++i)
+			counts[i] += other.counts[i];
+		AddTotals(other.count, other.sum, other.maxValue);
+	}
+
+	void Clear() { *this = LatencyHistogram(); }
+
+	uint64_t GetCount() const { return count; }
+	uint64_t GetMax() const { return maxValue; }
+	double GetMean() const { return count ? static_cast<double>(sum) / static_cast<double>(count) : 0.0; }
+	const std::array<uint64_t, BUCKET_COUNT>& GetBuckets() const { return counts; }
+
+	// Value at the given percentile (0..100), reported as the upper bound of its bucket (capped at the max)
+	uint64_t GetPercentile(double percentile) const
+	{
+		uint64_t bucketTotal = 0;
+		for (uint64_t c : counts)
+			bucketTotal += c;
+		if (bucketTotal == 0)
+			return 0;
+
+		const double clamped = std::clamp(percentile, 0.0, 100.0);
+		const uint64_t rank = std::max<uint64_t>(1, static_cast<uint64_t>(clamped / 100.0 * static_cast<double>(bucketTotal) + 0.5));
+
+		uint64_t seen = 0;
+		for (size_t i = 0; i < BUCKET_COUNT; ++i)
+		{
+			seen += counts[i];
+			if (seen >= rank)
+				return std::min(BucketUpperBound(i), maxValue);
+		}
+		return maxValue;
+	}
+
+private:
+	std::array<uint64_t, BUCKET_COUNT> counts{};
+	uint64_t count = 0;
+	uint64_t sum = 0;
+	uint64_t maxValue = 0;
+};
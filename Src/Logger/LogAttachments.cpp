@@ -0,0 +1,138 @@
+#include "LogAttachments.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <fstream>
+#include <system_error>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+bool LogAttachments::Open(const std::filesystem::path& filePath, std::string* error)
+{
+	std::lock_guard lock(mutex);
+	if (fd >= 0)
+		return true;
+	path = filePath;
+
+	std::error_code ec;
+	if (path.has_parent_path())
+		std::filesystem::create_directories(path.parent_path(), ec);
+
+	// Not O_APPEND: payloads are written at their reserved offsets, in any order
+#ifdef _WIN32
+	fd = _wopen(path.c_str(), _O_WRONLY | _O_CREAT | _O_BINARY | _O_NOINHERIT, _S_IREAD | _S_IWRITE);
+#else
+	do
+		fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_CLOEXEC, 0644);
+	while (fd < 0 && errno == EINTR);
+#endif
+	if (fd < 0)
+	{
+		if (error)
+			*error = "open failed for " + path.string() + ": " + std::strerror(errno);
+		return false;
+	}
+
+	const auto existing = std::filesystem::file_size(path, ec);
+	size.store(ec ? 0 : static_cast<uint64_t>(existing), std::memory_order_relaxed);
+	open.store(true, std::memory_order_release);
+	return true;
+}
+
+void LogAttachments::Close()
+{
+	std::lock_guard lock(mutex);
+	open.store(false, std::memory_order_release);
+	if (fd < 0)
+		return;
+#ifdef _WIN32
+	_close(fd);
+#else
+	::close(fd);
+#endif
+	fd = -1;
+}
+
+int64_t LogAttachments::Reserve(size_t length)
+{
+	if (!IsOpen())
+		return -1;
+
+	uint64_t offset = size.load(std::memory_order_relaxed);
+	do
+	{
+		if (offset + length + 1 > MAX_FILE_SIZE)
+			return -1;
+	} while (!size.compare_exchange_weak(offset, offset + length + 1, std::memory_order_relaxed));
+	return static_cast<int64_t>(offset);
+}
+
+bool LogAttachments::WriteAt(uint64_t offset, std::string_view payload)
+{
+	std::lock_guard lock(mutex);
+	if (fd < 0)
+		return false;
+
+	// The payload, then its '\n', retrying short writes and interrupts
+	std::string_view parts[] = { payload, "\n" };
+	for (std::string_view part : parts)
+	{
+#ifdef _WIN32
+		if (_lseeki64(fd, static_cast<__int64>(offset), SEEK_SET) < 0)
+			return false;
+		while (!part.empty())
+		{
+			const int written = _write(fd, part.data(), static_cast<unsigned int>(std::min<size_t>(part.size(), 1u << 30)));
+			if (written < 0)
+				return false;
+			part.remove_prefix(static_cast<size_t>(written));
+			offset += static_cast<uint64_t>(written);
+		}
+#else
+		while (!part.empty())
+		{
+			const ssize_t written = ::pwrite(fd, part.data(), part.size(), static_cast<off_t>(offset));
+			if (written < 0)
+			{
+				if (errno == EINTR)
+					continue;
+				return false;
+			}
+			part.remove_prefix(static_cast<size_t>(written));
+			offset += static_cast<uint64_t>(written);
+		}
+#endif
+	}
+	return true;
+}
+
+bool LogAttachments::Read(const std::filesystem::path& filePath, int64_t offset, size_t length, std::string& out, std::string* error)
+{
+	std::ifstream in(filePath, std::ios::binary);
+	if (!in || offset < 0)
+	{
+		if (error)
+			*error = "Cannot open '" + filePath.string() + "'";
+		return false;
+	}
+
+	out.resize(length);
+	in.seekg(offset);
+	in.read(out.data(), static_cast<std::streamsize>(length));
+	if (in.gcount() != static_cast<std::streamsize>(length))
+	{
+		out.clear();
+		if (error)
+			*error = "'" + filePath.string() + "' has no attachment of " + std::to_string(length) + " bytes at offset " + std::to_string(offset);
+		return false;
+	}
+	return true;
+}
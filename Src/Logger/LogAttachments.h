@@ -0,0 +1,55 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+// Side file for the full text of messages cut at Logger::SetMaxMessageLength() ("Gear.attachments" next to
+// Gear.log). Payloads are stored one after another, each followed by '\n'; the truncated message keeps the
+// byte offset (LogMessage::attachmentOffset) and its length (LogMessage::fullLength), so the ring, the file
+// queue and the GUI only ever carry the short version.
+//
+// The producer only reserves the range (Reserve(), one atomic add); the LogToFile writer thread writes the
+// payload there later (WriteAt(), positional write), so the producer never waits for the disk. Ranges of
+// payloads that could not be written stay as holes. The file is not rotated: once it reaches MAX_FILE_SIZE
+// further payloads are dropped (truncated only).
+class LogAttachments
+{
+public:
+	static constexpr uint64_t MAX_FILE_SIZE = 256ull * 1024 * 1024;
+
+	LogAttachments() = default;
+	~LogAttachments() { Close(); }
+
+	LogAttachments(const LogAttachments&) = delete;
+	LogAttachments& operator=(const LogAttachments&) = delete;
+
+	// Opens (creates) 'path' for writing; offsets continue behind data of earlier runs
+	bool Open(const std::filesystem::path& path, std::string* error = nullptr);
+	void Close();
+	bool IsOpen() const { return open.load(std::memory_order_acquire); }
+
+	// Reserves room for a payload of 'length' bytes and its '\n'. Returns its offset, -1 if the file is not
+	// open or full. Lock-free, called by producers.
+	int64_t Reserve(size_t length);
+
+	// Writes 'payload' and its '\n' at a reserved 'offset'. Called by the writer thread.
+	bool WriteAt(uint64_t offset, std::string_view payload);
+
+	// Reads 'length' bytes at 'offset' of an attachments file
+	static bool Read(const std::filesystem::path& path, int64_t offset, size_t length, std::string& out, std::string* error = nullptr);
+
+	// Bytes reserved so far (written or still queued)
+	uint64_t GetSize() const { return size.load(std::memory_order_relaxed); }
+	const std::filesystem::path& GetPath() const { return path; }
+
+private:
+	mutable std::mutex mutex; // Open/Close against WriteAt, never taken by producers
+	int fd = -1;
+	std::filesystem::path path;
+	std::atomic<bool> open{ false };
+	std::atomic<uint64_t> size{ 0 };
+};
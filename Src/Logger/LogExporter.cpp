@@ -0,0 +1,297 @@
+#include "LogExporter.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <optional>
+#include <vector>
+#include <fmt/format.h>
+
+#include "LogQuery.h"
+#include "LogSources.h"
+#include "LogThreads.h"
+#include "Ipc/LogDatagram.h"
+#include "Utils/JsonString.h"
+
+namespace
+{
+	// Formats rows into a buffer that is written to 'out' every OUTPUT_CHUNK bytes
+	class RowWriter
+	{
+	public:
+		RowWriter(std::ofstream& out, LogExporter::Format format)
+			: out(out), format(format)
+		{
+			if (format == LogExporter::Format::Binary)
+				datagram.reset(new char[gear::LOG_DATAGRAM_MAX_SIZE]);
+		}
+
+		// 'rawLine': the file line of a history row that is not in the file format (written as is in text format)
+		void Add(const LogMessage& message, std::string_view rawLine = {})
+		{
+			char time[80];
+			switch (format)
+			{
+			case LogExporter::Format::Text:
+				if (!rawLine.empty())
+				{
+					buffer.append(rawLine);
+					buffer.push_back('\n');
+					break;
+				}
+				message.FormatTimestamp(time, sizeof(time));
+				fmt::format_to(std::back_inserter(buffer), "[{}] {} ", message.FormatLevel(), time);
+				message.AppendText(buffer);
+				buffer.push_back('\n');
+				break;
+
+			case LogExporter::Format::JsonLines:
+				message.FormatTimestamp(time, sizeof(time));
+				fmt::format_to(std::back_inserter(buffer), "{{\"time\":\"{}\",\"ns\":{},\"level\":\"{}\",\"seq\":{},\"source\":",
+					std::string_view(time + 1, std::strlen(time) - 2), ToEpochNanoseconds(message.timestamp), message.FormatLevel(), message.sequence);
+				gear::AppendJsonString(buffer, LogSources::GetName(message.sourceId));
+				if (message.threadIndex != LogThreads::NONE)
+				{
+					buffer.append(std::string_view(",\"thread\":"));
+					gear::AppendJsonString(buffer, LogThreads::GetName(message.threadIndex));
+				}
+				buffer.append(std::string_view(",\"message\":"));
+				gear::AppendJsonString(buffer, message.GetText(scratch));
+				buffer.append(std::string_view("}\n"));
+				break;
+
+			case LogExporter::Format::Binary:
+				AddRecord(message);
+				break;
+			}
+
+			if (buffer.size() >= LogExporter::OUTPUT_CHUNK)
+				Flush();
+		}
+
+		bool Finish()
+		{
+			if (packet && packet->GetRecordCount() > 0)
+				buffer.append(std::string_view(packet->Data(), packet->Size()));
+			packet.reset();
+			Flush();
+			return static_cast<bool>(out);
+		}
+
+	private:
+		// Records are collected in a datagram, which goes to the buffer once it is full
+		void AddRecord(const LogMessage& message)
+		{
+			constexpr size_t MAX_TEXT = gear::LOG_DATAGRAM_MAX_SIZE - gear::LOG_DATAGRAM_HEADER_SIZE - gear::LOG_DATAGRAM_RECORD_HEADER_SIZE;
+			const std::string_view fullText = message.GetText(scratch);
+			const std::string_view text = fullText.substr(0, MAX_TEXT);
+			const auto level = static_cast<gear::ShmLogLevel>(message.level);
+			const int64_t ns = ToEpochNanoseconds(message.timestamp);
+
+			if (!packet)
+				packet.emplace(datagram.get(), gear::LOG_DATAGRAM_MAX_SIZE, 0, "GEAR");
+			if (!packet->Add(level, text, ns))
+			{
+				buffer.append(std::string_view(packet->Data(), packet->Size()));
+				packet.emplace(datagram.get(), gear::LOG_DATAGRAM_MAX_SIZE, 0, "GEAR");
+				packet->Add(level, text, ns);
+			}
+		}
+
+		void Flush()
+		{
+			out.write(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+			buffer.clear();
+		}
+
+		std::ofstream& out;
+		LogExporter::Format format;
+		fmt::memory_buffer scratch; // Message texts with their rendered prefix
+		fmt::memory_buffer buffer;
+		std::unique_ptr<char[]> datagram;
+		std::optional<gear::LogDatagramWriter> packet;
+	};
+}
+
+LogExporter::LogExporter(const CircularLogBuffer& source)
+	: source(source)
+{
+	workerThread = std::thread(&LogExporter::Run, this);
+}
+
+LogExporter::~LogExporter()
+{
+	{
+		std::lock_guard lock(jobMutex);
+		stopFlag = true;
+	}
+	generation.fetch_add(1, std::memory_order_acq_rel); // aborts a running export
+	jobCv.notify_all();
+
+	if (workerThread.joinable())
+		workerThread.join();
+}
+
+void LogExporter::Start(Job job)
+{
+	{
+		std::lock_guard lock(jobMutex);
+		pendingJob = std::move(job);
+		hasPendingJob = true;
+		generation.fetch_add(1, std::memory_order_acq_rel);
+		busy.store(true, std::memory_order_relaxed);
+		progress.store(0.0f, std::memory_order_relaxed);
+	}
+	jobCv.notify_one();
+}
+
+void LogExporter::Cancel()
+{
+	{
+		std::lock_guard lock(jobMutex);
+		hasPendingJob = false;
+		pendingJob = Job{};
+		generation.fetch_add(1, std::memory_order_acq_rel);
+		busy.store(false, std::memory_order_relaxed);
+		progress.store(1.0f, std::memory_order_relaxed);
+	}
+	jobCv.notify_one();
+}
+
+LogExporter::Result LogExporter::GetResult() const
+{
+	std::lock_guard lock(jobMutex);
+	return lastResult;
+}
+
+const char* LogExporter::GetExtension(Format format)
+{
+	switch (format)
+	{
+	case Format::JsonLines: return ".jsonl";
+	case Format::Binary:    return ".gldg";
+	default:                return ".log";
+	}
+}
+
+void LogExporter::Run()
+{
+	while (true)
+	{
+		Job job;
+		uint64_t jobGeneration;
+		{
+			std::unique_lock lock(jobMutex);
+			jobCv.wait(lock, [this]() { return stopFlag || hasPendingJob; });
+			if (stopFlag)
+				return;
+			job = std::move(pendingJob);
+			pendingJob = Job{};
+			hasPendingJob = false;
+			jobGeneration = generation.load(std::memory_order_acquire);
+		}
+
+		Result result;
+		result.path = job.path;
+		const bool finished = Export(job, jobGeneration, result);
+
+		std::lock_guard lock(jobMutex);
+		if (finished && !IsCancelled(jobGeneration))
+		{
+			lastResult = std::move(result);
+			busy.store(false, std::memory_order_relaxed);
+			progress.store(1.0f, std::memory_order_relaxed);
+		}
+	}
+}
+
+bool LogExporter::Export(const Job& job, uint64_t jobGeneration, Result& result)
+{
+	const LogQuery query = LogQuery::Parse(job.query);
+	if (!query.error.empty())
+	{
+		result.error = query.error;
+		return true;
+	}
+
+	std::error_code ec;
+	if (job.path.has_parent_path())
+		std::filesystem::create_directories(job.path.parent_path(), ec);
+	std::ofstream out(job.path, std::ios::binary | std::ios::trunc);
+	if (!out)
+	{
+		result.error = "Cannot open '" + job.path.string() + "' for writing";
+		return true;
+	}
+
+	const size_t historyRows = job.history ? std::min(job.historyEnd, job.history->GetLineCount()) - std::min(job.historyBegin, job.historyEnd) : 0;
+	const uint64_t ringRows = job.ringEnd > job.ringBegin ? job.ringEnd - job.ringBegin : 0;
+	const double totalRows = std::max<double>(1.0, static_cast<double>(historyRows + ringRows));
+	uint64_t processed = 0;
+
+	RowWriter writer(out, job.format);
+	bool cancelled = false;
+
+	// History rows, parsed from the mapped files one at a time
+	LogMessage row;
+	for (size_t i = job.historyBegin; i < job.historyBegin + historyRows && !cancelled; ++i)
+	{
+		const bool parsed = job.history->GetRow(i, row);
+		if (query.Matches(row))
+		{
+			writer.Add(row, parsed ? std::string_view() : job.history->GetLine(i));
+			++result.rowsWritten;
+		}
+
+		if (++processed % EXPORT_CHUNK == 0)
+		{
+			progress.store(static_cast<float>(processed / totalRows), std::memory_order_relaxed);
+			cancelled = IsCancelled(jobGeneration);
+		}
+	}
+
+	// Ring entries, copied in chunks (short lock per chunk)
+	std::vector<LogMessage> chunk;
+	chunk.reserve(EXPORT_CHUNK);
+	uint64_t next = job.ringBegin;
+	while (next < job.ringEnd && !cancelled)
+	{
+		chunk.clear();
+		if (source.CopySince(next, std::min<uint64_t>(EXPORT_CHUNK, job.ringEnd - next), chunk) == 0)
+			break;
+
+		for (const LogMessage& message : chunk)
+		{
+			if (message.sequence >= job.ringEnd)
+				break;
+			if (query.Matches(message))
+			{
+				writer.Add(message);
+				++result.rowsWritten;
+			}
+		}
+
+		// Entries before the first copied one were overwritten in the meantime
+		const uint64_t copiedEnd = std::min(chunk.back().sequence + 1, job.ringEnd);
+		result.rowsSkipped += chunk.front().sequence - next;
+		processed += copiedEnd - next;
+		next = copiedEnd;
+
+		progress.store(static_cast<float>(processed / totalRows), std::memory_order_relaxed);
+		cancelled = IsCancelled(jobGeneration);
+	}
+	if (next < job.ringEnd && !cancelled)
+		result.rowsSkipped += job.ringEnd - next;
+
+	const bool written = writer.Finish();
+	out.close();
+	if (cancelled)
+	{
+		std::filesystem::remove(job.path, ec);
+		return false;
+	}
+	if (!written || !out)
+		result.error = "Writing '" + job.path.string() + "' failed";
+	return true;
+}
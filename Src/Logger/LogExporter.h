@@ -0,0 +1,102 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "LogMessage.h"
+#include "LogHistory.h"
+#include "CircularLogBuffer.h"
+
+// Writes rows of the Logger window to a file on a background thread, so exporting millions of lines never
+// blocks the frame loop.
+//
+// A job names its rows instead of copying them: a row range of a LogHistory snapshot (mapped files, parsed
+// row by row) followed by a sequence range of the ring, which is copied in chunks of EXPORT_CHUNK under the
+// ring lock like LogSearchWorker does. An optional query (LogQuery syntax) filters both. Output is formatted
+// into a buffer that is written out every OUTPUT_CHUNK bytes, so memory stays bounded whatever the number of
+// rows. Ring entries that were overwritten before the worker got to them are skipped and counted.
+//
+// Formats: Text (the Gear.log line format, so the file can be opened as history or tailed), JSON lines and
+// Binary (a sequence of LogDatagram packets, see Ipc/LogDatagram.h; longer texts are cut to fit a packet).
+class LogExporter
+{
+public:
+	static constexpr size_t EXPORT_CHUNK = 4096;
+	static constexpr size_t OUTPUT_CHUNK = 1024 * 1024;
+
+	enum class Format
+	{
+		Text,
+		JsonLines,
+		Binary
+	};
+
+	struct Job
+	{
+		std::filesystem::path path;
+		Format format = Format::Text;
+		std::string query;                                   // Empty = all rows
+		std::shared_ptr<const LogHistory::Snapshot> history; // May be null
+		size_t historyBegin = 0;                             // Rows [historyBegin, historyEnd) of 'history'
+		size_t historyEnd = 0;
+		uint64_t ringBegin = 0;                              // Sequences [ringBegin, ringEnd) of the ring
+		uint64_t ringEnd = 0;
+	};
+
+	// Outcome of the last finished (or failed) job
+	struct Result
+	{
+		std::filesystem::path path;
+		uint64_t rowsWritten = 0;
+		uint64_t rowsSkipped = 0; // Overwritten in the ring before they were exported
+		std::string error;        // Empty on success
+	};
+
+	explicit LogExporter(const CircularLogBuffer& source);
+	~LogExporter();
+
+	LogExporter(const LogExporter&) = delete;
+	LogExporter& operator=(const LogExporter&) = delete;
+
+	// Starts 'job', cancelling a running one
+	void Start(Job job);
+
+	// Stops the running job; its partial file is removed
+	void Cancel();
+
+	bool IsBusy() const { return busy.load(std::memory_order_relaxed); }
+	float GetProgress() const { return progress.load(std::memory_order_relaxed); }
+
+	// Result of the last job that ran to its end, empty 'path' before that
+	Result GetResult() const;
+
+	static const char* GetExtension(Format format);
+
+private:
+	void Run();
+	bool IsCancelled(uint64_t jobGeneration) const { return generation.load(std::memory_order_acquire) != jobGeneration; }
+	// Returns false if the job was cancelled (the result is not published then)
+	bool Export(const Job& job, uint64_t jobGeneration, Result& result);
+
+	const CircularLogBuffer& source;
+
+	// Job state, protected by jobMutex
+	mutable std::mutex jobMutex;
+	std::condition_variable jobCv;
+	Job pendingJob;
+	bool hasPendingJob = false;
+	bool stopFlag = false;
+	Result lastResult;
+
+	std::atomic<uint64_t> generation{ 0 };
+	std::atomic<float> progress{ 1.0f };
+	std::atomic<bool> busy{ false };
+
+	std::thread workerThread;
+};
@@ -0,0 +1,136 @@
+#include "LogFileIndex.h"
+
+#include <algorithm>
+#include <system_error>
+
+namespace
+{
+	struct IndexHeader
+	{
+		uint32_t magic = LogFileIndex::MAGIC;
+		uint32_t version = LogFileIndex::VERSION;
+	};
+	static_assert(sizeof(IndexHeader) == LogFileIndex::HEADER_SIZE);
+}
+
+// -------- LogFileIndex --------
+
+bool LogFileIndex::Load(const std::filesystem::path& logFile, std::string* error)
+{
+	records.clear();
+
+	const auto path = PathFor(logFile);
+	std::ifstream in(path, std::ios::binary);
+	if (!in)
+	{
+		if (error)
+			*error = "No index file " + path.string();
+		return false;
+	}
+
+	IndexHeader header;
+	if (!in.read(reinterpret_cast<char*>(&header), sizeof(header)) || header.magic != MAGIC || header.version != VERSION)
+	{
+		if (error)
+			*error = "Invalid index file " + path.string();
+		return false;
+	}
+
+	LogIndexRecord record;
+	while (in.read(reinterpret_cast<char*>(&record), sizeof(record)))
+		records.push_back(record);
+	return true;
+}
+
+void LogFileIndex::FindRange(int64_t timeNs, uint64_t& begin, uint64_t& end) const
+{
+	// First record at or after the time; the line we look for is at or before its offset
+	const auto after = std::lower_bound(records.begin(), records.end(), timeNs,
+		[](const LogIndexRecord& record, int64_t time) { return record.timestampNs < time; });
+
+	begin = (after == records.begin()) ? 0 : std::prev(after)->offset;
+	end = (after == records.end()) ? UINT64_MAX : after->offset;
+}
+
+// -------- LogFileIndexWriter --------
+
+void LogFileIndexWriter::Open(const std::filesystem::path& logFile, uint64_t fileSize, size_t intervalBytes)
+{
+	Close();
+	interval = intervalBytes;
+	levelCounts = {};
+	nextCheckpoint = 0;
+	if (interval == 0)
+		return;
+
+	// Continue an index that ends exactly where the log file ends (closed cleanly by the last run)
+	LogFileIndex existing;
+	bool resume = false;
+	if (fileSize > 0 && existing.Load(logFile) && existing.IsComplete() && existing.GetRecords().back().offset == fileSize)
+	{
+		const LogIndexRecord& last = existing.GetRecords().back();
+		levelCounts = last.levelCounts;
+		lastTimestampNs = last.timestampNs;
+		resume = true;
+	}
+
+	const auto path = LogFileIndex::PathFor(logFile);
+	if (resume)
+	{
+		// Drop the closing record, it will be written again when this segment is closed
+		std::error_code ec;
+		std::filesystem::resize_file(path, LogFileIndex::HEADER_SIZE + (existing.GetRecords().size() - 1) * sizeof(LogIndexRecord), ec);
+		if (ec)
+			resume = false;
+	}
+
+	stream.open(path, resume ? (std::ios::binary | std::ios::app) : (std::ios::binary | std::ios::trunc));
+	if (!resume && stream)
+	{
+		// Lines already in the file (e.g. from a run without index) are not covered; the first
+		// checkpoint is at the current end of the file
+		const IndexHeader header;
+		stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+		stream.flush();
+	}
+	nextCheckpoint = fileSize;
+}
+
+void LogFileIndexWriter::OnLine(LogLevel level, int64_t timestampNs, uint64_t offset)
+{
+	if (!stream.is_open())
+		return;
+
+	if (offset >= nextCheckpoint)
+	{
+		WriteRecord(timestampNs, offset, 0);
+		stream.flush(); // Make checkpoints visible to readers (history browser) right away
+		nextCheckpoint = offset + interval;
+	}
+
+	++levelCounts[static_cast<size_t>(level) % LOG_LEVEL_COUNT];
+	lastTimestampNs = timestampNs;
+}
+
+void LogFileIndexWriter::Finish(uint64_t fileSize)
+{
+	if (stream.is_open())
+		WriteRecord(lastTimestampNs, fileSize, LogIndexRecord::FLAG_END);
+	Close();
+}
+
+void LogFileIndexWriter::Close()
+{
+	if (stream.is_open())
+		stream.close();
+}
+
+void LogFileIndexWriter::WriteRecord(int64_t timestampNs, uint64_t offset, uint32_t flags)
+{
+	LogIndexRecord record;
+	record.timestampNs = timestampNs;
+	record.offset = offset;
+	record.levelCounts = levelCounts;
+	record.flags = flags;
+	stream.write(reinterpret_cast<const char*>(&record), sizeof(record));
+}
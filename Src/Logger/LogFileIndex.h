@@ -0,0 +1,90 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <filesystem>
+#include <cstdint>
+
+#include "LogMessage.h"
+
+// Sidecar time index for log files written by LogToFile ("Gear.log" -> "Gear.log.idx").
+//
+// The index is a small binary file of fixed-size records: a checkpoint every N KB of log text
+// (timestamp and byte offset of the line starting there, plus per-level line counts before it)
+// and a closing record when the segment is rotated or the logger shuts down. Readers can binary
+// search to a time, and skip whole segments, without parsing the log file.
+// Records are written in native byte order (all supported targets are little-endian).
+
+struct LogIndexRecord
+{
+	static constexpr uint32_t FLAG_END = 1; // Closing record: offset is the end of the file, timestamp that of the last line
+
+	int64_t timestampNs = 0;    // Timestamp of the line starting at 'offset' (epoch ns)
+	uint64_t offset = 0;        // Byte offset of that line in the log file
+	std::array<uint32_t, LOG_LEVEL_COUNT> levelCounts{}; // Lines per level before 'offset' (since the index was created)
+	uint32_t flags = 0;
+	uint32_t reserved = 0;
+};
+static_assert(sizeof(LogIndexRecord) == 40, "LogIndexRecord is written to disk as is");
+
+class LogFileIndex
+{
+public:
+	static constexpr uint32_t MAGIC = 0x58494C47; // "GLIX"
+	static constexpr uint32_t VERSION = 1;
+	static constexpr size_t HEADER_SIZE = 8;      // MAGIC + VERSION
+
+	static std::filesystem::path PathFor(const std::filesystem::path& logFile) { return logFile.string() + ".idx"; }
+
+	// Reads the sidecar of 'logFile'. A partially written last record (writer still running) is ignored.
+	bool Load(const std::filesystem::path& logFile, std::string* error = nullptr);
+
+	const std::vector<LogIndexRecord>& GetRecords() const { return records; }
+	bool Empty() const { return records.empty(); }
+
+	// True if the segment was closed (rotated or logger shut down), so the last record covers the whole file
+	bool IsComplete() const { return !records.empty() && (records.back().flags & LogIndexRecord::FLAG_END) != 0; }
+
+	// Timestamp of the last line if complete, otherwise of the last checkpoint
+	int64_t GetLastTimestampNs() const { return records.empty() ? INT64_MIN : records.back().timestampNs; }
+
+	// Lines per level up to the last record (the whole file if IsComplete())
+	std::array<uint32_t, LOG_LEVEL_COUNT> GetLevelCounts() const { return records.empty() ? std::array<uint32_t, LOG_LEVEL_COUNT>{} : records.back().levelCounts; }
+
+	// Byte range [begin, end) that contains the first line with timestamp >= 'timeNs', assuming lines are
+	// in time order. 'end' is UINT64_MAX if the range extends past the last checkpoint.
+	void FindRange(int64_t timeNs, uint64_t& begin, uint64_t& end) const;
+
+private:
+	std::vector<LogIndexRecord> records;
+};
+
+// Writes the sidecar index while LogToFile appends to the log file. Not thread-safe, owned by the writer thread.
+class LogFileIndexWriter
+{
+public:
+	~LogFileIndexWriter() { Close(); }
+
+	// Opens the index for 'logFile', whose current size is 'fileSize'. If an index matching the file exists,
+	// it is continued (the app appends to the log of the previous run), otherwise a new one is started.
+	// 'intervalBytes' == 0 disables the index.
+	void Open(const std::filesystem::path& logFile, uint64_t fileSize, size_t intervalBytes);
+
+	// Call before writing each line at byte 'offset' of the log file
+	void OnLine(LogLevel level, int64_t timestampNs, uint64_t offset);
+
+	// Writes the closing record and closes the index ('fileSize' = final size of the log file)
+	void Finish(uint64_t fileSize);
+	void Close();
+
+private:
+	void WriteRecord(int64_t timestampNs, uint64_t offset, uint32_t flags);
+
+	std::ofstream stream;
+	size_t interval = 0;
+	uint64_t nextCheckpoint = 0;
+	int64_t lastTimestampNs = 0;
+	std::array<uint32_t, LOG_LEVEL_COUNT> levelCounts{};
+};
@@ -0,0 +1,296 @@
+#include "LogFileTail.h"
+
+#include <cstdio>
+#include <cstring>
+#include <system_error>
+
+#include "Utils/StringSearch.h"
+
+#ifdef __linux__
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+#ifndef _WIN32
+#include <sys/stat.h>
+#endif
+
+namespace
+{
+	constexpr size_t LEVEL_SCAN_LENGTH = 64; // Level keywords are only searched near the start of a line
+
+	std::FILE* OpenForReading(const std::filesystem::path& path)
+	{
+#ifdef _WIN32
+		return _wfopen(path.c_str(), L"rb");
+#else
+		return std::fopen(path.c_str(), "rb");
+#endif
+	}
+
+	uint64_t SeekToEnd(std::FILE* file)
+	{
+#ifdef _WIN32
+		_fseeki64(file, 0, SEEK_END);
+		return static_cast<uint64_t>(_ftelli64(file));
+#else
+		fseeko(file, 0, SEEK_END);
+		return static_cast<uint64_t>(ftello(file));
+#endif
+	}
+
+	// True if 'path' now refers to a different file than the open one (rotation by rename + create)
+	bool IsReplaced(std::FILE* file, const std::filesystem::path& path)
+	{
+#ifdef _WIN32
+		(void)file;
+		(void)path;
+		return false; // No cheap file identity here, rotation is detected by the size shrinking
+#else
+		struct stat opened {}, current {};
+		if (::fstat(fileno(file), &opened) != 0 || ::stat(path.c_str(), &current) != 0)
+			return false;
+		return opened.st_ino != current.st_ino || opened.st_dev != current.st_dev;
+#endif
+	}
+
+	bool IsWordChar(char c)
+	{
+		return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9');
+	}
+}
+
+LogFileTail::LogFileTail(const std::filesystem::path& path, uint16_t sourceId, Sink sink, bool fromStart)
+	: path(path), sourceId(sourceId), sink(std::move(sink)), fromStart(fromStart)
+{
+	workerThread = std::thread(&LogFileTail::Run, this);
+}
+
+LogFileTail::~LogFileTail()
+{
+	stopFlag = true;
+	if (workerThread.joinable())
+		workerThread.join();
+}
+
+std::string LogFileTail::GetError() const
+{
+	std::lock_guard lock(errorMutex);
+	return lastError;
+}
+
+void LogFileTail::SetError(std::string error)
+{
+	std::lock_guard lock(errorMutex);
+	lastError = std::move(error);
+}
+
+LogLevel LogFileTail::DetectLevel(std::string_view line)
+{
+	const size_t end = std::min(line.size(), LEVEL_SCAN_LENGTH);
+	size_t pos = 0;
+	while (pos < end)
+	{
+		while (pos < end && !IsWordChar(line[pos]))
+			++pos;
+		const size_t start = pos;
+		while (pos < end && IsWordChar(line[pos]))
+			++pos;
+
+		const std::string_view word = line.substr(start, pos - start);
+		if (word.size() < 3 || word.size() > 8)
+			continue;
+
+		for (const char* name : { "ERROR", "ERR", "FATAL", "CRITICAL", "CRIT", "ALERT", "EMERG" })
+		{
+			if (gear::EqualsNoCase(word, name))
+				return LogLevel::Error;
+		}
+		for (const char* name : { "WARN", "WARNING" })
+		{
+			if (gear::EqualsNoCase(word, name))
+				return LogLevel::Warning;
+		}
+		for (const char* name : { "DEBUG", "TRACE", "VERBOSE" })
+		{
+			if (gear::EqualsNoCase(word, name))
+				return LogLevel::Debug;
+		}
+		for (const char* name : { "INFO", "NOTICE" })
+		{
+			if (gear::EqualsNoCase(word, name))
+				return LogLevel::Info;
+		}
+	}
+	return LogLevel::Info;
+}
+
+void LogFileTail::ParseLine(std::string_view line, uint16_t sourceId, std::chrono::system_clock::time_point now, LogMessage& out)
+{
+	if (!line.empty() && line.back() == '\r')
+		line.remove_suffix(1);
+
+	if (!LogMessage::FromFileLine(line, out))
+	{
+		out.level = DetectLevel(line);
+		out.timestamp = now;
+		out.message.assign(line.data(), line.size());
+		out.sequence = 0;
+	}
+	out.sourceId = sourceId;
+}
+
+void LogFileTail::ProcessChunk(const char* data, size_t size, std::vector<LogMessage>& batch)
+{
+	const auto now = std::chrono::system_clock::now();
+
+	auto emit = [&](std::string_view line)
+		{
+			if (line.size() > MAX_LINE_LENGTH)
+				line = line.substr(0, MAX_LINE_LENGTH);
+
+			batch.emplace_back();
+			ParseLine(line, sourceId, now, batch.back());
+			lineCount.fetch_add(1, std::memory_order_relaxed);
+
+			if (batch.size() >= MAX_BATCH_SIZE)
+				FlushBatch(batch);
+		};
+
+	size_t pos = 0;
+	while (pos < size)
+	{
+		const char* newline = static_cast<const char*>(std::memchr(data + pos, '\n', size - pos));
+		if (!newline)
+		{
+			// Incomplete line: keep it for the next chunk, unless it grows without bounds
+			pending.append(data + pos, size - pos);
+			if (pending.size() > MAX_LINE_LENGTH)
+			{
+				emit(pending);
+				pending.clear();
+			}
+			break;
+		}
+
+		const size_t end = static_cast<size_t>(newline - data);
+		if (pending.empty())
+			emit(std::string_view(data + pos, end - pos));
+		else
+		{
+			pending.append(data + pos, end - pos);
+			emit(pending);
+			pending.clear();
+		}
+		pos = end + 1;
+	}
+}
+
+void LogFileTail::FlushBatch(std::vector<LogMessage>& batch)
+{
+	if (batch.empty())
+		return;
+	sink(batch);
+	batch.clear();
+}
+
+void LogFileTail::Run()
+{
+	std::vector<char> chunk(READ_CHUNK_SIZE);
+	std::vector<LogMessage> batch;
+	batch.reserve(MAX_BATCH_SIZE);
+
+	std::FILE* file = nullptr;
+	uint64_t offset = 0;
+	bool firstOpen = true;
+
+#ifdef __linux__
+	// Watch the directory, so creation of the file (or its replacement after rotation) also wakes us up
+	int inotifyFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (inotifyFd >= 0)
+	{
+		const auto directory = path.has_parent_path() ? path.parent_path() : std::filesystem::path(".");
+		if (inotify_add_watch(inotifyFd, directory.c_str(), IN_MODIFY | IN_CREATE | IN_MOVED_TO | IN_MOVED_FROM | IN_DELETE | IN_CLOSE_WRITE) < 0)
+		{
+			::close(inotifyFd);
+			inotifyFd = -1; // Fall back to polling
+		}
+	}
+#endif
+
+	while (!stopFlag)
+	{
+		if (!file)
+		{
+			file = OpenForReading(path);
+			if (file)
+			{
+				SetError({});
+				offset = (firstOpen && !fromStart) ? SeekToEnd(file) : 0;
+			}
+			else
+				SetError("Can't open " + path.string());
+			firstOpen = false; // A file created later is read from its start
+		}
+
+		if (file)
+		{
+			// Read everything that was appended since the last pass
+			while (!stopFlag)
+			{
+				const size_t bytes = std::fread(chunk.data(), 1, chunk.size(), file);
+				if (bytes == 0)
+				{
+					std::clearerr(file); // Clear EOF, so the next pass sees new data
+					break;
+				}
+				offset += bytes;
+				byteCount.fetch_add(bytes, std::memory_order_relaxed);
+				ProcessChunk(chunk.data(), bytes, batch);
+			}
+			FlushBatch(batch);
+
+			// Rotated (renamed/deleted and recreated) or truncated: continue with the new file from its start
+			std::error_code ec;
+			const auto size = std::filesystem::file_size(path, ec);
+			if (ec || size < offset || IsReplaced(file, path))
+			{
+				if (!pending.empty())
+				{
+					ProcessChunk("\n", 1, batch); // The old file won't complete its last line anymore
+					FlushBatch(batch);
+				}
+				std::fclose(file);
+				file = nullptr;
+				offset = 0;
+				if (!ec)
+					continue; // New file is already there
+			}
+		}
+
+#ifdef __linux__
+		if (inotifyFd >= 0)
+		{
+			pollfd pfd{ inotifyFd, POLLIN, 0 };
+			if (::poll(&pfd, 1, static_cast<int>(POLL_INTERVAL.count())) > 0)
+			{
+				char events[4096];
+				while (::read(inotifyFd, events, sizeof(events)) > 0)
+				{
+					// Only used as wake-up, the file is checked for new data either way
+				}
+			}
+			continue;
+		}
+#endif
+		std::this_thread::sleep_for(POLL_INTERVAL);
+	}
+
+	if (file)
+		std::fclose(file);
+#ifdef __linux__
+	if (inotifyFd >= 0)
+		::close(inotifyFd);
+#endif
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <functional>
+#include <filesystem>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include "LogMessage.h"
+
+// Follows an external text log file ("tail -f") and forwards appended lines as LogMessages.
+//
+// A worker thread reads appended bytes in large chunks, splits and parses them into LogMessages
+// (sourceId set, level detected from the text) and hands them to the sink in batches, so the sink
+// (normally Logger::PushExternal) takes its lock once per batch instead of once per line.
+// On Linux the worker sleeps on inotify events of the file's directory; elsewhere it polls.
+// Rotation (file replaced by a new one) and truncation are detected and followed.
+class LogFileTail
+{
+public:
+	static constexpr size_t READ_CHUNK_SIZE = 1 << 20;  // Bytes per read() call
+	static constexpr size_t MAX_BATCH_SIZE = 4096;      // Lines per sink call
+	static constexpr size_t MAX_LINE_LENGTH = 64 * 1024; // Longer lines are truncated
+	static constexpr auto POLL_INTERVAL = std::chrono::milliseconds(100);
+
+	using Sink = std::function<void(std::vector<LogMessage>& batch)>;
+
+	// Starts following 'path' (which may not exist yet). 'fromStart' also reads the existing content,
+	// otherwise only lines appended from now on are forwarded.
+	LogFileTail(const std::filesystem::path& path, uint16_t sourceId, Sink sink, bool fromStart = false);
+	~LogFileTail();
+
+	LogFileTail(const LogFileTail&) = delete;
+	LogFileTail& operator=(const LogFileTail&) = delete;
+
+	const std::filesystem::path& GetPath() const { return path; }
+	uint16_t GetSourceId() const { return sourceId; }
+
+	uint64_t GetLineCount() const { return lineCount.load(std::memory_order_relaxed); }
+	uint64_t GetByteCount() const { return byteCount.load(std::memory_order_relaxed); }
+
+	// Last open/read problem (e.g. file missing), empty if none
+	std::string GetError() const;
+
+	// Parses one line: lines written by GEAR keep level and timestamp, for other formats the level is
+	// detected from keywords near the start (ERROR, WARN, DEBUG, ...) and the timestamp is 'now'.
+	static void ParseLine(std::string_view line, uint16_t sourceId, std::chrono::system_clock::time_point now, LogMessage& out);
+	static LogLevel DetectLevel(std::string_view line);
+
+private:
+	void Run();
+	void SetError(std::string error);
+
+	// Splits 'data' into lines (keeping an incomplete last line in 'pending') and forwards them
+	void ProcessChunk(const char* data, size_t size, std::vector<LogMessage>& batch);
+	void FlushBatch(std::vector<LogMessage>& batch);
+
+	std::filesystem::path path;
+	uint16_t sourceId;
+	Sink sink;
+	bool fromStart;
+
+	std::string pending; // Incomplete last line of the previous chunk
+
+	std::atomic<uint64_t> lineCount{ 0 };
+	std::atomic<uint64_t> byteCount{ 0 };
+	std::atomic<bool> stopFlag{ false };
+
+	mutable std::mutex errorMutex;
+	std::string lastError;
+
+	std::thread workerThread;
+};
@@ -0,0 +1,174 @@
+#include "LogFileWriter.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#ifdef _WIN32
+#include <fcntl.h>
+#include <io.h>
+#include <sys/stat.h>
+#else
+#include <fcntl.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+LogFileWriter::LogFileWriter()
+	: buffer(new char[BUFFER_SIZE])
+{
+}
+
+bool LogFileWriter::Open(const std::filesystem::path& filePath, std::string* errorOut)
+{
+	Close();
+	path = filePath;
+	error.clear();
+
+#ifdef _WIN32
+	fd = _wopen(path.c_str(), _O_WRONLY | _O_CREAT | _O_APPEND | _O_BINARY | _O_NOINHERIT, _S_IREAD | _S_IWRITE);
+#else
+	do
+		fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND | O_CLOEXEC, 0644);
+	while (fd < 0 && errno == EINTR);
+#endif
+
+	if (fd < 0)
+	{
+		SetError("open");
+		if (errorOut)
+			*errorOut = error;
+		return false;
+	}
+	return true;
+}
+
+void LogFileWriter::Close()
+{
+	if (fd < 0)
+		return;
+
+	Flush();
+#ifdef _WIN32
+	_close(fd);
+#else
+	::close(fd);
+#endif
+	fd = -1;
+}
+
+void LogFileWriter::AppendLine(std::string_view line)
+{
+	if (line.size() + 1 <= BUFFER_SIZE - used)
+	{
+		std::memcpy(buffer.get() + used, line.data(), line.size());
+		used += line.size();
+		buffer[used++] = '\n';
+		return;
+	}
+
+	if (line.size() + 1 <= BUFFER_SIZE)
+	{
+		// Doesn't fit behind the buffered lines: write those, then start over
+		Flush();
+		AppendLine(line);
+		return;
+	}
+
+	// Larger than the whole buffer: buffered lines, the line and its '\n' in one writev(), without copying
+	const std::string_view pending(buffer.get(), used);
+	used = 0;
+	WriteAll({ pending, line, "\n" });
+}
+
+bool LogFileWriter::Flush()
+{
+	if (used == 0)
+		return true;
+
+	const std::string_view pending(buffer.get(), used);
+	used = 0;
+	return WriteAll({ pending });
+}
+
+bool LogFileWriter::Sync()
+{
+	if (fd < 0 || !Flush())
+		return false;
+
+#ifdef _WIN32
+	if (_commit(fd) != 0)
+#elif defined(__APPLE__)
+	if (::fsync(fd) != 0) // No fdatasync on macOS
+#else
+	if (::fdatasync(fd) != 0)
+#endif
+	{
+		SetError("sync");
+		return false;
+	}
+	return true;
+}
+
+// Writes all parts completely, retrying short writes and interrupts
+bool LogFileWriter::WriteAll(std::initializer_list<std::string_view> parts)
+{
+	if (fd < 0)
+		return false;
+
+#ifdef _WIN32
+	for (std::string_view part : parts)
+	{
+		while (!part.empty())
+		{
+			const int chunk = static_cast<int>(std::min<size_t>(part.size(), 1u << 30));
+			const int written = _write(fd, part.data(), static_cast<unsigned int>(chunk));
+			if (written < 0)
+			{
+				SetError("write");
+				return false;
+			}
+			part.remove_prefix(static_cast<size_t>(written));
+		}
+	}
+	return true;
+#else
+	iovec vectors[MAX_PARTS];
+	int count = 0;
+	for (std::string_view part : parts)
+		if (!part.empty() && count < MAX_PARTS)
+			vectors[count++] = iovec{ const_cast<char*>(part.data()), part.size() };
+	iovec* next = vectors;
+
+	while (count > 0)
+	{
+		const ssize_t written = ::writev(fd, next, count);
+		if (written < 0)
+		{
+			if (errno == EINTR)
+				continue;
+			SetError("write");
+			return false;
+		}
+
+		size_t remaining = static_cast<size_t>(written);
+		while (count > 0 && remaining >= next->iov_len)
+		{
+			remaining -= next->iov_len;
+			++next;
+			--count;
+		}
+		if (count > 0)
+		{
+			next->iov_base = static_cast<char*>(next->iov_base) + remaining;
+			next->iov_len -= remaining;
+		}
+	}
+	return true;
+#endif
+}
+
+void LogFileWriter::SetError(const char* what)
+{
+	error = std::string(what) + " failed for " + path.string() + ": " + std::strerror(errno);
+}
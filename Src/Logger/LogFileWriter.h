@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <initializer_list>
+#include <memory>
+#include <string>
+#include <string_view>
+
+// Durability tier of LogToFile: when written data is forced to the disk (fdatasync / _commit)
+enum class LogSyncMode
+{
+	None,     // Left to the OS (data reaches the page cache when a batch is flushed)
+	Periodic, // At most every sync period, after a flush
+	OnError   // After every Error line, so the lines leading to a crash survive a power loss
+};
+
+// Append-only log file on a raw file descriptor (O_APPEND | O_CLOEXEC on POSIX), replacing std::ofstream.
+//
+// Lines are collected in a private buffer and written with one write() per flush; a line too large for the
+// buffer goes out together with the buffered data in a single writev(). No locale, no stream state, no
+// flush per line. Not thread-safe, owned by the LogToFile writer thread.
+class LogFileWriter
+{
+public:
+	static constexpr size_t BUFFER_SIZE = 256 * 1024;
+
+	LogFileWriter();
+	~LogFileWriter() { Close(); }
+
+	LogFileWriter(const LogFileWriter&) = delete;
+	LogFileWriter& operator=(const LogFileWriter&) = delete;
+
+	// Opens (creates) 'path' for appending, closing a previously open file
+	bool Open(const std::filesystem::path& path, std::string* error = nullptr);
+	// Flushes the buffer and closes the file
+	void Close();
+	bool IsOpen() const { return fd >= 0; }
+
+	// Buffers 'line' followed by '\n'; writes the buffer out when it is full
+	void AppendLine(std::string_view line);
+
+	// Writes buffered lines to the file. False (see GetError()) if data could not be written; it is dropped
+	// then, so a full disk doesn't make the buffer grow.
+	bool Flush();
+
+	// Flushes and forces the file data to the disk
+	bool Sync();
+
+	size_t GetBufferedBytes() const { return used; }
+	const std::string& GetError() const { return error; }
+
+private:
+	static constexpr int MAX_PARTS = 3;
+	bool WriteAll(std::initializer_list<std::string_view> parts);
+	void SetError(const char* what);
+
+	int fd = -1;
+	std::unique_ptr<char[]> buffer;
+	size_t used = 0;
+	std::filesystem::path path;
+	std::string error;
+};
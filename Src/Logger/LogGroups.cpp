@@ -0,0 +1,105 @@
+#include "LogGroups.h"
+
+#include <algorithm>
+#include <chrono>
+
+namespace
+{
+	template<typename T>
+	void StoreMin(std::atomic<T>& target, T value)
+	{
+		T current = target.load(std::memory_order_relaxed);
+		while (value < current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed))
+		{
+		}
+	}
+
+	template<typename T>
+	void StoreMax(std::atomic<T>& target, T value)
+	{
+		T current = target.load(std::memory_order_relaxed);
+		while (value > current && !target.compare_exchange_weak(current, value, std::memory_order_relaxed))
+		{
+		}
+	}
+}
+
+LogGroups::Site* LogGroups::GetSite(uint32_t siteId, LogLevel level)
+{
+	Site* site = sites[siteId].load(std::memory_order_acquire);
+	if (site)
+		return site;
+
+	std::lock_guard lock(allocationMutex);
+	site = sites[siteId].load(std::memory_order_relaxed);
+	if (!site)
+	{
+		storage.push_back(std::make_unique<Site>());
+		site = storage.back().get();
+		site->level = level;
+		sites[siteId].store(site, std::memory_order_release);
+	}
+	return site;
+}
+
+void LogGroups::Record(const LogMessage& message)
+{
+	if (message.siteId == LogSymbols::NONE || message.siteId >= sites.size())
+		return;
+
+	Site* site = GetSite(message.siteId, message.level);
+	const int64_t ns = ToEpochNanoseconds(message.timestamp);
+	site->count.fetch_add(1, std::memory_order_relaxed);
+	StoreMin(site->firstNs, ns);
+	StoreMax(site->lastNs, ns);
+	StoreMax(site->lastSequence, message.sequence);
+
+	const int64_t epochSecond = std::chrono::floor<std::chrono::seconds>(message.timestamp.time_since_epoch()).count();
+	if (epochSecond < 0)
+		return;
+
+	// First message of a second claims its slot, like LogRateSeries::Record()
+	SecondSlot& slot = site->seconds[static_cast<size_t>(epochSecond) % SPARK_SECONDS];
+	int64_t slotSecond = slot.second.load(std::memory_order_acquire);
+	while (slotSecond != epochSecond)
+	{
+		if (slotSecond > epochSecond)
+			return;
+		if (slot.second.compare_exchange_weak(slotSecond, epochSecond, std::memory_order_acq_rel))
+		{
+			slot.count.store(0, std::memory_order_relaxed);
+			break;
+		}
+	}
+	slot.count.fetch_add(1, std::memory_order_relaxed);
+}
+
+void LogGroups::Snapshot(int64_t lastSecond, std::vector<Group>& out) const
+{
+	out.clear();
+	const size_t count = std::min(LogSymbols::GetCount() + 1, sites.size());
+	for (uint32_t id = 1; id < count; ++id)
+	{
+		const Site* site = sites[id].load(std::memory_order_acquire);
+		if (!site)
+			continue;
+
+		Group& group = out.emplace_back();
+		group.siteId = id;
+		group.level = site->level;
+		group.count = site->count.load(std::memory_order_relaxed);
+		group.firstNs = site->firstNs.load(std::memory_order_relaxed);
+		group.lastNs = site->lastNs.load(std::memory_order_relaxed);
+		group.lastSequence = site->lastSequence.load(std::memory_order_relaxed);
+
+		for (size_t i = 0; i < SPARK_SECONDS; ++i)
+		{
+			const int64_t second = lastSecond - static_cast<int64_t>(SPARK_SECONDS - 1 - i);
+			if (second < 0)
+				continue;
+			const SecondSlot& slot = site->seconds[static_cast<size_t>(second) % SPARK_SECONDS];
+			if (slot.second.load(std::memory_order_acquire) == second)
+				group.perSecond[i] = slot.count.load(std::memory_order_relaxed);
+		}
+	}
+}
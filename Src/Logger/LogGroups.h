@@ -0,0 +1,65 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "LogMessage.h"
+#include "LogSymbols.h"
+
+// Aggregates per log site (LogMessage::siteId, "Function(): format string") for the grouped view of the
+// Logger window: message count, first and last time, the last sequence and messages per second for the last
+// SPARK_SECONDS.
+//
+// Maintained incrementally by the producers: Record() does a few relaxed atomic updates on the site's own
+// record, which is allocated under a mutex on the site's first message only. The per-second slots are
+// claimed like those of LogRateSeries. Reading is a copy of the records of the sites seen so far, independent
+// of the number of messages.
+class LogGroups
+{
+public:
+	static constexpr size_t SPARK_SECONDS = 120;
+
+	struct Group
+	{
+		uint32_t siteId = LogSymbols::NONE;
+		LogLevel level = LogLevel::Info; // Of the site's first message
+		uint64_t count = 0;
+		int64_t firstNs = 0;             // Epoch nanoseconds
+		int64_t lastNs = 0;
+		uint64_t lastSequence = 0;
+		std::array<uint32_t, SPARK_SECONDS> perSecond{}; // Oldest first, ending at the snapshot second
+	};
+
+	// Messages without a site (other sources) are ignored
+	void Record(const LogMessage& message);
+
+	// Replaces 'out' with the groups of all sites seen so far, their rates ending at 'lastSecond' (epoch seconds)
+	void Snapshot(int64_t lastSecond, std::vector<Group>& out) const;
+
+private:
+	struct SecondSlot
+	{
+		std::atomic<int64_t> second{ -1 };
+		std::atomic<uint32_t> count{ 0 };
+	};
+
+	struct Site
+	{
+		LogLevel level = LogLevel::Info;
+		std::atomic<uint64_t> count{ 0 };
+		std::atomic<int64_t> firstNs{ INT64_MAX };
+		std::atomic<int64_t> lastNs{ INT64_MIN };
+		std::atomic<uint64_t> lastSequence{ 0 };
+		std::array<SecondSlot, SPARK_SECONDS> seconds;
+	};
+
+	Site* GetSite(uint32_t siteId, LogLevel level);
+
+	std::array<std::atomic<Site*>, LogSymbols::MAX_SYMBOLS + 1> sites{}; // By site id
+	std::mutex allocationMutex;
+	std::vector<std::unique_ptr<Site>> storage;
+};
@@ -0,0 +1,298 @@
+#include "LogHistory.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <system_error>
+
+namespace
+{
+	constexpr size_t MAX_TIMESTAMP_LOOKAHEAD = 16; // Rows searched for a parsable line in FindTimestamp()
+	constexpr size_t PREFIX_COMPARE_BYTES = 256;   // Bytes compared to recognize a grown or renamed file
+	constexpr size_t STOP_CHECK_BYTES = 1 << 20;   // Indexing polls the stop flag every MB
+
+	// Appends the offsets of all complete lines in [segment.indexedBytes, end of mapping)
+	void IndexLines(LogHistory::Segment& segment, const std::atomic<bool>& stopFlag)
+	{
+		const char* data = segment.file.Data();
+		const size_t end = std::min<size_t>(segment.file.Size(), std::numeric_limits<uint32_t>::max());
+
+		size_t pos = segment.indexedBytes;
+		size_t nextStopCheck = pos + STOP_CHECK_BYTES;
+		while (pos < end)
+		{
+			const void* newline = std::memchr(data + pos, '\n', end - pos);
+			if (!newline)
+				break; // Incomplete last line, the writer is not done with it yet
+
+			segment.lineOffsets.push_back(static_cast<uint32_t>(pos));
+			pos = static_cast<size_t>(static_cast<const char*>(newline) - data) + 1;
+
+			if (pos >= nextStopCheck)
+			{
+				if (stopFlag.load(std::memory_order_relaxed))
+					break;
+				nextStopCheck = pos + STOP_CHECK_BYTES;
+			}
+		}
+		segment.indexedBytes = pos;
+	}
+
+	bool SamePrefix(const LogHistory::Segment& a, const gear::MappedFile& b)
+	{
+		const size_t length = std::min({ PREFIX_COMPARE_BYTES, a.file.Size(), b.Size() });
+		return length > 0 && std::memcmp(a.file.Data(), b.Data(), length) == 0;
+	}
+}
+
+// -------- Segment / Snapshot --------
+
+std::string_view LogHistory::Segment::GetLine(size_t line) const
+{
+	const size_t begin = lineOffsets[line];
+	size_t end = (line + 1 < lineOffsets.size()) ? lineOffsets[line + 1] : indexedBytes;
+	if (end > begin && file.Data()[end - 1] == '\n')
+		--end;
+	return std::string_view(file.Data() + begin, end - begin);
+}
+
+size_t LogHistory::Segment::LineAtOffset(uint64_t offset) const
+{
+	return static_cast<size_t>(std::lower_bound(lineOffsets.begin(), lineOffsets.end(), offset) - lineOffsets.begin());
+}
+
+std::string_view LogHistory::Snapshot::GetLine(size_t row) const
+{
+	const size_t segment = static_cast<size_t>(std::upper_bound(firstRows.begin(), firstRows.end(), row) - firstRows.begin()) - 1;
+	return segments[segment]->GetLine(row - firstRows[segment]);
+}
+
+bool LogHistory::Snapshot::GetRow(size_t row, LogMessage& out) const
+{
+	const std::string_view line = GetLine(row);
+	if (LogMessage::FromFileLine(line, out))
+		return true;
+
+	out.level = LogLevel::Info;
+	out.timestamp = Clock::time_point{};
+	out.message.assign(line.data(), line.size());
+	out.sequence = 0;
+	return false;
+}
+
+bool LogHistory::Snapshot::FindTimestamp(size_t row, Clock::time_point& out) const
+{
+	LogMessage message;
+	const size_t end = std::min(lineCount, row + MAX_TIMESTAMP_LOOKAHEAD);
+	for (; row < end; ++row)
+	{
+		if (LogMessage::FromFileLine(GetLine(row), message))
+		{
+			out = message.timestamp;
+			return true;
+		}
+	}
+	return false;
+}
+
+std::array<uint64_t, LOG_LEVEL_COUNT> LogHistory::Snapshot::GetLevelCounts() const
+{
+	std::array<uint64_t, LOG_LEVEL_COUNT> counts{};
+	for (const auto& segment : segments)
+	{
+		const auto segmentCounts = segment->timeIndex.GetLevelCounts();
+		for (size_t level = 0; level < LOG_LEVEL_COUNT; ++level)
+			counts[level] += segmentCounts[level];
+	}
+	return counts;
+}
+
+size_t LogHistory::Snapshot::LowerBound(Clock::time_point time) const
+{
+	// Lines only store milliseconds: a line (floored to ms) is before 'time' exactly when its exact
+	// timestamp in the index is before 'time' rounded up to the next millisecond
+	int64_t timeNs = ToEpochNanoseconds(time);
+	if (timeNs < INT64_MAX - 1000000)
+	{
+		int64_t ms = timeNs / 1000000;
+		if (ms * 1000000 < timeNs)
+			++ms;
+		timeNs = ms * 1000000;
+	}
+
+	for (size_t s = 0; s < segments.size(); ++s)
+	{
+		const Segment& segment = *segments[s];
+		const LogFileIndex& timeIndex = segment.timeIndex;
+
+		// Closed segment that ends before the time: skip without parsing a single line
+		if (timeIndex.IsComplete() && timeIndex.GetLastTimestampNs() < timeNs)
+			continue;
+
+		// Narrow the search to the bytes between the two checkpoints around the time
+		size_t low = 0;
+		size_t high = segment.GetLineCount();
+		if (!timeIndex.Empty())
+		{
+			uint64_t beginOffset, endOffset;
+			timeIndex.FindRange(timeNs, beginOffset, endOffset);
+			low = segment.LineAtOffset(beginOffset);
+			if (endOffset != UINT64_MAX)
+				high = std::min(high, segment.LineAtOffset(endOffset) + 1);
+		}
+
+		const size_t row = LowerBound(firstRows[s] + low, firstRows[s] + std::max(low, high), time);
+		if (row < firstRows[s] + segment.GetLineCount())
+			return row;
+	}
+	return lineCount;
+}
+
+size_t LogHistory::Snapshot::LowerBound(size_t low, size_t high, Clock::time_point time) const
+{
+	while (low < high)
+	{
+		const size_t mid = low + (high - low) / 2;
+		Clock::time_point timestamp;
+		if (FindTimestamp(mid, timestamp) && timestamp < time)
+			low = mid + 1;
+		else
+			high = mid;
+	}
+	return low;
+}
+
+// -------- LogHistory --------
+
+LogHistory::LogHistory(const std::string& folderPath, const std::string& fileName, int maxBackups)
+	: folder(folderPath), filename(fileName), maxBackups(maxBackups), snapshot(std::make_shared<Snapshot>())
+{
+	workerThread = std::thread(&LogHistory::Run, this);
+}
+
+LogHistory::~LogHistory()
+{
+	{
+		std::lock_guard lock(mutex);
+		stopFlag = true;
+	}
+	cv.notify_all();
+
+	if (workerThread.joinable())
+		workerThread.join();
+}
+
+void LogHistory::Refresh()
+{
+	{
+		std::lock_guard lock(mutex);
+		refreshRequested = true;
+	}
+	cv.notify_one();
+}
+
+std::shared_ptr<const LogHistory::Snapshot> LogHistory::GetSnapshot() const
+{
+	std::lock_guard lock(mutex);
+	return snapshot;
+}
+
+std::string LogHistory::GetError() const
+{
+	std::lock_guard lock(mutex);
+	return lastError;
+}
+
+void LogHistory::Run()
+{
+	std::unique_lock lock(mutex);
+	while (true)
+	{
+		cv.wait(lock, [this]() { return stopFlag || refreshRequested; });
+		if (stopFlag)
+			break;
+
+		refreshRequested = false;
+		std::shared_ptr<const Snapshot> previous = snapshot;
+		indexing = true;
+		lock.unlock();
+
+		std::string error;
+		std::shared_ptr<const Snapshot> next = BuildSnapshot(previous, error);
+
+		lock.lock();
+		indexing = false;
+		if (stopFlag)
+			break;
+		snapshot = std::move(next);
+		lastError = std::move(error);
+	}
+}
+
+std::shared_ptr<const LogHistory::Snapshot> LogHistory::BuildSnapshot(const std::shared_ptr<const Snapshot>& previous, std::string& error) const
+{
+	auto next = std::make_shared<Snapshot>();
+	const auto folderPath = std::filesystem::path(folder);
+
+	for (int backup = maxBackups; backup >= 0; --backup)
+	{
+		const auto path = backup > 0 ? folderPath / (filename + "." + std::to_string(backup)) : folderPath / filename;
+
+		std::error_code ec;
+		const auto size = std::filesystem::file_size(path, ec);
+		if (ec)
+			continue; // Backup doesn't exist (yet)
+		const auto writeTime = std::filesystem::last_write_time(path, ec);
+
+		// Unchanged file (possibly renamed by a rotation): reuse its index as is
+		std::shared_ptr<const Segment> reused;
+		for (const auto& old : previous->segments)
+		{
+			if (old->file.Size() == size && old->writeTime == writeTime)
+			{
+				reused = old;
+				break;
+			}
+		}
+
+		if (!reused)
+		{
+			auto segment = std::make_shared<Segment>();
+			segment->path = path;
+			segment->writeTime = writeTime;
+
+			std::string mapError;
+			if (!segment->file.Open(path, &mapError))
+			{
+				error = std::move(mapError);
+				continue;
+			}
+			segment->timeIndex.Load(path); // Optional, files of older versions have none
+
+			// Grown file (the current one, or the current one after rotation): continue indexing where the last pass stopped
+			for (const auto& old : previous->segments)
+			{
+				if (old->indexedBytes <= segment->file.Size() && SamePrefix(*old, segment->file))
+				{
+					segment->lineOffsets = old->lineOffsets;
+					segment->indexedBytes = old->indexedBytes;
+					break;
+				}
+			}
+
+			IndexLines(*segment, stopFlag);
+			if (stopFlag)
+				return next;
+			reused = std::move(segment);
+		}
+
+		if (reused->GetLineCount() == 0)
+			continue;
+
+		next->firstRows.push_back(next->lineCount);
+		next->lineCount += reused->GetLineCount();
+		next->byteCount += reused->indexedBytes;
+		next->segments.push_back(std::move(reused));
+	}
+	return next;
+}
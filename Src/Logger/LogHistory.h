@@ -0,0 +1,120 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <array>
+#include <cstdint>
+
+#include "LogMessage.h"
+#include "LogFileIndex.h"
+#include "Platform/MappedFile.h"
+
+// Disk-backed log history: read-only view over the current and rotated log files written by LogToFile
+// ("Gear.log.N" ... "Gear.log.1", "Gear.log", oldest first).
+//
+// The files are memory-mapped and a line-offset index (4 bytes per line) is built on a background
+// thread, so the GUI can show any line of gigabytes of history without loading it into RAM; only the
+// visible rows are parsed. Refresh() re-indexes incrementally: unchanged (also renamed) files are reused,
+// a grown current file is only indexed from where the last pass stopped. Time lookups use the sidecar
+// index written by LogToFile (LogFileIndex) to skip whole files and narrow the search to a few KB.
+class LogHistory
+{
+public:
+	using Clock = std::chrono::system_clock;
+
+	// One mapped log file with the start offsets of its complete lines
+	struct Segment
+	{
+		std::filesystem::path path;
+		std::filesystem::file_time_type writeTime;
+		gear::MappedFile file;
+		std::vector<uint32_t> lineOffsets; // Offsets of lines terminated by '\n' (files are limited to 4 GB)
+		size_t indexedBytes = 0;           // End of the last complete line
+		LogFileIndex timeIndex;            // Sidecar checkpoints, empty if the file has none
+
+		size_t GetLineCount() const { return lineOffsets.size(); }
+		std::string_view GetLine(size_t line) const;
+
+		// First line starting at or after byte 'offset'
+		size_t LineAtOffset(uint64_t offset) const;
+	};
+
+	// Immutable state of the index, shared with the GUI. Rows are numbered over all segments, oldest first.
+	class Snapshot
+	{
+	public:
+		size_t GetLineCount() const { return lineCount; }
+		size_t GetSegmentCount() const { return segments.size(); }
+		uint64_t GetByteCount() const { return byteCount; }
+
+		// Lines per level according to the sidecar indexes (files without index are not counted)
+		std::array<uint64_t, LOG_LEVEL_COUNT> GetLevelCounts() const;
+
+		// Raw line text without the line break
+		std::string_view GetLine(size_t row) const;
+
+		// Parses the row into 'out'. Lines that are not in the file format (e.g. continuation lines of
+		// multi-line messages) are returned as Info with the raw text and return false.
+		bool GetRow(size_t row, LogMessage& out) const;
+
+		// First row with a timestamp >= 'time' (GetLineCount() if none). Rows are assumed to be in time order.
+		size_t LowerBound(Clock::time_point time) const;
+
+	private:
+		friend class LogHistory;
+
+		// Timestamp of the row, or of the next parsable row after it (searches a few rows ahead)
+		bool FindTimestamp(size_t row, Clock::time_point& out) const;
+
+		// Binary search over rows [low, high) by parsing timestamps
+		size_t LowerBound(size_t low, size_t high, Clock::time_point time) const;
+
+		std::vector<std::shared_ptr<const Segment>> segments;
+		std::vector<size_t> firstRows; // First global row of each segment
+		size_t lineCount = 0;
+		uint64_t byteCount = 0;
+	};
+
+	LogHistory(const std::string& folderPath, const std::string& fileName, int maxBackups);
+	~LogHistory();
+
+	LogHistory(const LogHistory&) = delete;
+	LogHistory& operator=(const LogHistory&) = delete;
+
+	// Asks the background thread to re-scan the log files. Cheap if nothing changed.
+	void Refresh();
+
+	// Latest published index, never null (empty before the first pass finished)
+	std::shared_ptr<const Snapshot> GetSnapshot() const;
+
+	bool IsIndexing() const { return indexing.load(std::memory_order_relaxed); }
+
+	// Last error while mapping a file, empty if none
+	std::string GetError() const;
+
+private:
+	void Run();
+	std::shared_ptr<const Snapshot> BuildSnapshot(const std::shared_ptr<const Snapshot>& previous, std::string& error) const;
+
+	std::string folder;
+	std::string filename;
+	int maxBackups;
+
+	mutable std::mutex mutex;
+	std::condition_variable cv;
+	bool refreshRequested = false;
+	std::atomic<bool> stopFlag{ false }; // Also polled while indexing large files
+	std::shared_ptr<const Snapshot> snapshot;
+	std::string lastError;
+
+	std::atomic<bool> indexing{ false };
+	std::thread workerThread;
+};
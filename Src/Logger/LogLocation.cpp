@@ -0,0 +1,28 @@
+#include "LogLocation.h"
+
+#include <iterator>
+
+#include "LogSymbols.h"
+
+std::string_view LogLocation::GetFileName() const
+{
+	const std::string_view path = source.file_name();
+	const size_t slash = path.find_last_of("/\\");
+	return slash == std::string_view::npos ? path : path.substr(slash + 1);
+}
+
+void AppendLogPrefix(fmt::memory_buffer& out, const LogLocation* location, uint32_t objectId, uint32_t nameId, uint32_t callerId)
+{
+	if (!location)
+		return;
+
+	if (callerId != LogSymbols::NONE)
+		fmt::format_to(std::back_inserter(out), "{} >> {} \"{}\" {}(): ", LogSymbols::GetText(callerId), LogSymbols::GetText(objectId),
+			LogSymbols::GetText(nameId), location->function);
+	else if (nameId != LogSymbols::NONE)
+		fmt::format_to(std::back_inserter(out), "{} \"{}\" {}(): ", LogSymbols::GetText(objectId), LogSymbols::GetText(nameId), location->function);
+	else if (objectId != LogSymbols::NONE)
+		fmt::format_to(std::back_inserter(out), "{} {}(): ", LogSymbols::GetText(objectId), location->function);
+	else
+		fmt::format_to(std::back_inserter(out), "{}(): ", location->function);
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <source_location>
+#include <string_view>
+#include <fmt/format.h>
+
+// Call site of a LOG_* macro. Every macro expands to its own static LogLocation, constant-initialized at
+// compile time, so a log call only passes a pointer: the message keeps the user text and the prefix
+// ('Object "Name" Function(): ') is rendered from the location and the LogSymbols ids of the message when it
+// is shown, searched or written (LogMessage::AppendText()).
+struct LogLocation
+{
+	std::source_location source;               // File and line of the call
+	const char* function;                      // __func__ of the caller, the name in the prefix
+	mutable std::atomic<uint32_t> siteId{ 0 }; // LogSymbols id of "Function(): format string", set by the first call
+
+	// File name without its directories
+	std::string_view GetFileName() const;
+};
+
+// Appends the prefix of a LOG_* call: 'Function(): ', 'Object Function(): ', 'Object "Name" Function(): ' or
+// 'Caller >> Object "Name" Function(): ' depending on the ids set. Nothing without a location.
+void AppendLogPrefix(fmt::memory_buffer& out, const LogLocation* location, uint32_t objectId, uint32_t nameId, uint32_t callerId);
@@ -1,10 +1,17 @@
 #pragma once
 
 #include <string>
+#include <string_view>
+#include <cstdint>
 #include <chrono>
 #include <thread>
 #include <ctime>
+#include <iterator>
+#include <limits>
 #include <fmt/core.h>
+#include <fmt/format.h>
+
+#include "LogLocation.h"
 
 enum class LogLevel
 {
@@ -14,9 +21,36 @@ enum class LogLevel
 	Debug
 };
 
+// Bit mask over LogLevel values, bit N = LogLevel with underlying value N
+inline constexpr uint32_t LevelBit(LogLevel level) { return 1u << static_cast<uint32_t>(level); }
+inline constexpr size_t LOG_LEVEL_COUNT = 4;
+inline constexpr uint32_t ALL_LOG_LEVELS = LevelBit(LogLevel::Info) | LevelBit(LogLevel::Warning) | LevelBit(LogLevel::Error) | LevelBit(LogLevel::Debug);
+
+// Timestamps as int64 nanoseconds since epoch (columnar store, file index). Saturates instead of overflowing,
+// so time_point::min()/max() can be used as open query bounds on every platform.
+inline int64_t ToEpochNanoseconds(std::chrono::system_clock::time_point tp)
+{
+	using namespace std::chrono;
+	constexpr auto maxNs = duration_cast<system_clock::duration>(nanoseconds::max());
+	constexpr auto minNs = duration_cast<system_clock::duration>(nanoseconds::min());
+	if (tp.time_since_epoch() >= maxNs)
+		return std::numeric_limits<int64_t>::max();
+	if (tp.time_since_epoch() <= minNs)
+		return std::numeric_limits<int64_t>::min();
+	return duration_cast<nanoseconds>(tp.time_since_epoch()).count();
+}
+
+inline std::chrono::system_clock::time_point FromEpochNanoseconds(int64_t ns)
+{
+	using namespace std::chrono;
+	return system_clock::time_point(duration_cast<system_clock::duration>(nanoseconds(ns)));
+}
+
 struct LogMessageColor
 {
 	float r, g, b, a;
+	constexpr LogMessageColor()
+		: r(1), g(1), b(1), a(1) {}
 	constexpr LogMessageColor(float r, float g, float b, float a = 1.0f)
 		: r(r), g(g), b(b), a(a) {}
 };
@@ -26,6 +60,16 @@ struct LogMessage
 	LogLevel level;
 	std::chrono::system_clock::time_point timestamp;
 	std::string message;
+	uint64_t sequence = 0; // Monotonic push counter, assigned by CircularLogBuffer::Push()
+	uint16_t sourceId = 0; // LogSources id, 0 = GEAR itself (others e.g. tailed log files)
+	uint16_t threadIndex = 0; // LogThreads index of the thread that logged it, 0 = none (other sources)
+	uint32_t objectId = 0; // LogSymbols ids of the LOG1..LOG3 prefix parts, 0 = none
+	uint32_t nameId = 0;
+	uint32_t callerId = 0;
+	uint32_t siteId = 0;           // LogSymbols id of the log site ("Function(): format string", LogGroups), 0 = none
+	uint32_t fullLength = 0;       // Length before truncation (Logger::SetMaxMessageLength()), 0 = complete
+	int64_t attachmentOffset = -1; // Offset of the full text in the attachments file (LogAttachments), -1 = none
+	const LogLocation* location = nullptr; // Call site of a LOG_* macro, null for other sources. Its prefix is not in 'message'.
 
 	LogMessage()
 		: level(LogLevel::Info),
@@ -80,10 +124,114 @@ struct LogMessage
 		std::snprintf(outBuffer, bufferSize, "%s.%03lld]", tempBuffer, static_cast<long long>(ms.count()));
 	}
 
+	// Text as shown and written: the prefix of a LOG_* call, rendered from 'location' and the symbol ids,
+	// followed by 'message'
+	void AppendText(fmt::memory_buffer& out) const
+	{
+		AppendLogPrefix(out, location, objectId, nameId, callerId);
+		out.append(message.data(), message.data() + message.size());
+	}
+
+	// Same as a view: 'message' itself without a location, otherwise rendered into 'scratch'
+	std::string_view GetText(fmt::memory_buffer& scratch) const
+	{
+		if (!location)
+			return message;
+		scratch.clear();
+		AppendText(scratch);
+		return std::string_view(scratch.data(), scratch.size());
+	}
+
+	std::string GetText() const
+	{
+		fmt::memory_buffer scratch;
+		return std::string(GetText(scratch));
+	}
+
 	std::string ToStringForFile() const
 	{
 		char timeString[80];
 		FormatTimestamp(timeString, sizeof(timeString));
-		return fmt::format("[{0}] {1} {2}", FormatLevel(), timeString, message);
+		fmt::memory_buffer line;
+		fmt::format_to(std::back_inserter(line), "[{0}] {1} ", FormatLevel(), timeString);
+		AppendText(line);
+		return fmt::to_string(line);
+	}
+
+	// Parses a line written by ToStringForFile(): "[LEVEL] [YYYY:MM:DD HH:MM:SS.mmm] message".
+	// Returns false (and leaves 'out' unchanged) if the line has a different format, e.g. the
+	// continuation of a multi-line message. The sequence number is not stored in the file and set to 0.
+	static bool FromFileLine(std::string_view line, LogMessage& out)
+	{
+		if (!line.empty() && line.back() == '\r')
+			line.remove_suffix(1);
+		if (line.size() < 2 || line[0] != '[')
+			return false;
+
+		const size_t levelEnd = line.find(']');
+		if (levelEnd == std::string_view::npos)
+			return false;
+
+		LogLevel parsedLevel;
+		const std::string_view levelName = line.substr(1, levelEnd - 1);
+		if (levelName == "INFO")
+			parsedLevel = LogLevel::Info;
+		else if (levelName == "WARN")
+			parsedLevel = LogLevel::Warning;
+		else if (levelName == "ERROR")
+			parsedLevel = LogLevel::Error;
+		else if (levelName == "DEBUG")
+			parsedLevel = LogLevel::Debug;
+		else
+			return false;
+
+		// " [YYYY:MM:DD HH:MM:SS.mmm]"
+		constexpr size_t TIME_LENGTH = 23;
+		const size_t timeStart = levelEnd + 3;
+		if (line.size() < timeStart + TIME_LENGTH + 1 || line[levelEnd + 1] != ' ' || line[levelEnd + 2] != '[' || line[timeStart + TIME_LENGTH] != ']')
+			return false;
+
+		const char* t = line.data() + timeStart;
+		if (t[4] != ':' || t[7] != ':' || t[10] != ' ' || t[13] != ':' || t[16] != ':' || t[19] != '.')
+			return false;
+
+		auto number = [t](size_t pos, size_t length, int& value)
+			{
+				value = 0;
+				for (size_t i = pos; i < pos + length; ++i)
+				{
+					if (t[i] < '0' || t[i] > '9')
+						return false;
+					value = value * 10 + (t[i] - '0');
+				}
+				return true;
+			};
+
+		int year, month, day, hour, minute, second, millis;
+		if (!number(0, 4, year) || !number(5, 2, month) || !number(8, 2, day) || !number(11, 2, hour) ||
+			!number(14, 2, minute) || !number(17, 2, second) || !number(20, 3, millis))
+			return false;
+
+		std::tm tm{};
+		tm.tm_year = year - 1900;
+		tm.tm_mon = month - 1;
+		tm.tm_mday = day;
+		tm.tm_hour = hour;
+		tm.tm_min = minute;
+		tm.tm_sec = second;
+		tm.tm_isdst = -1; // Written in local time, let mktime figure out DST
+		const std::time_t seconds = std::mktime(&tm);
+		if (seconds == static_cast<std::time_t>(-1))
+			return false;
+
+		size_t messageStart = timeStart + TIME_LENGTH + 1;
+		if (messageStart < line.size() && line[messageStart] == ' ')
+			++messageStart;
+
+		out.level = parsedLevel;
+		out.timestamp = std::chrono::system_clock::from_time_t(seconds) + std::chrono::milliseconds(millis);
+		out.message.assign(line.data() + messageStart, line.size() - messageStart);
+		out.sequence = 0;
+		return true;
 	}
 };
@@ -0,0 +1,334 @@
+#include "LogQuery.h"
+
+#include <cctype>
+#include <charconv>
+#include <cstdio>
+#include <ctime>
+
+#include "LogSymbols.h"
+#include "Utils/StringSearch.h"
+
+namespace
+{
+	using gear::EqualsNoCase;
+	using gear::StartsWithNoCase;
+	using gear::ContainsNoCase;
+
+	// Splits the query into terms. Double quotes group spaces into one term and are removed.
+	std::vector<std::string> Tokenize(std::string_view text)
+	{
+		std::vector<std::string> tokens;
+		std::string current;
+		bool inQuotes = false;
+		bool hasToken = false;
+
+		for (char c : text)
+		{
+			if (c == '"')
+			{
+				inQuotes = !inQuotes;
+				hasToken = true;
+			}
+			else if (!inQuotes && std::isspace(static_cast<unsigned char>(c)))
+			{
+				if (hasToken)
+					tokens.push_back(std::move(current));
+				current.clear();
+				hasToken = false;
+			}
+			else
+			{
+				current.push_back(c);
+				hasToken = true;
+			}
+		}
+		if (hasToken)
+			tokens.push_back(std::move(current));
+		return tokens;
+	}
+
+	std::vector<std::string> SplitList(std::string_view text)
+	{
+		std::vector<std::string> parts;
+		size_t start = 0;
+		while (start <= text.size())
+		{
+			size_t end = text.find(',', start);
+			if (end == std::string_view::npos)
+				end = text.size();
+			if (end > start)
+				parts.emplace_back(text.substr(start, end - start));
+			start = end + 1;
+		}
+		return parts;
+	}
+
+	bool ParseLevel(std::string_view name, uint32_t& mask)
+	{
+		if (EqualsNoCase(name, "info"))
+			mask |= LevelBit(LogLevel::Info);
+		else if (EqualsNoCase(name, "warn") || EqualsNoCase(name, "warning"))
+			mask |= LevelBit(LogLevel::Warning);
+		else if (EqualsNoCase(name, "error") || EqualsNoCase(name, "err"))
+			mask |= LevelBit(LogLevel::Error);
+		else if (EqualsNoCase(name, "debug"))
+			mask |= LevelBit(LogLevel::Debug);
+		else
+			return false;
+		return true;
+	}
+
+	// Accepts "HH:MM[:SS]" (today, local time), "YYYY-MM-DD" and "YYYY-MM-DD[T| ]HH:MM[:SS]"
+	bool ParseTimePoint(const std::string& text, LogQuery::Clock::time_point now, LogQuery::Clock::time_point& out)
+	{
+		std::time_t nowT = LogQuery::Clock::to_time_t(now);
+		std::tm tm{};
+#ifdef _WIN32
+		localtime_s(&tm, &nowT);
+#else
+		localtime_r(&nowT, &tm);
+#endif
+		int year = 0, month = 0, day = 0, hour = 0, minute = 0, second = 0;
+		char sep = 0;
+
+		if (std::sscanf(text.c_str(), "%d-%d-%d%c%d:%d:%d", &year, &month, &day, &sep, &hour, &minute, &second) >= 3 && text.find('-') != std::string::npos)
+		{
+			tm.tm_year = year - 1900;
+			tm.tm_mon = month - 1;
+			tm.tm_mday = day;
+			tm.tm_hour = hour;
+			tm.tm_min = minute;
+			tm.tm_sec = second;
+		}
+		else if (std::sscanf(text.c_str(), "%d:%d:%d", &hour, &minute, &second) >= 2)
+		{
+			tm.tm_hour = hour;
+			tm.tm_min = minute;
+			tm.tm_sec = second;
+		}
+		else
+			return false;
+
+		tm.tm_isdst = -1; // let mktime figure out daylight saving time
+		std::time_t t = std::mktime(&tm);
+		if (t == static_cast<std::time_t>(-1))
+			return false;
+
+		out = LogQuery::Clock::from_time_t(t);
+		return true;
+	}
+
+	// Accepts "<number><s|m|h|d>", e.g. "90s", "10m", "2h"
+	bool ParseDuration(std::string_view text, std::chrono::seconds& out)
+	{
+		if (text.size() < 2)
+			return false;
+
+		long long value = 0;
+		for (size_t i = 0; i + 1 < text.size(); ++i)
+		{
+			if (!std::isdigit(static_cast<unsigned char>(text[i])))
+				return false;
+			value = value * 10 + (text[i] - '0');
+		}
+
+		switch (std::tolower(static_cast<unsigned char>(text.back())))
+		{
+		case 's': out = std::chrono::seconds(value); return true;
+		case 'm': out = std::chrono::minutes(value); return true;
+		case 'h': out = std::chrono::hours(value); return true;
+		case 'd': out = std::chrono::hours(24 * value); return true;
+		default:  return false;
+		}
+	}
+
+	// Extracts object and name from the prefix written by Logger::Log1/2/3:
+	//   'Object func(): ...', 'Object "Name" func(): ...', 'Caller >> Object "Name" func(): ...'
+	void SplitPrefix(std::string_view message, std::string_view& object, std::string_view& name)
+	{
+		object = {};
+		name = {};
+
+		size_t funcEnd = message.find("(): ");
+		if (funcEnd == std::string_view::npos)
+			return;
+
+		std::string_view prefix = message.substr(0, funcEnd);
+		size_t callerSep = prefix.find(" >> ");
+		if (callerSep != std::string_view::npos)
+			prefix.remove_prefix(callerSep + 4);
+
+		// The last token is the function name, everything before it is object and name
+		size_t funcStart = prefix.rfind(' ');
+		if (funcStart == std::string_view::npos)
+			return;
+
+		std::string_view objectAndName = prefix.substr(0, funcStart);
+		size_t quote = objectAndName.find(" \"");
+		if (quote != std::string_view::npos && objectAndName.back() == '"')
+		{
+			name = objectAndName.substr(quote + 2, objectAndName.size() - quote - 3);
+			objectAndName = objectAndName.substr(0, quote);
+		}
+		object = objectAndName;
+	}
+}
+
+LogQuery LogQuery::Parse(std::string_view text, Clock::time_point now)
+{
+	LogQuery query;
+	uint32_t levels = 0;
+
+	for (const std::string& token : Tokenize(text))
+	{
+		std::string_view term = token;
+		auto takeValue = [&](std::string_view key) -> bool {
+			if (!StartsWithNoCase(term, key))
+				return false;
+			term.remove_prefix(key.size());
+			return true;
+			};
+
+		if (takeValue("level:"))
+		{
+			for (const std::string& part : SplitList(term))
+			{
+				if (!ParseLevel(part, levels))
+					query.error = "Unknown level '" + part + "'";
+			}
+		}
+		else if (takeValue("obj:"))
+			query.objectPrefix = std::string(term);
+		else if (takeValue("obj="))
+		{
+			// Only looked up: the query is parsed on every keystroke and the symbol table never shrinks
+			query.objectName = std::string(term);
+			query.objectId = LogSymbols::Find(term);
+		}
+		else if (takeValue("name:"))
+			query.namePrefix = std::string(term);
+		else if (takeValue("thread="))
+		{
+			// A number is the thread index, anything else its name (looked up only, like obj=)
+			unsigned index = 0;
+			const auto [end, ec] = std::from_chars(term.data(), term.data() + term.size(), index);
+			if (ec == std::errc() && end == term.data() + term.size() && index != 0 && index <= LogThreads::MAX_THREADS)
+				query.threadIndex = static_cast<uint16_t>(index);
+			else
+			{
+				query.threadName = std::string(term);
+				query.threadNameId = LogSymbols::Find(term);
+			}
+		}
+		else if (StartsWithNoCase(term, "after:") || StartsWithNoCase(term, "before:"))
+		{
+			const bool isAfter = takeValue("after:");
+			if (!isAfter)
+				takeValue("before:");
+
+			Clock::time_point tp;
+			if (!ParseTimePoint(std::string(term), now, tp))
+				query.error = "Invalid time '" + std::string(term) + "'";
+			else if (isAfter)
+				query.after = tp;
+			else
+				query.before = tp;
+		}
+		else if (takeValue("last:"))
+		{
+			std::chrono::seconds duration;
+			if (!ParseDuration(term, duration))
+				query.error = "Invalid duration '" + std::string(term) + "'";
+			else
+				query.after = now - duration;
+		}
+		else if (takeValue("re:"))
+		{
+			if (term.size() >= 2 && term.front() == '/' && term.back() == '/')
+				term = term.substr(1, term.size() - 2);
+			if (term.empty())
+				continue;
+
+			try
+			{
+				query.regex = std::make_shared<const std::regex>(std::string(term),
+					std::regex::ECMAScript | std::regex::icase | std::regex::optimize);
+			}
+			catch (const std::regex_error& e)
+			{
+				query.error = std::string("Invalid regex: ") + e.what();
+			}
+		}
+		else if (term.size() > 1 && term.front() == '-')
+			query.excludeTerms.emplace_back(term.substr(1));
+		else
+		{
+			std::vector<std::string> alternatives = SplitList(term);
+			if (!alternatives.empty())
+				query.includeTerms.push_back(std::move(alternatives));
+		}
+	}
+
+	if (levels != 0)
+		query.levelMask = levels;
+
+	return query;
+}
+
+bool LogQuery::IsEmpty() const
+{
+	return IsLevelTimeOnly() && levelMask == ALL_LOG_LEVELS
+		&& after == Clock::time_point::min() && before == Clock::time_point::max();
+}
+
+bool LogQuery::IsLevelTimeOnly() const
+{
+	return includeTerms.empty() && excludeTerms.empty() && objectPrefix.empty() && namePrefix.empty() && objectName.empty()
+		&& threadIndex == 0 && threadName.empty() && !regex;
+}
+
+bool LogQuery::Matches(const LogMessage& message) const
+{
+	fmt::memory_buffer scratch;
+	return MatchesLevelAndTime(message.level, message.timestamp) && MatchesObject(message.objectId) && MatchesThread(message.threadIndex)
+		&& MatchesText(message.GetText(scratch));
+}
+
+bool LogQuery::MatchesText(std::string_view text) const
+{
+	if (!objectPrefix.empty() || !namePrefix.empty())
+	{
+		std::string_view object, name;
+		SplitPrefix(text, object, name);
+		if (!objectPrefix.empty() && !StartsWithNoCase(object, objectPrefix))
+			return false;
+		if (!namePrefix.empty() && !StartsWithNoCase(name, namePrefix))
+			return false;
+	}
+
+	for (const std::string& term : excludeTerms)
+	{
+		if (ContainsNoCase(text, term))
+			return false;
+	}
+
+	for (const auto& alternatives : includeTerms)
+	{
+		bool any = false;
+		for (const std::string& term : alternatives)
+		{
+			if (ContainsNoCase(text, term))
+			{
+				any = true;
+				break;
+			}
+		}
+		if (!any)
+			return false;
+	}
+
+	if (regex && !std::regex_search(text.begin(), text.end(), *regex))
+		return false;
+
+	return true;
+}
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <string>
+#include <string_view>
+#include <vector>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <regex>
+
+#include "LogMessage.h"
+#include "LogThreads.h"
+#include "LogSymbols.h"
+
+// Parsed search query for the log viewer.
+//
+// Syntax (whitespace separated terms, all terms must match):
+//   motor            message contains "motor" (case-insensitive)
+//   motor,servo      message contains "motor" OR "servo"
+//   -heartbeat       message must not contain "heartbeat"
+//   level:error,warn only the given levels (info, warn, error, debug)
+//   obj:Sen          object prefix (LOG1..LOG3) starts with "Sen"
+//   obj=Sensor       object is exactly "Sensor" (compares interned ids, see LogSymbols; messages of the ring only)
+//   name:Le          name prefix (LOG2/LOG3, the quoted part) starts with "Le"
+//   thread=Main      logged by the thread named "Main" (Logger::SetThreadName()), thread=3 by thread index 3
+//   after:14:30      timestamp >= today 14:30 (also "2025-10-19T14:30:00" or "2025-10-19")
+//   before:14:45     timestamp <  today 14:45
+//   last:10m         timestamp within the last 10 s/m/h/d
+//   re:/a.*b/        ECMAScript regex (case-insensitive), also re:a.*b
+// Terms can be quoted to include spaces: "connection lost" or re:"a b".
+struct LogQuery
+{
+	using Clock = std::chrono::system_clock;
+
+	uint32_t levelMask = ALL_LOG_LEVELS;
+	Clock::time_point after = Clock::time_point::min();
+	Clock::time_point before = Clock::time_point::max();
+
+	std::vector<std::vector<std::string>> includeTerms; // AND over groups, OR within a group
+	std::vector<std::string> excludeTerms;
+	std::string objectPrefix;
+	std::string objectName; // obj= value, empty = any
+	uint32_t objectId = 0;  // Its LogSymbols id if already interned (never interned by a query), else 0
+	std::string namePrefix;
+	uint16_t threadIndex = 0;    // LogThreads index for thread=N, 0 = any
+	std::string threadName;      // thread=Name, empty = any
+	uint32_t threadNameId = 0;   // Its LogSymbols id if already interned, else 0
+	std::shared_ptr<const std::regex> regex; // shared so copies of a query stay cheap
+
+	std::string error; // Non-empty if the query text could not be parsed completely
+
+	// Parses a query string; 'now' anchors relative times (last:) and clock times (after:/before:)
+	static LogQuery Parse(std::string_view text, Clock::time_point now = Clock::now());
+
+	// True if the query does not restrict anything (every message matches)
+	bool IsEmpty() const;
+
+	// True if only level and time restrictions are set (no text inspection needed)
+	bool IsLevelTimeOnly() const;
+
+	bool Matches(const LogMessage& message) const;
+	bool MatchesLevelAndTime(LogLevel level, Clock::time_point timestamp) const
+	{
+		return (levelMask & LevelBit(level)) != 0 && timestamp >= after && timestamp < before;
+	}
+	bool MatchesText(std::string_view text) const;
+	bool MatchesObject(uint32_t messageObjectId) const
+	{
+		if (objectName.empty())
+			return true;
+		if (objectId != 0)
+			return messageObjectId == objectId;
+		// Object unknown when parsing: compare the text of ids interned since
+		return messageObjectId != 0 && LogSymbols::GetText(messageObjectId) == objectName;
+	}
+	bool MatchesThread(uint16_t messageThreadIndex) const
+	{
+		if (threadIndex != 0 && messageThreadIndex != threadIndex)
+			return false;
+		if (threadName.empty())
+			return true;
+		const uint32_t nameId = LogThreads::GetNameId(messageThreadIndex);
+		if (threadNameId != 0)
+			return nameId == threadNameId;
+		// Name unknown when parsing: compare the names given since
+		return nameId != 0 && LogSymbols::GetText(nameId) == threadName;
+	}
+};
@@ -0,0 +1,58 @@
+#include "LogRateSeries.h"
+
+#include <algorithm>
+
+void LogRateSeries::Record(LogLevel level, int64_t epochSecond, uint64_t sequence)
+{
+	if (epochSecond < 0)
+		return;
+
+	Slot& slot = slots[static_cast<size_t>(epochSecond) % WINDOW_SECONDS];
+
+	int64_t slotSecond = slot.second.load(std::memory_order_acquire);
+	while (slotSecond != epochSecond)
+	{
+		// The slot already holds a newer second: this message is older than the window
+		if (slotSecond > epochSecond)
+			return;
+
+		// First message of this second claims the slot and clears what is left from an hour ago
+		if (slot.second.compare_exchange_weak(slotSecond, epochSecond, std::memory_order_acq_rel))
+		{
+			for (auto& count : slot.counts)
+				count.store(0, std::memory_order_relaxed);
+			slot.firstSequence.store(NO_SEQUENCE, std::memory_order_relaxed);
+			break;
+		}
+	}
+
+	slot.counts[static_cast<size_t>(level) % LOG_LEVEL_COUNT].fetch_add(1, std::memory_order_relaxed);
+
+	uint64_t first = slot.firstSequence.load(std::memory_order_relaxed);
+	while (sequence < first && !slot.firstSequence.compare_exchange_weak(first, sequence, std::memory_order_relaxed))
+	{
+	}
+}
+
+void LogRateSeries::Snapshot(int64_t lastSecond, size_t seconds, std::vector<Bucket>& out) const
+{
+	seconds = std::min(seconds, WINDOW_SECONDS);
+	out.resize(seconds);
+
+	for (size_t i = 0; i < seconds; ++i)
+	{
+		Bucket& bucket = out[i];
+		bucket = Bucket{};
+		bucket.second = lastSecond - static_cast<int64_t>(seconds - 1 - i);
+		if (bucket.second < 0)
+			continue;
+
+		const Slot& slot = slots[static_cast<size_t>(bucket.second) % WINDOW_SECONDS];
+		if (slot.second.load(std::memory_order_acquire) != bucket.second)
+			continue;
+
+		for (size_t level = 0; level < LOG_LEVEL_COUNT; ++level)
+			bucket.counts[level] = slot.counts[level].load(std::memory_order_relaxed);
+		bucket.firstSequence = slot.firstSequence.load(std::memory_order_relaxed);
+	}
+}
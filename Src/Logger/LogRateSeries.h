@@ -0,0 +1,54 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+#include "LogMessage.h"
+
+// Per-level message counts in 1-second buckets for the last hour (fixed ~115 KB, no allocation).
+//
+// Recording is lock-free: the bucket of a second is claimed with a CAS on its timestamp when the
+// ring wraps around, afterwards producers only do relaxed atomic increments. A message racing with
+// the reset of its bucket may be lost from the count, which is fine for a rate display.
+// Each bucket also remembers the lowest ring sequence pushed in that second, so the GUI can jump there.
+class LogRateSeries
+{
+public:
+	static constexpr size_t WINDOW_SECONDS = 3600;
+	static constexpr uint64_t NO_SEQUENCE = UINT64_MAX;
+
+	struct Bucket
+	{
+		int64_t second = 0; // Seconds since epoch
+		std::array<uint32_t, LOG_LEVEL_COUNT> counts{};
+		uint64_t firstSequence = NO_SEQUENCE;
+
+		uint32_t Total() const { return counts[0] + counts[1] + counts[2] + counts[3]; }
+	};
+
+	static int64_t ToEpochSecond(std::chrono::system_clock::time_point tp)
+	{
+		return std::chrono::floor<std::chrono::seconds>(tp.time_since_epoch()).count();
+	}
+
+	// Messages older than the window are ignored
+	void Record(LogLevel level, int64_t epochSecond, uint64_t sequence);
+	void Record(const LogMessage& message) { Record(message.level, ToEpochSecond(message.timestamp), message.sequence); }
+
+	// Replaces 'out' with the 'seconds' buckets ending at 'lastSecond' (inclusive), oldest first.
+	// Seconds without messages (or already outside the window) come back with zero counts.
+	void Snapshot(int64_t lastSecond, size_t seconds, std::vector<Bucket>& out) const;
+
+private:
+	struct Slot
+	{
+		std::atomic<int64_t> second{ -1 };
+		std::array<std::atomic<uint32_t>, LOG_LEVEL_COUNT> counts{};
+		std::atomic<uint64_t> firstSequence{ NO_SEQUENCE };
+	};
+
+	std::array<Slot, WINDOW_SECONDS> slots;
+};
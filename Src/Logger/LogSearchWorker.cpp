@@ -0,0 +1,217 @@
+#include "LogSearchWorker.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include "Utils/RedrawScheduler.h"
+
+LogSearchWorker::LogSearchWorker(const CircularLogBuffer& source)
+	: source(source)
+{
+	workerThread = std::thread(&LogSearchWorker::Run, this);
+}
+
+LogSearchWorker::~LogSearchWorker()
+{
+	{
+		std::lock_guard lock(jobMutex);
+		stopFlag = true;
+	}
+	generation.fetch_add(1, std::memory_order_acq_rel); // aborts a running scan
+	jobCv.notify_all();
+
+	if (workerThread.joinable())
+		workerThread.join();
+}
+
+uint64_t LogSearchWorker::Submit(const std::string& queryText)
+{
+	uint64_t newGeneration;
+	{
+		std::lock_guard lock(jobMutex);
+		pendingQueryText = queryText;
+		hasPendingJob = true;
+		newGeneration = generation.fetch_add(1, std::memory_order_acq_rel) + 1;
+		busy.store(true, std::memory_order_relaxed);
+		progress.store(0.0f, std::memory_order_relaxed);
+	}
+	{
+		std::lock_guard lock(resultMutex);
+		results.clear();
+		resultGeneration = newGeneration;
+	}
+	jobCv.notify_one();
+	return newGeneration;
+}
+
+void LogSearchWorker::Cancel()
+{
+	uint64_t newGeneration;
+	{
+		std::lock_guard lock(jobMutex);
+		hasPendingJob = false;
+		queryError.clear();
+		newGeneration = generation.fetch_add(1, std::memory_order_acq_rel) + 1;
+		busy.store(false, std::memory_order_relaxed);
+		progress.store(1.0f, std::memory_order_relaxed);
+	}
+	{
+		std::lock_guard lock(resultMutex);
+		results.clear();
+		resultGeneration = newGeneration;
+	}
+	jobCv.notify_one();
+}
+
+size_t LogSearchWorker::FetchResults(std::vector<LogMessage>& out)
+{
+	std::lock_guard lock(resultMutex);
+	const size_t count = results.size();
+	if (out.empty())
+		out.swap(results); // common case for the first chunk: no copy at all
+	else
+	{
+		out.insert(out.end(), std::make_move_iterator(results.begin()), std::make_move_iterator(results.end()));
+		results.clear();
+	}
+	return count;
+}
+
+std::string LogSearchWorker::GetError() const
+{
+	std::lock_guard lock(jobMutex);
+	return queryError;
+}
+
+uint64_t LogSearchWorker::Scan(const LogQuery& query, uint64_t jobGeneration, uint64_t from, bool reportProgress)
+{
+	const uint64_t end = source.GetTotalPushed();
+	const uint64_t oldest = end - std::min<uint64_t>(end, source.GetSize());
+	if (from < oldest)
+		from = oldest;
+	if (from >= end)
+		return from;
+
+	const double total = static_cast<double>(end - from);
+	const uint64_t start = from;
+
+	const int64_t minNs = ToEpochNanoseconds(query.after);
+	const int64_t maxNs = ToEpochNanoseconds(query.before);
+	const bool textMatching = !query.IsLevelTimeOnly();
+
+	ColumnarLogStore chunk;
+	std::vector<uint32_t> candidates;
+	std::vector<LogMessage> matches;
+	fmt::memory_buffer scratch;
+	chunk.Reserve(SCAN_CHUNK_SIZE, SCAN_CHUNK_SIZE * 64);
+	candidates.reserve(SCAN_CHUNK_SIZE);
+
+	while (from < end)
+	{
+		if (IsCancelled(jobGeneration))
+			return start;
+
+		chunk.Clear();
+		const size_t wanted = static_cast<size_t>(std::min<uint64_t>(SCAN_CHUNK_SIZE, end - from));
+		if (source.CopySince(from, wanted, chunk) == 0)
+			break;
+
+		// Level and time are checked on the packed columns (SIMD), text only for the remaining candidates
+		candidates.clear();
+		chunk.ScanLevelTime(query.levelMask, minNs, maxNs, candidates);
+		for (uint32_t index : candidates)
+		{
+			if (chunk.Sequence(index) >= end)
+				break; // Stay within the snapshot taken at the start of this scan
+			if (!textMatching || (query.MatchesObject(chunk.ObjectId(index)) && query.MatchesThread(chunk.ThreadIndex(index)) && query.MatchesText(chunk.DisplayText(index, scratch))))
+				matches.push_back(chunk.ToLogMessage(index));
+		}
+		from = std::min(chunk.Sequence(chunk.Size() - 1) + 1, end);
+
+		// Publish this chunk so the GUI can show first matches while the scan continues
+		if (!matches.empty())
+		{
+			std::lock_guard lock(resultMutex);
+			if (resultGeneration != jobGeneration)
+				return start;
+			results.insert(results.end(), std::make_move_iterator(matches.begin()), std::make_move_iterator(matches.end()));
+			matches.clear();
+			gear::RedrawScheduler::RequestRedraw();
+		}
+
+		if (reportProgress)
+			progress.store(static_cast<float>(static_cast<double>(from - start) / total), std::memory_order_relaxed);
+	}
+	return end;
+}
+
+void LogSearchWorker::Run()
+{
+	LogQuery query;
+	uint64_t jobGeneration = 0;
+	uint64_t nextSequence = 0;
+	bool following = false;
+
+	while (true)
+	{
+		bool newJob = false;
+		std::string queryText;
+		{
+			std::unique_lock lock(jobMutex);
+			if (following)
+				jobCv.wait_for(lock, FOLLOW_INTERVAL, [this]() { return stopFlag || hasPendingJob; });
+			else
+				jobCv.wait(lock, [this]() { return stopFlag || hasPendingJob; });
+
+			if (stopFlag)
+				return;
+
+			if (hasPendingJob)
+			{
+				hasPendingJob = false;
+				jobGeneration = generation.load(std::memory_order_acquire);
+				queryText = pendingQueryText;
+				newJob = true;
+			}
+			else if (IsCancelled(jobGeneration))
+			{
+				following = false; // Cancel() was called, wait for the next Submit()
+				continue;
+			}
+		}
+
+		if (newJob)
+		{
+			// Parse outside the lock, compiling a regex can take a moment
+			query = LogQuery::Parse(queryText);
+			{
+				std::lock_guard lock(jobMutex);
+				queryError = query.error;
+			}
+			nextSequence = 0;
+			following = false;
+		}
+
+		const bool initialScan = !following;
+		const uint64_t scanned = Scan(query, jobGeneration, nextSequence, initialScan);
+
+		if (IsCancelled(jobGeneration))
+		{
+			following = false;
+			continue;
+		}
+
+		nextSequence = scanned;
+		following = true;
+		if (initialScan)
+		{
+			// Checked under jobMutex so a Submit() racing with the end of this scan keeps its busy state
+			std::lock_guard lock(jobMutex);
+			if (!IsCancelled(jobGeneration))
+			{
+				progress.store(1.0f, std::memory_order_relaxed);
+				busy.store(false, std::memory_order_relaxed);
+			}
+		}
+	}
+}
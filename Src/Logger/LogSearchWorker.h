@@ -0,0 +1,84 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <atomic>
+#include <cstdint>
+
+#include "LogMessage.h"
+#include "LogQuery.h"
+#include "CircularLogBuffer.h"
+#include "ColumnarLogStore.h"
+
+// Runs log queries on a background thread so the GUI never scans the log store itself.
+//
+// Submit() cancels the running query and starts a new one over the entries currently in the
+// source buffer. Matches are streamed back in chunks via FetchResults(). After the initial scan the
+// worker keeps following the source and appends matches for newly pushed messages, until the
+// next Submit() or Cancel().
+class LogSearchWorker
+{
+public:
+	static constexpr size_t SCAN_CHUNK_SIZE = 4096;   // Entries copied per source lock
+	static constexpr auto FOLLOW_INTERVAL = std::chrono::milliseconds(100);
+
+	explicit LogSearchWorker(const CircularLogBuffer& source);
+	~LogSearchWorker();
+
+	LogSearchWorker(const LogSearchWorker&) = delete;
+	LogSearchWorker& operator=(const LogSearchWorker&) = delete;
+
+	// Starts a new query; pending and future results of the previous query are discarded.
+	// Returns the generation of the new query.
+	uint64_t Submit(const std::string& queryText);
+
+	// Stops the current query (including follow mode) and discards its pending results.
+	void Cancel();
+
+	// Moves all matches found since the last call into 'out' (appended, in sequence order).
+	// Returns the number of appended entries. Results of older generations are never returned.
+	size_t FetchResults(std::vector<LogMessage>& out);
+
+	// Progress of the initial scan in [0, 1]. 1 once the worker is following new entries.
+	float GetProgress() const { return progress.load(std::memory_order_relaxed); }
+
+	// True while the initial scan of the current query is running
+	bool IsBusy() const { return busy.load(std::memory_order_relaxed); }
+
+	uint64_t GetGeneration() const { return generation.load(std::memory_order_acquire); }
+
+	// Parse error of the current query, empty if none
+	std::string GetError() const;
+
+private:
+	void Run();
+	bool IsCancelled(uint64_t jobGeneration) const { return generation.load(std::memory_order_acquire) != jobGeneration; }
+
+	// Scans [from, source end) and publishes matches. Returns the next sequence to scan,
+	// or 'from' unchanged if the job was cancelled.
+	uint64_t Scan(const LogQuery& query, uint64_t jobGeneration, uint64_t from, bool reportProgress);
+
+	const CircularLogBuffer& source;
+
+	// Job state, protected by jobMutex
+	mutable std::mutex jobMutex;
+	std::condition_variable jobCv;
+	std::string pendingQueryText;
+	bool hasPendingJob = false;
+	bool stopFlag = false;
+	std::string queryError;
+
+	// Results, protected by resultMutex
+	std::mutex resultMutex;
+	std::vector<LogMessage> results;
+	uint64_t resultGeneration = 0;
+
+	std::atomic<uint64_t> generation{ 0 };
+	std::atomic<float> progress{ 1.0f };
+	std::atomic<bool> busy{ false };
+
+	std::thread workerThread;
+};
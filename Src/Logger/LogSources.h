@@ -0,0 +1,84 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <cstdint>
+
+#include "LogMessage.h"
+
+// Registry of log sources shown in the Logger window (LogMessage::sourceId).
+// Id 0 is GEAR itself; other sources (e.g. tailed log files) register a name and a display color.
+// Ids are never reused (ring entries keep them), so once the registry is full further sources share
+// OTHER_SOURCE instead of being shown as GEAR.
+//
+// Names are written once before the id is published, so GetName() is lock-free from any thread.
+// Colors are only meant to be changed and read by the GUI thread.
+class LogSources
+{
+public:
+	static constexpr uint16_t GEAR_SOURCE = 0;
+	static constexpr size_t MAX_SOURCES = 256;
+	static constexpr uint16_t OTHER_SOURCE = MAX_SOURCES - 1; // Registered by the first source that doesn't fit
+	static constexpr const char* OTHER_SOURCE_NAME = "(other sources)";
+
+	// Returns the id of the source with this name, registering it if needed.
+	// Returns OTHER_SOURCE if the registry is full.
+	static uint16_t Register(const std::string& name, LogMessageColor color)
+	{
+		std::lock_guard lock(registerMutex);
+
+		const size_t count = sourceCount.load(std::memory_order_relaxed);
+		for (size_t id = 0; id < count; ++id)
+		{
+			if (names[id] == name)
+				return static_cast<uint16_t>(id);
+		}
+		if (count >= OTHER_SOURCE)
+		{
+			if (count == OTHER_SOURCE)
+			{
+				names[OTHER_SOURCE] = OTHER_SOURCE_NAME;
+				colors[OTHER_SOURCE] = { 0.6f, 0.6f, 0.6f };
+				sourceCount.store(MAX_SOURCES, std::memory_order_release);
+			}
+			return OTHER_SOURCE;
+		}
+
+		names[count] = name;
+		colors[count] = color;
+		sourceCount.store(count + 1, std::memory_order_release);
+		return static_cast<uint16_t>(count);
+	}
+
+	static size_t GetCount() { return sourceCount.load(std::memory_order_acquire); }
+
+	static const std::string& GetName(uint16_t id)
+	{
+		return id < GetCount() ? names[id] : names[GEAR_SOURCE];
+	}
+
+	static LogMessageColor GetColor(uint16_t id) { return id < GetCount() ? colors[id] : colors[GEAR_SOURCE]; }
+	static void SetColor(uint16_t id, LogMessageColor color)
+	{
+		if (id < GetCount())
+			colors[id] = color;
+	}
+
+	// Distinct default colors for new sources
+	static LogMessageColor DefaultColor(size_t index)
+	{
+		static constexpr LogMessageColor palette[] = {
+			{ 0.4f, 0.9f, 0.6f }, { 0.9f, 0.6f, 0.3f }, { 0.5f, 0.8f, 1.0f }, { 0.9f, 0.5f, 0.9f },
+			{ 0.8f, 0.8f, 0.4f }, { 0.4f, 0.9f, 0.9f }, { 1.0f, 0.6f, 0.6f }, { 0.7f, 0.7f, 1.0f },
+		};
+		return palette[index % (sizeof(palette) / sizeof(palette[0]))];
+	}
+
+private:
+	static inline std::mutex registerMutex;
+	static inline std::array<std::string, MAX_SOURCES> names{ "GEAR" };
+	static inline std::array<LogMessageColor, MAX_SOURCES> colors{};
+	static inline std::atomic<size_t> sourceCount{ 1 };
+};
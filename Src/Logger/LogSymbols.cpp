@@ -0,0 +1,143 @@
+#include "LogSymbols.h"
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+
+namespace
+{
+	struct Symbol
+	{
+		std::string text;
+		uint64_t hash = 0;
+		uint32_t id = LogSymbols::NONE;
+		std::atomic<uint8_t> roles{ 0 };
+	};
+
+	// Power of two, at most half full, so every probe sequence ends at an empty slot
+	constexpr size_t TABLE_SIZE = LogSymbols::MAX_SYMBOLS * 2;
+	static_assert((TABLE_SIZE & (TABLE_SIZE - 1)) == 0, "TABLE_SIZE must be a power of two");
+
+	// Constant-initialized, so logging from static constructors of other translation units is safe
+	std::array<std::atomic<Symbol*>, TABLE_SIZE> table{};
+	std::array<std::atomic<Symbol*>, LogSymbols::MAX_SYMBOLS + 1> symbolsById{}; // Index 0 = NONE
+	std::atomic<uint32_t> symbolCount{ 0 };
+
+	// Symbols are never freed (they stay reachable through the tables): prefixes are rendered from their texts
+	// until the file writer has drained its queue, also during static destruction
+	std::mutex registerMutex;
+
+	// FNV-1a
+	uint64_t Hash(std::string_view text)
+	{
+		uint64_t hash = 14695981039346656037ull;
+		for (char c : text)
+		{
+			hash ^= static_cast<uint8_t>(c);
+			hash *= 1099511628211ull;
+		}
+		return hash;
+	}
+
+	// Returns the symbol of 'text' or nullptr; 'emptySlot' receives the slot that ended the probe
+	Symbol* Lookup(std::string_view text, uint64_t hash, size_t* emptySlot = nullptr)
+	{
+		for (size_t i = static_cast<size_t>(hash) & (TABLE_SIZE - 1);; i = (i + 1) & (TABLE_SIZE - 1))
+		{
+			Symbol* symbol = table[i].load(std::memory_order_acquire);
+			if (!symbol)
+			{
+				if (emptySlot)
+					*emptySlot = i;
+				return nullptr;
+			}
+			if (symbol->hash == hash && symbol->text == text)
+				return symbol;
+		}
+	}
+
+	uint32_t UseAs(Symbol& symbol, LogSymbols::Role role)
+	{
+		// Load first, so the common case doesn't write to a cache line shared by all threads
+		if ((symbol.roles.load(std::memory_order_relaxed) & role) != role)
+			symbol.roles.fetch_or(role, std::memory_order_relaxed);
+		return symbol.id;
+	}
+}
+
+uint32_t LogSymbols::Intern(std::string_view text, Role role)
+{
+	const uint64_t hash = Hash(text);
+	if (Symbol* symbol = Lookup(text, hash))
+		return UseAs(*symbol, role);
+
+	std::lock_guard lock(registerMutex);
+
+	// Registered by another thread in the meantime?
+	size_t slot = 0;
+	if (Symbol* symbol = Lookup(text, hash, &slot))
+		return UseAs(*symbol, role);
+
+	const uint32_t count = symbolCount.load(std::memory_order_relaxed);
+	if (count >= MAX_SYMBOLS)
+		return NONE;
+
+	auto symbol = std::make_unique<Symbol>();
+	symbol->text = text;
+	symbol->hash = hash;
+	symbol->id = count + 1;
+	symbol->roles.store(role, std::memory_order_relaxed);
+
+	// Fully built before it becomes reachable
+	symbolsById[symbol->id].store(symbol.get(), std::memory_order_release);
+	table[slot].store(symbol.get(), std::memory_order_release);
+	symbolCount.store(count + 1, std::memory_order_release);
+
+	symbol.release();
+	return count + 1;
+}
+
+uint32_t LogSymbols::Find(std::string_view text)
+{
+	const Symbol* symbol = Lookup(text, Hash(text));
+	return symbol ? symbol->id : NONE;
+}
+
+std::string_view LogSymbols::GetText(uint32_t id)
+{
+	if (id == NONE || id > MAX_SYMBOLS)
+		return {};
+	const Symbol* symbol = symbolsById[id].load(std::memory_order_acquire);
+	return symbol ? std::string_view(symbol->text) : std::string_view();
+}
+
+uint8_t LogSymbols::GetRoles(uint32_t id)
+{
+	if (id == NONE || id > MAX_SYMBOLS)
+		return ROLE_NONE;
+	const Symbol* symbol = symbolsById[id].load(std::memory_order_acquire);
+	if (!symbol)
+		return ROLE_NONE;
+	return symbol->roles.load(std::memory_order_relaxed);
+}
+
+size_t LogSymbols::GetCount()
+{
+	return symbolCount.load(std::memory_order_acquire);
+}
+
+std::vector<uint32_t> LogSymbols::List(Role role)
+{
+	std::vector<uint32_t> ids;
+	const size_t count = GetCount();
+	for (uint32_t id = 1; id <= count; ++id)
+	{
+		if ((GetRoles(id) & role) != 0)
+			ids.push_back(id);
+	}
+	std::sort(ids.begin(), ids.end(), [](uint32_t a, uint32_t b) { return GetText(a) < GetText(b); });
+	return ids;
+}
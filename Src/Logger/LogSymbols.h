@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+// Interned object, name and caller strings of the LOG1..LOG3 prefixes (LogMessage::objectId, nameId, callerId).
+//
+// Every distinct string gets a dense 32-bit id (0 = none) that stays valid for the lifetime of the process.
+// Looking up a known string is lock-free: one hash and a short probe in an open-addressing table whose slots
+// are published with release stores. Only the first registration of a string takes a mutex. The table has a
+// fixed size; once it is full Intern() returns NONE for new strings (their text is still in the message).
+class LogSymbols
+{
+public:
+	static constexpr uint32_t NONE = 0;
+	static constexpr size_t MAX_SYMBOLS = 8192;
+
+	// Roles a symbol was logged in, so the GUI can list objects only
+	enum Role : uint8_t
+	{
+		ROLE_NONE = 0,
+		ROLE_OBJECT = 1,
+		ROLE_NAME = 2,
+		ROLE_CALLER = 4,
+		ROLE_SITE = 8    // Log site "Function(): format string" (LogGroups)
+	};
+
+	static uint32_t Intern(std::string_view text, Role role = ROLE_NONE);
+
+	// Id of an already interned string, NONE otherwise
+	static uint32_t Find(std::string_view text);
+
+	// Text of 'id', empty for NONE and unknown ids. The view stays valid for the lifetime of the process.
+	static std::string_view GetText(uint32_t id);
+	static uint8_t GetRoles(uint32_t id);
+
+	// Valid ids are 1..GetCount()
+	static size_t GetCount();
+
+	// Ids of all symbols used in 'role', sorted by text
+	static std::vector<uint32_t> List(Role role);
+};
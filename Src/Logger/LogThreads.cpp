@@ -0,0 +1,34 @@
+#include "LogThreads.h"
+
+#include "LogSources.h"
+#include "LogSymbols.h"
+
+// Constant-initialized, so threads can log from static constructors of other translation units
+std::array<LogThreads::Slot, LogThreads::MAX_THREADS + 1> LogThreads::slots{};
+std::atomic<size_t> LogThreads::threadCount{ 0 };
+
+uint16_t LogThreads::Register()
+{
+	const size_t index = threadCount.fetch_add(1, std::memory_order_acq_rel) + 1;
+	return index <= MAX_THREADS ? static_cast<uint16_t>(index) : NONE;
+}
+
+void LogThreads::SetName(std::string_view name)
+{
+	const uint16_t index = Current();
+	if (index != NONE)
+		slots[index].nameId.store(LogSymbols::Intern(name), std::memory_order_release);
+}
+
+std::string LogThreads::GetName(uint16_t index)
+{
+	if (index == NONE || index > MAX_THREADS)
+		return {};
+	const uint32_t nameId = GetNameId(index);
+	return nameId != LogSymbols::NONE ? std::string(LogSymbols::GetText(nameId)) : "Thread " + std::to_string(index);
+}
+
+LogMessageColor LogThreads::GetColor(uint16_t index)
+{
+	return index == NONE ? LogMessageColor() : LogSources::DefaultColor(index - 1);
+}
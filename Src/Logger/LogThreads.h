@@ -0,0 +1,68 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "LogMessage.h"
+
+// Registry of the threads that log into GEAR (LogMessage::threadIndex).
+//
+// A thread gets a dense index on its first log call and keeps it in a thread_local, so every later call costs
+// one thread-local load. Indexes are never reused: messages in the ring keep pointing at the thread that wrote
+// them. Threads beyond MAX_THREADS all get NONE. Names are optional (Logger::SetThreadName()) and stored as
+// LogSymbols ids, so reading them is lock-free; unnamed threads show as "Thread N".
+//
+// Every thread also counts its messages in its own cache-line aligned slot, the Logger window diffs the
+// counts for per-thread rates.
+class LogThreads
+{
+public:
+	static constexpr uint16_t NONE = 0; // Messages of other sources, and threads beyond MAX_THREADS
+	static constexpr size_t MAX_THREADS = 4096;
+
+	// Index of the calling thread, registered by its first call
+	static uint16_t Current()
+	{
+		thread_local const uint16_t index = Register();
+		return index;
+	}
+
+	// Counts a message of the thread 'index'
+	static void Record(uint16_t index)
+	{
+		if (index != NONE)
+			slots[index].messages.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	// Names the calling thread (registering it if needed); also applies to its messages logged before
+	static void SetName(std::string_view name);
+
+	// Name of 'index', "Thread N" if unnamed, empty for NONE
+	static std::string GetName(uint16_t index);
+	// LogSymbols id of the name, LogSymbols::NONE if unnamed
+	static uint32_t GetNameId(uint16_t index) { return index != NONE && index <= MAX_THREADS ? slots[index].nameId.load(std::memory_order_acquire) : 0; }
+
+	static LogMessageColor GetColor(uint16_t index);
+
+	// Messages logged by 'index' so far
+	static uint64_t GetMessageCount(uint16_t index) { return index != NONE && index <= MAX_THREADS ? slots[index].messages.load(std::memory_order_relaxed) : 0; }
+
+	// Valid indexes are 1..GetCount()
+	static size_t GetCount() { return std::min<size_t>(threadCount.load(std::memory_order_acquire), MAX_THREADS); }
+
+private:
+	static uint16_t Register();
+
+	struct alignas(64) Slot
+	{
+		std::atomic<uint64_t> messages{ 0 };
+		std::atomic<uint32_t> nameId{ 0 };
+	};
+
+	static std::array<Slot, MAX_THREADS + 1> slots; // Index 0 = NONE
+	static std::atomic<size_t> threadCount;
+};
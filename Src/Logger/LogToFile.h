@@ -1,6 +1,6 @@
 #pragma once
 
-#include <fstream>
+#include <algorithm>
 #include <mutex>
 #include <filesystem>
 #include <string>
@@ -9,21 +9,47 @@
 #include <condition_variable>
 #include <atomic>
 #include <chrono>
+#include <ctime>
 #include <system_error>
 
-#include "LogMessage.h"
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#else
+#include <fstream>
+#endif
 
+#include "LogMessage.h"
+#include "LogFileIndex.h"
+#include "LogFileWriter.h"
+#include "LoggerMetrics.h"
+#include "LogAttachments.h"
+
+// Asynchronous file sink with rotation ("Gear.log" -> "Gear.log.1" ... "Gear.log.<maxBackups>").
+//
+// A segment is rotated before a line would push it past maxFileSizeKB (0 = no size limit) and/or when its
+// wall-clock interval ends (SetRotationInterval()). While idle the writer thread creates the next segment
+// ("Gear.log.next") ahead of time and, on Linux, reserves maxFileSizeKB for it with fallocate(), so segments
+// are not fragmented by line-by-line growth and a rotation is only the rename chain plus opening that file.
+// Producers only ever take the queue lock and are never blocked by a rotation.
+//
+// Lines go through a LogFileWriter (raw fd, private buffer) and are written out when the queue runs empty,
+// the buffer is full or the oldest buffered line is older than MAX_BUFFER_AGE. LogSyncMode selects when
+// they are additionally forced to the disk. The full text of truncated messages (LogAttachments) is written
+// by the same thread, see WriteAttachment().
 class LogToFile
 {
 public:
 	LogToFile(const std::string& folderPath,
 		const std::string& fileName,
-		size_t maxFileSizeKB = 10240,  // 10 MB default
-		int maxBackups = 5)
+		size_t maxFileSizeKB = 10240,  // 10 MB default, 0 = rotate by time only
+		int maxBackups = 5,
+		size_t indexIntervalKB = 64)   // Sidecar time index checkpoint distance, 0 = no index
 		: folder(folderPath),
 		filename(fileName),
 		maxFileSize(maxFileSizeKB * 1024),
 		maxBackups(maxBackups),
+		indexInterval(indexIntervalKB * 1024),
 		stopFlag(false)
 	{
 		// Create directory for logs if not exists
@@ -51,8 +77,43 @@ public:
 
 		// Close the log file safely
 		std::lock_guard lock(fileMutex);
-		if (logStream.is_open())
-			logStream.close();
+		CloseSegment();
+
+		// The prepared segment was never used
+		std::error_code ec;
+		if (nextSegmentReady)
+			std::filesystem::remove(NextSegmentPath(), ec);
+	}
+
+	// Time-based rotation: segments end at wall-clock boundaries that are multiples of 'interval' since local
+	// midnight (1 h = on the hour, 24 h = at midnight). Combines with the size limit; 0 = rotate by size only.
+	// A segment that received no lines in an interval is kept, empty files are never rotated.
+	void SetRotationInterval(std::chrono::seconds interval)
+	{
+		{
+			std::lock_guard lock(fileMutex);
+			rotationInterval = interval;
+			nextRotationTime = NextRotationTime(std::chrono::system_clock::now(), interval);
+		}
+		{
+			// Taking the queue lock orders the notify after the writer's check of the deadline
+			std::lock_guard lock(queueMutex);
+		}
+		cv.notify_all();
+	}
+
+	std::chrono::seconds GetRotationInterval()
+	{
+		std::lock_guard lock(fileMutex);
+		return rotationInterval;
+	}
+
+	// Durability tier, see LogSyncMode. 'period' applies to LogSyncMode::Periodic.
+	void SetSyncMode(LogSyncMode mode, std::chrono::milliseconds period = std::chrono::milliseconds(1000))
+	{
+		std::lock_guard lock(fileMutex);
+		syncMode = mode;
+		syncPeriod = period;
 	}
 
 	// Thread-safe enqueue of log lines; wakes background thread
@@ -68,13 +129,17 @@ public:
 			if (logQueue.size() >= MAX_QUEUE_SIZE)
 			{
 				// Remove the oldest entries to reduce memory pressure
-				for (size_t i = 0; i < CUT_SIZE && !logQueue.empty(); ++i)
+				uint64_t dropped = 0;
+				for (size_t i = 0; i < CUT_SIZE && !logQueue.empty(); ++i, ++dropped)
 					logQueue.pop();
 
 				// Force a memory shrink: std::queue/std::deque retains allocated memory even if emptied.
 				// This swap trick resets internal allocations and ensures memory is returned to the allocator.
+				// It discards the remaining entries as well.
+				dropped += logQueue.size();
 				std::queue<LogMessage> shrinked;
 				std::swap(logQueue, shrinked);
+				droppedMessages.fetch_add(dropped, std::memory_order_relaxed);
 
 				// Push a special log entry to inform that log entries were dropped.
 				logQueue.push(LogMessage{
@@ -85,10 +150,27 @@ public:
 
 			// Push the current log message and notify the consumer thread
 			logQueue.push(message);
+			UpdateQueueDepth(logQueue.size());
 		}
 		cv.notify_one();
 	}
 
+	// Queues 'payload' for 'target' at an offset reserved with LogAttachments::Reserve(); the writer thread writes
+	// it before the lines queued after it. False if MAX_ATTACHMENT_QUEUE_BYTES are already pending (it is dropped).
+	static constexpr size_t MAX_ATTACHMENT_QUEUE_BYTES = 64 * 1024 * 1024;
+	bool WriteAttachment(LogAttachments& target, uint64_t offset, std::string payload)
+	{
+		{
+			std::lock_guard lock(queueMutex);
+			if (attachmentQueueBytes + payload.size() > MAX_ATTACHMENT_QUEUE_BYTES)
+				return false;
+			attachmentQueueBytes += payload.size();
+			attachmentQueue.push(PendingAttachment{ &target, offset, std::move(payload) });
+		}
+		cv.notify_one();
+		return true;
+	}
+
 	// Overload: write by std::string
 	void Write(const std::string& msg)
 	{
@@ -101,31 +183,226 @@ public:
 		Write(LogMessage(LogLevel::Info, std::string(msg)));
 	}
 
+	// Lock-free copy of the writer's counters
+	LogFileStats GetStats() const
+	{
+		LogFileStats stats;
+		stats.queueDepth = queueDepth.load(std::memory_order_relaxed);
+		stats.queueHighWater = queueHighWater.load(std::memory_order_relaxed);
+		stats.droppedMessages = droppedMessages.load(std::memory_order_relaxed);
+		stats.linesWritten = linesWritten.load(std::memory_order_relaxed);
+		stats.bytesWritten = bytesWritten.load(std::memory_order_relaxed);
+		stats.rotations = rotations.load(std::memory_order_relaxed);
+		stats.lastRotationNs = lastRotationNs.load(std::memory_order_relaxed);
+		stats.maxRotationNs = maxRotationNs.load(std::memory_order_relaxed);
+		stats.syncs = syncs.load(std::memory_order_relaxed);
+		stats.writeErrors = writeErrors.load(std::memory_order_relaxed);
+		return stats;
+	}
+
 private:
 	std::string folder;
 	std::string filename;
 	size_t maxFileSize;
 	int maxBackups;
 
-	std::ofstream logStream;
+	size_t indexInterval;
+
+	// Longest time a line may wait in the write buffer while the queue never runs empty (message time)
+	static constexpr auto MAX_BUFFER_AGE = std::chrono::milliseconds(100);
+
+	LogFileWriter logFile;
 	std::mutex fileMutex;   // Protects file operations (open/write/rotate)
+	uint64_t currentFileSize = 0; // Bytes in the current file (incl. buffered), tracked instead of asking the file system
+	LogFileIndexWriter indexWriter;
+
+	// Lines in the write buffer, counted in the statistics once written. Guarded by fileMutex.
+	uint64_t bufferedLines = 0;
+	uint64_t bufferedBytes = 0;
+	std::chrono::system_clock::time_point bufferedSince;
+
+	LogSyncMode syncMode = LogSyncMode::None;
+	std::chrono::milliseconds syncPeriod{ 1000 };
+	std::chrono::steady_clock::time_point lastSync;
+	bool unsyncedData = false;
+
+	// Guarded by fileMutex
+	std::chrono::seconds rotationInterval{ 0 };
+	std::chrono::system_clock::time_point nextRotationTime = std::chrono::system_clock::time_point::max();
+	bool nextSegmentReady = false;       // "Gear.log.next" exists and is empty
+	bool currentPreallocated = false;    // The open segment has space reserved beyond its end
 
 	std::queue<LogMessage> logQueue;
-	std::mutex queueMutex;  // Protects the queue of pending log lines
+	std::mutex queueMutex;  // Protects the queue of pending log lines and attachments
+
+	struct PendingAttachment
+	{
+		LogAttachments* target;
+		uint64_t offset;
+		std::string payload;
+	};
+	std::queue<PendingAttachment> attachmentQueue;
+	size_t attachmentQueueBytes = 0;
 	std::condition_variable cv;
 
 	std::thread workerThread;
 	std::atomic<bool> stopFlag;
 
+	// Statistics, written under the owning mutex but readable without it (see GetStats())
+	std::atomic<uint64_t> queueDepth{ 0 };
+	std::atomic<uint64_t> queueHighWater{ 0 };
+	std::atomic<uint64_t> droppedMessages{ 0 };
+	std::atomic<uint64_t> linesWritten{ 0 };
+	std::atomic<uint64_t> bytesWritten{ 0 };
+	std::atomic<uint64_t> rotations{ 0 };
+	std::atomic<uint64_t> lastRotationNs{ 0 };
+	std::atomic<uint64_t> maxRotationNs{ 0 };
+	std::atomic<uint64_t> syncs{ 0 };
+	std::atomic<uint64_t> writeErrors{ 0 };
+
+	// Called with queueMutex held
+	bool HasQueuedWork() const { return !logQueue.empty() || !attachmentQueue.empty(); }
+
+	// Writes the queued attachments. Called and returns with 'lock' (queueMutex) held.
+	void WriteAttachments(std::unique_lock<std::mutex>& lock)
+	{
+		while (!attachmentQueue.empty())
+		{
+			PendingAttachment attachment = std::move(attachmentQueue.front());
+			attachmentQueue.pop();
+			attachmentQueueBytes -= attachment.payload.size();
+
+			lock.unlock();
+			if (!attachment.target->WriteAt(attachment.offset, attachment.payload))
+				writeErrors.fetch_add(1, std::memory_order_relaxed);
+			lock.lock();
+		}
+	}
+
+	// Called with queueMutex held
+	void UpdateQueueDepth(size_t depth)
+	{
+		queueDepth.store(depth, std::memory_order_relaxed);
+		if (depth > queueHighWater.load(std::memory_order_relaxed))
+			queueHighWater.store(depth, std::memory_order_relaxed);
+	}
+
 	std::filesystem::path CurrentLogPath() const
 	{
 		return std::filesystem::path(folder) / filename;
 	}
 
+	std::filesystem::path NextSegmentPath() const
+	{
+		return std::filesystem::path(folder) / (filename + ".next");
+	}
+
+	// First interval boundary after 'now', counted from local midnight
+	static std::chrono::system_clock::time_point NextRotationTime(std::chrono::system_clock::time_point now, std::chrono::seconds interval)
+	{
+		using namespace std::chrono;
+		if (interval.count() <= 0)
+			return system_clock::time_point::max();
+
+		const std::time_t t = system_clock::to_time_t(now);
+		std::tm tm;
+#ifdef _WIN32
+		localtime_s(&tm, &t);
+#else
+		localtime_r(&t, &tm);
+#endif
+		const seconds sinceMidnight(tm.tm_hour * 3600 + tm.tm_min * 60 + tm.tm_sec);
+		const system_clock::time_point midnight = system_clock::from_time_t(t) - sinceMidnight;
+		return midnight + (sinceMidnight / interval + 1) * interval;
+	}
+
+	// Creates the (empty) next segment and reserves maxFileSize for it without changing its size, so readers
+	// and the append position are unaffected. Called by the writer thread while the queue is empty.
+	void PrepareNextSegment()
+	{
+		if (nextSegmentReady)
+			return;
+
+#ifdef __linux__
+		const int fd = ::open(NextSegmentPath().c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+		if (fd < 0)
+			return;
+		if (maxFileSize > 0)
+			::fallocate(fd, FALLOC_FL_KEEP_SIZE, 0, static_cast<off_t>(maxFileSize)); // Best effort, e.g. not supported by tmpfs
+		::close(fd);
+#else
+		std::ofstream next(NextSegmentPath(), std::ios::binary | std::ios::trunc);
+		if (!next)
+			return;
+#endif
+		nextSegmentReady = true;
+	}
+
+	// Writes the buffered lines (and forces them to the disk if 'sync'), then counts them as written
+	void FlushFile(bool sync = false)
+	{
+		if (sync)
+		{
+			if (logFile.Sync())
+				syncs.fetch_add(1, std::memory_order_relaxed);
+			else
+				writeErrors.fetch_add(1, std::memory_order_relaxed);
+			lastSync = std::chrono::steady_clock::now();
+			unsyncedData = false;
+		}
+		else
+		{
+			if (!logFile.Flush())
+				writeErrors.fetch_add(1, std::memory_order_relaxed);
+			unsyncedData |= bufferedLines > 0;
+		}
+
+		linesWritten.fetch_add(bufferedLines, std::memory_order_relaxed);
+		bytesWritten.fetch_add(bufferedBytes, std::memory_order_relaxed);
+		bufferedLines = 0;
+		bufferedBytes = 0;
+	}
+
+	// End of a batch (queue empty or line too old): write out, sync if the period is over
+	void FlushBatch()
+	{
+		const bool syncDue = syncMode == LogSyncMode::Periodic && (bufferedLines > 0 || unsyncedData)
+			&& std::chrono::steady_clock::now() - lastSync >= syncPeriod;
+		if (bufferedLines > 0 || syncDue)
+			FlushFile(syncDue);
+	}
+
+	// Closes the segment and releases space reserved beyond its end
+	void CloseSegment()
+	{
+		FlushFile();
+		logFile.Close();
+		indexWriter.Finish(currentFileSize);
+
+		if (currentPreallocated)
+		{
+			std::error_code ec;
+			std::filesystem::resize_file(CurrentLogPath(), currentFileSize, ec);
+			currentPreallocated = false;
+		}
+	}
+
 	void OpenLogFile()
 	{
 		std::lock_guard lock(fileMutex);
-		logStream.open(CurrentLogPath(), std::ios::app);
+		OpenLogFileUnlocked();
+	}
+
+	// Lines end with '\n' on every platform (no text mode), so tracked sizes match the byte offsets in the index
+	void OpenLogFileUnlocked()
+	{
+		std::error_code ec;
+		auto size = std::filesystem::file_size(CurrentLogPath(), ec);
+		currentFileSize = ec ? 0 : size;
+
+		if (!logFile.Open(CurrentLogPath()))
+			writeErrors.fetch_add(1, std::memory_order_relaxed);
+		indexWriter.Open(CurrentLogPath(), currentFileSize, indexInterval);
 	}
 
 	// Helper: attempts to rename a file multiple times, retrying on failure
@@ -149,7 +426,8 @@ private:
 	// so it does NOT lock 'fileMutex' internally to avoid deadlocks.
 	void RotateFiles()
 	{
-		logStream.close();
+		const auto rotationStart = std::chrono::steady_clock::now();
+		CloseSegment();
 
 		auto folderPath = std::filesystem::path(folder);
 
@@ -159,6 +437,7 @@ private:
 		auto oldestBackup = folderPath / (filename + "." + std::to_string(maxBackups));
 		if (std::filesystem::exists(oldestBackup, ec))
 			std::filesystem::remove(oldestBackup, ec);
+		std::filesystem::remove(LogFileIndex::PathFor(oldestBackup), ec);
 
 		// Shift backups: file.log.N -> file.log.N+1
 		for (int i = maxBackups - 1; i >= 1; --i)
@@ -171,6 +450,8 @@ private:
 				{
 					// Optionally log or handle rename failure here
 				}
+				if (std::filesystem::exists(LogFileIndex::PathFor(src), ec))
+					TryRenameWithRetry(LogFileIndex::PathFor(src), LogFileIndex::PathFor(dst));
 			}
 		}
 
@@ -181,9 +462,48 @@ private:
 		{
 			// Optionally handle rename failure here
 		}
+		if (std::filesystem::exists(LogFileIndex::PathFor(currentLog), ec))
+			TryRenameWithRetry(LogFileIndex::PathFor(currentLog), LogFileIndex::PathFor(backupOne));
+
+		// Continue in the prepared segment (otherwise the open below creates a new file)
+		if (nextSegmentReady)
+		{
+			std::filesystem::rename(NextSegmentPath(), currentLog, ec);
+			currentPreallocated = !ec && maxFileSize > 0;
+			nextSegmentReady = false;
+		}
+		OpenLogFileUnlocked();
 
-		// Reopen new log file for continued logging
-		logStream.open(CurrentLogPath(), std::ios::app);
+		const uint64_t durationNs = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - rotationStart).count();
+		rotations.fetch_add(1, std::memory_order_relaxed);
+		lastRotationNs.store(durationNs, std::memory_order_relaxed);
+		if (durationNs > maxRotationNs.load(std::memory_order_relaxed))
+			maxRotationNs.store(durationNs, std::memory_order_relaxed);
+	}
+
+	// Writer thread work while the queue is empty: write out the batch, prepare the next segment and rotate a
+	// segment whose interval ended. Returns when the writer has to wake up again (interval end or periodic sync),
+	// time_point::max() if only for new lines.
+	std::chrono::system_clock::time_point DoIdleWork()
+	{
+		std::lock_guard fileLock(fileMutex);
+		FlushBatch();
+		PrepareNextSegment();
+
+		const auto now = std::chrono::system_clock::now();
+		if (now >= nextRotationTime)
+		{
+			if (currentFileSize > 0)
+				RotateFiles();
+			nextRotationTime = NextRotationTime(now, rotationInterval);
+		}
+
+		if (syncMode == LogSyncMode::Periodic && unsyncedData)
+		{
+			const auto syncIn = std::chrono::duration_cast<std::chrono::system_clock::duration>(lastSync + syncPeriod - std::chrono::steady_clock::now());
+			return std::min(nextRotationTime, now + syncIn);
+		}
+		return nextRotationTime;
 	}
 
 	// Background thread method processing queued log lines asynchronously
@@ -191,17 +511,34 @@ private:
 	{
 		std::unique_lock<std::mutex> lock(queueMutex);
 
-		while (!stopFlag || !logQueue.empty())
+		while (!stopFlag || HasQueuedWork())
 		{
-			// Wait for either new data or stop signal
-			cv.wait(lock, [this]() { return stopFlag || !logQueue.empty(); });
+			if (!HasQueuedWork() && !stopFlag)
+			{
+				lock.unlock();
+				const auto wakeUpTime = DoIdleWork();
+				lock.lock();
+
+				// Wait for either new data, stop signal or the end of the rotation interval / sync period
+				if (wakeUpTime == std::chrono::system_clock::time_point::max())
+					cv.wait(lock, [this]() { return stopFlag || HasQueuedWork(); });
+				else
+					cv.wait_until(lock, wakeUpTime, [this]() { return stopFlag || HasQueuedWork(); });
+				continue;
+			}
+
+			// Attachments first: they were queued before the lines of their messages
+			WriteAttachments(lock);
 
 			// Process all queued log lines
 			while (!logQueue.empty())
 			{
+				WriteAttachments(lock);
+
 				// Pop next log line from queue
 				LogMessage msg = std::move(logQueue.front());
 				logQueue.pop();
+				UpdateQueueDepth(logQueue.size());
 
 				// Unlock queue mutex while writing to avoid blocking producers
 				lock.unlock();
@@ -210,18 +547,36 @@ private:
 					// Lock file mutex to protect file access and possible rotation
 					std::lock_guard fileLock(fileMutex);
 
-					if (!logStream.is_open())
-						OpenLogFile();
-
-					// Write log line and flush to ensure persistence
-					logStream << msg.ToStringForFile() << std::endl;
-					logStream.flush();
-
-					// Check file size and rotate if necessary
-					std::error_code ec;
-					auto fileSize = std::filesystem::file_size(CurrentLogPath(), ec);
-					if (!ec && fileSize > maxFileSize)
-						RotateFiles(); // Called without locking fileMutex inside to avoid deadlock
+					if (!logFile.IsOpen())
+						OpenLogFileUnlocked();
+
+					// Rotate before the line would start a new interval or overflow the segment, so segments
+					// never exceed maxFileSize (except for a single line larger than that)
+					const std::string line = msg.ToStringForFile();
+					if (msg.timestamp >= nextRotationTime)
+					{
+						if (currentFileSize > 0)
+							RotateFiles();
+						nextRotationTime = NextRotationTime(msg.timestamp, rotationInterval);
+					}
+					else if (maxFileSize > 0 && currentFileSize > 0 && currentFileSize + line.size() + 1 > maxFileSize)
+						RotateFiles();
+
+					// Checkpoint the line's position in the sidecar index before writing it
+					indexWriter.OnLine(msg.level, ToEpochNanoseconds(msg.timestamp), currentFileSize);
+
+					// Buffer the line; written out with the rest of the batch
+					if (bufferedLines == 0)
+						bufferedSince = msg.timestamp;
+					logFile.AppendLine(line);
+					currentFileSize += line.size() + 1;
+					++bufferedLines;
+					bufferedBytes += line.size() + 1;
+
+					if (msg.level == LogLevel::Error && syncMode == LogSyncMode::OnError)
+						FlushFile(true);
+					else if (msg.timestamp - bufferedSince >= MAX_BUFFER_AGE)
+						FlushBatch();
 				}
 
 				// Re-lock queue mutex before next iteration
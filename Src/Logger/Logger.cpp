@@ -1,13 +1,162 @@
 #include "Logger.h"
+#include "LogSources.h"
+#include "Utils/RedrawScheduler.h"
 
-void Logger::PushToBuffer(LogLevel level, const std::string& message)
+namespace
 {
-	LogMessage logMessage(level, message);
-	logBuffer.Push(logMessage);
+	// Drops a UTF-8 sequence that was cut at the end of 'text'
+	size_t TrimIncompleteUtf8(const char* text, size_t length)
+	{
+		size_t continuation = 0;
+		while (continuation < length && continuation < 3 && (static_cast<unsigned char>(text[length - 1 - continuation]) & 0xC0) == 0x80)
+			++continuation;
+		if (continuation == length)
+			return length;
 
-	// Mark that GUI should scroll to latest log after this push
+		const unsigned char lead = static_cast<unsigned char>(text[length - 1 - continuation]);
+		const size_t expected = lead >= 0xF0 ? 3 : lead >= 0xE0 ? 2 : lead >= 0xC0 ? 1 : 0;
+		return expected > continuation ? length - 1 - continuation : length;
+	}
+}
+
+uint32_t Logger::InternSite(const LogLocation& location, fmt::string_view format, bool byLocation)
+{
+	// Formatted on the stack, sites longer than the key are told apart by their first 255 bytes
+	char key[256];
+	const auto result = byLocation
+		? fmt::format_to_n(key, sizeof(key), "{}(): {}:{}", location.function, location.GetFileName(), location.source.line())
+		: fmt::format_to_n(key, sizeof(key), "{}(): {}", location.function, format);
+	const uint32_t siteId = LogSymbols::Intern(std::string_view(key, std::min(result.size, sizeof(key))), LogSymbols::ROLE_SITE);
+	location.siteId.store(siteId, std::memory_order_relaxed); // Racing first calls intern the same id
+	return siteId;
+}
+
+void Logger::PushFormatted(LogLevel level, fmt::memory_buffer& text, size_t fullLength, const LogLocation& location, uint32_t siteId, const Prefix& prefix)
+{
+	const size_t limit = GetMaxMessageLength();
+	int64_t attachmentOffset = -1;
+	size_t length = text.size();
+	if (limit != 0 && fullLength > limit)
+	{
+		// With attachments enabled 'text' is complete, otherwise formatting already stopped at the limit.
+		// Only its offset is reserved here, the file writer thread writes it.
+		if (text.size() == fullLength && GetAttachmentsEnabled())
+		{
+			attachmentOffset = attachments.Reserve(text.size());
+			if (attachmentOffset >= 0 && !fileLogger.WriteAttachment(attachments, static_cast<uint64_t>(attachmentOffset), std::string(text.data(), text.size())))
+				attachmentOffset = -1;
+		}
+		length = TrimIncompleteUtf8(text.data(), std::min(text.size(), limit));
+	}
+
+	LogMessage logMessage(level, std::string(text.data(), length));
+	if (length < text.size() || fullLength > text.size())
+	{
+		logMessage.fullLength = static_cast<uint32_t>(std::min<size_t>(fullLength, UINT32_MAX));
+		logMessage.attachmentOffset = attachmentOffset;
+		if (attachmentOffset >= 0)
+			fmt::format_to(std::back_inserter(logMessage.message), "... [truncated, {} bytes, attachment @{}]", fullLength, attachmentOffset);
+		else
+			fmt::format_to(std::back_inserter(logMessage.message), "... [truncated, {} bytes]", fullLength);
+	}
+	logMessage.siteId = siteId;
+	logMessage.location = &location;
+	logMessage.threadIndex = LogThreads::Current();
+	LogThreads::Record(logMessage.threadIndex);
+	if (prefix.parts >= 1)
+		logMessage.objectId = LogSymbols::Intern(prefix.object, LogSymbols::ROLE_OBJECT);
+	if (prefix.parts >= 2)
+		logMessage.nameId = LogSymbols::Intern(prefix.name, LogSymbols::ROLE_NAME);
+	if (prefix.parts >= 3)
+		logMessage.callerId = LogSymbols::Intern(prefix.caller, LogSymbols::ROLE_CALLER);
+
+	// The symbol table is full (LogSymbols::MAX_SYMBOLS): the prefix can't be rendered from the ids anymore,
+	// so it is formatted into the text as a whole
+	const bool symbolsMissing = (prefix.parts >= 1 && logMessage.objectId == LogSymbols::NONE)
+		|| (prefix.parts >= 2 && logMessage.nameId == LogSymbols::NONE) || (prefix.parts >= 3 && logMessage.callerId == LogSymbols::NONE);
+	if (symbolsMissing)
+	{
+		fmt::memory_buffer prefixed;
+		if (prefix.parts == 3)
+			fmt::format_to(std::back_inserter(prefixed), "{} >> {} \"{}\" {}(): ", prefix.caller, prefix.object, prefix.name, location.function);
+		else if (prefix.parts == 2)
+			fmt::format_to(std::back_inserter(prefixed), "{} \"{}\" {}(): ", prefix.object, prefix.name, location.function);
+		else
+			fmt::format_to(std::back_inserter(prefixed), "{} {}(): ", prefix.object, location.function);
+		logMessage.message.insert(0, prefixed.data(), prefixed.size());
+		logMessage.location = nullptr;
+	}
+	PushToBuffer(logMessage);
+}
+
+bool Logger::SetAttachmentsEnabled(bool enable, std::string* error)
+{
+	if (enable && !attachments.IsOpen() && !attachments.Open(std::filesystem::path(LOG_FOLDER) / LOG_ATTACHMENTS_FILE_NAME, error))
+		return false;
+	attachmentsEnabled.store(enable, std::memory_order_relaxed);
+	return true;
+}
+
+bool Logger::ReadAttachment(const LogMessage& message, std::string& out, std::string* error)
+{
+	if (message.attachmentOffset < 0)
+	{
+		if (error)
+			*error = "Message has no attachment";
+		return false;
+	}
+	return LogAttachments::Read(std::filesystem::path(LOG_FOLDER) / LOG_ATTACHMENTS_FILE_NAME, message.attachmentOffset, message.fullLength, out, error);
+}
+
+void Logger::PushToBuffer(LogMessage& logMessage)
+{
+	const auto start = std::chrono::steady_clock::now();
+
+	logMessage.sequence = logBuffer.Push(logMessage);
+	rateSeries.Record(logMessage);
+	groups.Record(logMessage);
+
+	// Mark that GUI should scroll to latest log after this push, and wake it if it idles
 	scrollToBottom.store(true);
+	gear::RedrawScheduler::RequestRedraw();
 
-	// Write to file
-	fileLogger.Write(message);
+	// Write to file (with level and timestamp of this message, so the history view can parse them back)
+	fileLogger.Write(logMessage);
+
+	LoggerMetrics::RecordEnqueue(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+}
+
+void Logger::PushExternal(LogMessage* messages, size_t count, bool writeToFile)
+{
+	if (count == 0)
+		return;
+
+	if (writeToFile)
+	{
+		for (size_t i = 0; i < count; ++i)
+		{
+			LogMessage fileMessage(messages[i].level, fmt::format("[{}] {}", LogSources::GetName(messages[i].sourceId), messages[i].message));
+			fileMessage.timestamp = messages[i].timestamp;
+			fileLogger.Write(fileMessage);
+		}
+	}
+
+	const uint64_t firstSequence = logBuffer.PushBatch(messages, count);
+
+	// Only the texts were swapped into the ring, level and timestamp are still valid
+	for (size_t i = 0; i < count; ++i)
+		rateSeries.Record(messages[i].level, LogRateSeries::ToEpochSecond(messages[i].timestamp), firstSequence + i);
+	scrollToBottom.store(true);
+	gear::RedrawScheduler::RequestRedraw();
+}
+
+LoggerMetricsSnapshot Logger::GetMetrics()
+{
+	LoggerMetricsSnapshot snapshot;
+	snapshot.takenAt = std::chrono::steady_clock::now();
+	LoggerMetrics::CollectEnqueueLatency(snapshot.enqueueLatency);
+	snapshot.ringPushes = logBuffer.GetTotalPushed();
+	snapshot.producerThreads = LoggerMetrics::GetThreadCount();
+	snapshot.file = fileLogger.GetStats();
+	return snapshot;
 }
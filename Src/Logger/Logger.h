@@ -1,6 +1,8 @@
 ﻿#pragma once
 
 #include <string>
+#include <string_view>
+#include <iterator>
 #include <vector>
 #include <fmt/core.h>
 #include <fmt/format.h>
@@ -8,106 +10,240 @@
 #include "LogMessage.h"
 #include "LogToFile.h"
 #include "CircularLogBuffer.h"
+#include "LoggerMetrics.h"
+#include "LogRateSeries.h"
+#include "LogSymbols.h"
+#include "LogAttachments.h"
+#include "LogGroups.h"
+#include "LogLocation.h"
+#include "LogThreads.h"
 
 class Logger
 {
 public:
-	static constexpr size_t LOG_BUFFER_CAPACITY = 10000;
+	static constexpr size_t LOG_BUFFER_CAPACITY = 10000; // Initial ring capacity, see SetBufferCapacity()
+
+	// Log file location, also used by LogHistory to browse entries older than the ring buffer
+	static constexpr const char* LOG_FOLDER = "./Log";
+	static constexpr const char* LOG_FILE_NAME = "Gear.log";
+	static constexpr int LOG_MAX_BACKUPS = 5;
+	static constexpr const char* LOG_ATTACHMENTS_FILE_NAME = "Gear.attachments";
+
+	// Default cap of a message's length in bytes, see SetMaxMessageLength()
+	static constexpr size_t DEFAULT_MAX_MESSAGE_LENGTH = 16 * 1024;
+
+	// The message keeps only the user text. Its prefix is rendered from the call site and the interned
+	// object, name and caller (LogSymbols) when it is shown or written, see LogLocation.
 
 	// Just user message --> 'MyFunction(): Some message'
 	template<typename... Args>
-	static void Log(const char* callerFunc, LogLevel level, fmt::format_string<Args...> formatStr, Args&&... args)
+	static void Log(const LogLocation& location, LogLevel level, fmt::format_string<Args...> formatStr, Args&&... args)
 	{
-		std::string formatted = fmt::format("{}(): {}", callerFunc, fmt::format(formatStr, std::forward<Args>(args)...));
-		PushToBuffer(level, std::move(formatted));
+		fmt::memory_buffer text;
+		const size_t fullLength = FormatCapped(text, formatStr, std::forward<Args>(args)...);
+		PushFormatted(level, text, fullLength, location, SiteId(location, formatStr), Prefix());
 	}
-	// Just user message with no args
-	static void Log(const char* callerFunc, LogLevel level, std::string_view message)
+	// Just user message with no args. The text may vary per call, so the log site is the call's location.
+	static void Log(const LogLocation& location, LogLevel level, std::string_view message)
 	{
-		std::string formatted = fmt::format("{}(): {}", callerFunc, message);
-		PushToBuffer(level, std::move(formatted));
+		fmt::memory_buffer text;
+		const size_t fullLength = FormatCapped(text, "{}", message);
+		PushFormatted(level, text, fullLength, location, PlainSiteId(location), Prefix());
 	}
 
 	// Object as prefix --> 'ObjectXY MyFunction(): Some message'
 	template<typename... Args>
-	static void Log1(const char* callerFunc, LogLevel level, const std::string& object, fmt::format_string<Args...> formatStr, Args&&... args)
+	static void Log1(const LogLocation& location, LogLevel level, std::string_view object, fmt::format_string<Args...> formatStr, Args&&... args)
 	{
-		std::string formatted = fmt::format("{} {}(): {}", object, callerFunc, fmt::format(formatStr, std::forward<Args>(args)...));
-		PushToBuffer(level, std::move(formatted));
+		fmt::memory_buffer text;
+		const size_t fullLength = FormatCapped(text, formatStr, std::forward<Args>(args)...);
+		PushFormatted(level, text, fullLength, location, SiteId(location, formatStr), { object });
 	}
 	// Object as prefix with no args
-	static void Log1(const char* callerFunc, LogLevel level, const std::string& object, std::string_view message)
+	static void Log1(const LogLocation& location, LogLevel level, std::string_view object, std::string_view message)
 	{
-		std::string formatted = fmt::format("{} {}(): {}", object, callerFunc, message);
-		PushToBuffer(level, std::move(formatted));
+		fmt::memory_buffer text;
+		const size_t fullLength = FormatCapped(text, "{}", message);
+		PushFormatted(level, text, fullLength, location, PlainSiteId(location), { object });
 	}
 
 	// Object and name as prefix --> 'ObjectXY "Stone" MyFunction(): Some message'
 	template<typename... Args>
-	static void Log2(const char* callerFunc, LogLevel level, const std::string& object, const std::string& name, fmt::format_string<Args...> formatStr, Args&&... args)
+	static void Log2(const LogLocation& location, LogLevel level, std::string_view object, std::string_view name, fmt::format_string<Args...> formatStr, Args&&... args)
 	{
-		std::string formatted = fmt::format("{} \"{}\" {}(): {}", object, name, callerFunc, fmt::format(formatStr, std::forward<Args>(args)...));
-		PushToBuffer(level, std::move(formatted));
+		fmt::memory_buffer text;
+		const size_t fullLength = FormatCapped(text, formatStr, std::forward<Args>(args)...);
+		PushFormatted(level, text, fullLength, location, SiteId(location, formatStr), { object, name });
 	}
 	// Object and name as prefix with no args
-	static void Log2(const char* callerFunc, LogLevel level, const std::string& object, const std::string& name, std::string_view message)
+	static void Log2(const LogLocation& location, LogLevel level, std::string_view object, std::string_view name, std::string_view message)
 	{
-		std::string formatted = fmt::format("{} \"{}\" {}(): {}", object, name, callerFunc, message);
-		PushToBuffer(level, std::move(formatted));
+		fmt::memory_buffer text;
+		const size_t fullLength = FormatCapped(text, "{}", message);
+		PushFormatted(level, text, fullLength, location, PlainSiteId(location), { object, name });
 	}
 
 	// Caller, object and name as prefix --> 'CallerXY >> ObjectXY "Stone" MyFunction(): Some message'
 	template<typename... Args>
-	static void Log3(const char* callerFunc, LogLevel level, const std::string& caller, const std::string& object, const std::string& name, fmt::format_string<Args...> formatStr, Args&&... args)
+	static void Log3(const LogLocation& location, LogLevel level, std::string_view caller, std::string_view object, std::string_view name, fmt::format_string<Args...> formatStr, Args&&... args)
 	{
-		std::string formatted = fmt::format("{} >> {} \"{}\" {}(): {}", caller, object, name, callerFunc, fmt::format(formatStr, std::forward<Args>(args)...));
-		PushToBuffer(level, std::move(formatted));
+		fmt::memory_buffer text;
+		const size_t fullLength = FormatCapped(text, formatStr, std::forward<Args>(args)...);
+		PushFormatted(level, text, fullLength, location, SiteId(location, formatStr), { object, name, caller });
 	}
 	// Caller, object and name as prefix with no args
-	static void Log3(const char* callerFunc, LogLevel level, const std::string& caller, const std::string& object, const std::string& name, std::string_view message)
+	static void Log3(const LogLocation& location, LogLevel level, std::string_view caller, std::string_view object, std::string_view name, std::string_view message)
 	{
-		std::string formatted = fmt::format("{} >> {} \"{}\" {}(): {}", caller, object, name, callerFunc, message);
-		PushToBuffer(level, std::move(formatted));
+		fmt::memory_buffer text;
+		const size_t fullLength = FormatCapped(text, "{}", message);
+		PushFormatted(level, text, fullLength, location, PlainSiteId(location), { object, name, caller });
 	}
 
+	// Adds messages from other sources (LogMessage::sourceId) to the ring buffer. By default they are not written
+	// to Gear.log, their origin (e.g. a tailed file) keeps them already. Sources without a log of their own
+	// (shared-memory producers) pass 'writeToFile', their lines are then prefixed with the source name.
+	static void PushExternal(std::vector<LogMessage>& messages, bool writeToFile = false) { PushExternal(messages.data(), messages.size(), writeToFile); }
+	// Same for a plain array. The texts are swapped with the overwritten ring entries (see CircularLogBuffer::PushBatch()).
+	static void PushExternal(LogMessage* messages, size_t count, bool writeToFile = false);
+
 	static const std::vector<LogMessage>& GetBuffer() { return logBuffer.GetBuffer(); }
 	static size_t GetReadIndex() { return logBuffer.GetReadIndex(); }
 	static size_t GetSize() { return logBuffer.GetSize(); }
+	static uint64_t GetTotalPushed() { return logBuffer.GetTotalPushed(); }
+
+	// Ring capacity at runtime (LOG_BUFFER_CAPACITY at start). Entries are kept; the new storage is prepared in the
+	// background and FinishBufferResize() swaps it in, holding producers only for that (see
+	// CircularLogBuffer::BeginResize()). Call both on the GUI thread, which reads GetBuffer(), once per frame for the latter.
+	static bool SetBufferCapacity(size_t capacity) { return logBuffer.BeginResize(capacity); }
+	static bool FinishBufferResize() { return logBuffer.FinishResize(); }
+	static bool IsBufferResizing() { return logBuffer.IsResizing(); }
+	static size_t GetBufferCapacity() { return logBuffer.GetCapacity(); }
+
+	// Direct access to the history store, e.g. for background search workers (read-only)
+	static const CircularLogBuffer& GetStore() { return logBuffer; }
+
+	// Names the calling thread in the Logger window (thread column and filter), default "Thread N"
+	static void SetThreadName(std::string_view name) { LogThreads::SetName(name); }
+
+	// Per-level message counts per second for the last hour (all sources)
+	static const LogRateSeries& GetRateSeries() { return rateSeries; }
+
+	// Counts, first/last time and rate per log site of GEAR's own messages
+	static const LogGroups& GetGroups() { return groups; }
+
+	// Self-instrumentation: producer latency histogram, ring pushes and file writer statistics
+	static LoggerMetricsSnapshot GetMetrics();
+
+	// Time-based rotation of Gear.log in addition to the 1 MB size limit (e.g. 24 h = a new file at midnight), 0 = off
+	static void SetFileRotationInterval(std::chrono::seconds interval) { fileLogger.SetRotationInterval(interval); }
+	// Durability of Gear.log (default LogSyncMode::None, i.e. left to the OS)
+	static void SetFileSyncMode(LogSyncMode mode, std::chrono::milliseconds period = std::chrono::milliseconds(1000)) { fileLogger.SetSyncMode(mode, period); }
+
+	// Cap of a message's length in bytes (user text without the prefix, default DEFAULT_MAX_MESSAGE_LENGTH, 0 = unlimited).
+	// Longer messages are cut at a UTF-8 boundary while formatting (fmt::format_to_n) and end with a marker
+	// "... [truncated, N bytes]"; LogMessage::fullLength keeps the original length.
+	static void SetMaxMessageLength(size_t length) { maxMessageLength.store(length, std::memory_order_relaxed); }
+	static size_t GetMaxMessageLength() { return maxMessageLength.load(std::memory_order_relaxed); }
+
+	// Diverts the full text of truncated messages to LOG_FOLDER/LOG_ATTACHMENTS_FILE_NAME (LogAttachments);
+	// the marker then names the offset. Such messages are formatted completely before they are cut.
+	static bool SetAttachmentsEnabled(bool enable, std::string* error = nullptr);
+	static bool GetAttachmentsEnabled() { return attachmentsEnabled.load(std::memory_order_relaxed); }
+	// Full text of a message truncated with attachments enabled. It is written by the file writer thread, so it
+	// can be missing right after the call that logged it.
+	static bool ReadAttachment(const LogMessage& message, std::string& out, std::string* error = nullptr);
 
 	static bool ShouldScrollToBottom() { return scrollToBottom.exchange(false); } // resets after check
 
 private:
-	static void PushToBuffer(LogLevel level, const std::string& message);
+	// Prefix parts of Log1..Log3, interned by PushFormatted()
+	struct Prefix
+	{
+		std::string_view object;
+		std::string_view name;
+		std::string_view caller;
+		int parts = 0;
+
+		Prefix() = default;
+		Prefix(std::string_view object) : object(object), parts(1) {}
+		Prefix(std::string_view object, std::string_view name) : object(object), name(name), parts(2) {}
+		Prefix(std::string_view object, std::string_view name, std::string_view caller) : object(object), name(name), caller(caller), parts(3) {}
+	};
+
+	// Formats the user message into 'text'. Stops at the maximum message length unless attachments need the
+	// full text. Returns the length of the complete message.
+	template<typename... Args>
+	static size_t FormatCapped(fmt::memory_buffer& text, fmt::format_string<Args...> formatStr, Args&&... args)
+	{
+		const size_t limit = GetMaxMessageLength();
+		if (limit == 0 || GetAttachmentsEnabled())
+		{
+			fmt::format_to(std::back_inserter(text), formatStr, std::forward<Args>(args)...);
+			return text.size();
+		}
+
+		const auto result = fmt::format_to_n(std::back_inserter(text), limit, formatStr, std::forward<Args>(args)...);
+		return result.size;
+	}
+
+	// Log site of a call site, interned as "Function(): format string" (LogSymbols::ROLE_SITE) by its first call
+	static uint32_t SiteId(const LogLocation& location, fmt::string_view format)
+	{
+		const uint32_t siteId = location.siteId.load(std::memory_order_relaxed);
+		return siteId != LogSymbols::NONE ? siteId : InternSite(location, format);
+	}
+	// Site of a call without format arguments, interned as "Function(): File.cpp:line"
+	static uint32_t PlainSiteId(const LogLocation& location)
+	{
+		const uint32_t siteId = location.siteId.load(std::memory_order_relaxed);
+		return siteId != LogSymbols::NONE ? siteId : InternSite(location, {}, true);
+	}
+	static uint32_t InternSite(const LogLocation& location, fmt::string_view format, bool byLocation = false);
+
+	// Applies the truncation policy to a formatted message, interns its prefix parts and pushes it
+	static void PushFormatted(LogLevel level, fmt::memory_buffer& text, size_t fullLength, const LogLocation& location, uint32_t siteId,
+		const Prefix& prefix);
+	static void PushToBuffer(LogMessage& message);
 	static void Write(const LogMessage& message);
 
 	static inline CircularLogBuffer logBuffer{ LOG_BUFFER_CAPACITY };
 	static inline std::atomic_bool scrollToBottom{ false };
+	static inline LogRateSeries rateSeries;
+	static inline LogGroups groups;
+	static inline std::atomic<size_t> maxMessageLength{ DEFAULT_MAX_MESSAGE_LENGTH };
+	static inline std::atomic<bool> attachmentsEnabled{ false };
+	static inline LogAttachments attachments; // Before fileLogger, whose writer thread writes to it until destroyed
 
-	static inline LogToFile fileLogger{ "./Log", "Gear.log", 1024 * 1024, 5 }; // 1 MB
+	static inline LogToFile fileLogger{ LOG_FOLDER, LOG_FILE_NAME, 1024 * 1024, LOG_MAX_BACKUPS }; // 1 MB
 };
 
-// Logging macros
+// Logging macros. Each call gets a static LogLocation (source file, line and __func__, constant-initialized),
+// so they are statements: 'LOG_INFO(...);'.
+#define GEAR_LOG_CALL(function, ...) do { \
+	static constinit LogLocation gearLogLocation{ std::source_location::current(), __func__ }; \
+	Logger::function(gearLogLocation, __VA_ARGS__); \
+} while (false)
 
 // Level 0 - Just message
-#define LOG_INFO(...)  Logger::Log(__func__, LogLevel::Info, __VA_ARGS__)
-#define LOG_WARN(...)  Logger::Log(__func__, LogLevel::Warning, __VA_ARGS__)
-#define LOG_ERROR(...) Logger::Log(__func__, LogLevel::Error, __VA_ARGS__)
-#define LOG_DEBUG(...) Logger::Log(__func__, LogLevel::Debug, __VA_ARGS__)
+#define LOG_INFO(...)  GEAR_LOG_CALL(Log, LogLevel::Info, __VA_ARGS__)
+#define LOG_WARN(...)  GEAR_LOG_CALL(Log, LogLevel::Warning, __VA_ARGS__)
+#define LOG_ERROR(...) GEAR_LOG_CALL(Log, LogLevel::Error, __VA_ARGS__)
+#define LOG_DEBUG(...) GEAR_LOG_CALL(Log, LogLevel::Debug, __VA_ARGS__)
 
 // Level 1 - Object + message
-#define LOG1_INFO(obj, ...)  Logger::Log1(__func__, LogLevel::Info, obj, __VA_ARGS__)
-#define LOG1_WARN(obj, ...)  Logger::Log1(__func__, LogLevel::Warning, obj, __VA_ARGS__)
-#define LOG1_ERROR(obj, ...) Logger::Log1(__func__, LogLevel::Error, obj, __VA_ARGS__)
-#define LOG1_DEBUG(obj, ...) Logger::Log1(__func__, LogLevel::Debug, obj, __VA_ARGS__)
+#define LOG1_INFO(obj, ...)  GEAR_LOG_CALL(Log1, LogLevel::Info, obj, __VA_ARGS__)
+#define LOG1_WARN(obj, ...)  GEAR_LOG_CALL(Log1, LogLevel::Warning, obj, __VA_ARGS__)
+#define LOG1_ERROR(obj, ...) GEAR_LOG_CALL(Log1, LogLevel::Error, obj, __VA_ARGS__)
+#define LOG1_DEBUG(obj, ...) GEAR_LOG_CALL(Log1, LogLevel::Debug, obj, __VA_ARGS__)
 
 // Level 2 - Object + Name + message
-#define LOG2_INFO(obj, name, ...)  Logger::Log2(__func__, LogLevel::Info, obj, name, __VA_ARGS__)
-#define LOG2_WARN(obj, name, ...)  Logger::Log2(__func__, LogLevel::Warning, obj, name, __VA_ARGS__)
-#define LOG2_ERROR(obj, name, ...) Logger::Log2(__func__, LogLevel::Error, obj, name, __VA_ARGS__)
-#define LOG2_DEBUG(obj, name, ...) Logger::Log2(__func__, LogLevel::Debug, obj, name, __VA_ARGS__)
+#define LOG2_INFO(obj, name, ...)  GEAR_LOG_CALL(Log2, LogLevel::Info, obj, name, __VA_ARGS__)
+#define LOG2_WARN(obj, name, ...)  GEAR_LOG_CALL(Log2, LogLevel::Warning, obj, name, __VA_ARGS__)
+#define LOG2_ERROR(obj, name, ...) GEAR_LOG_CALL(Log2, LogLevel::Error, obj, name, __VA_ARGS__)
+#define LOG2_DEBUG(obj, name, ...) GEAR_LOG_CALL(Log2, LogLevel::Debug, obj, name, __VA_ARGS__)
 
 // Level 3 - Caller + Object + Name + message
-#define LOG3_INFO(caller, obj, name, ...)  Logger::Log3(__func__, LogLevel::Info, caller, obj, name, __VA_ARGS__)
-#define LOG3_WARN(caller, obj, name, ...)  Logger::Log3(__func__, LogLevel::Warning, caller, obj, name, __VA_ARGS__)
-#define LOG3_ERROR(caller, obj, name, ...) Logger::Log3(__func__, LogLevel::Error, caller, obj, name, __VA_ARGS__)
-#define LOG3_DEBUG(caller, obj, name, ...) Logger::Log3(__func__, LogLevel::Debug, caller, obj, name, __VA_ARGS__)
+#define LOG3_INFO(caller, obj, name, ...)  GEAR_LOG_CALL(Log3, LogLevel::Info, caller, obj, name, __VA_ARGS__)
+#define LOG3_WARN(caller, obj, name, ...)  GEAR_LOG_CALL(Log3, LogLevel::Warning, caller, obj, name, __VA_ARGS__)
+#define LOG3_ERROR(caller, obj, name, ...) GEAR_LOG_CALL(Log3, LogLevel::Error, caller, obj, name, __VA_ARGS__)
+#define LOG3_DEBUG(caller, obj, name, ...) GEAR_LOG_CALL(Log3, LogLevel::Debug, caller, obj, name, __VA_ARGS__)
@@ -0,0 +1,24 @@
+#include "LoggerMetrics.h"
+
+// Constant-initialized (zeroed atomics), so they are ready before any static logger is constructed
+std::array<LoggerMetrics::ThreadSlot, LoggerMetrics::MAX_THREAD_SLOTS> LoggerMetrics::slots{};
+std::atomic<size_t> LoggerMetrics::nextSlot{ 0 };
+
+void LoggerMetrics::CollectEnqueueLatency(LatencyHistogram& out)
+{
+	out.Clear();
+	for (const ThreadSlot& slot : slots)
+	{
+		const uint64_t count = slot.count.load(std::memory_order_relaxed);
+		if (count == 0)
+			continue;
+
+		for (size_t i = 0; i < LatencyHistogram::BUCKET_COUNT; ++i)
+		{
+			const uint64_t bucketCount = slot.buckets[i].load(std::memory_order_relaxed);
+			if (bucketCount)
+				out.AddBucket(i, bucketCount);
+		}
+		out.AddTotals(count, slot.sum.load(std::memory_order_relaxed), slot.max.load(std::memory_order_relaxed));
+	}
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include "LatencyHistogram.h"
+
+// Statistics of a LogToFile instance (see LogToFile::GetStats())
+struct LogFileStats
+{
+	uint64_t queueDepth = 0;      // Messages waiting for the writer thread
+	uint64_t queueHighWater = 0;  // Largest queue depth seen
+	uint64_t droppedMessages = 0; // Removed by the queue overflow protection
+	uint64_t linesWritten = 0;
+	uint64_t bytesWritten = 0;
+	uint64_t rotations = 0;
+	uint64_t lastRotationNs = 0;  // Duration of the last rotation (rename chain + reopen)
+	uint64_t maxRotationNs = 0;
+	uint64_t syncs = 0;           // Data forced to the disk (LogSyncMode)
+	uint64_t writeErrors = 0;     // Failed open / write / sync calls
+};
+
+// Point-in-time copy of all logger metrics, see Logger::GetMetrics()
+struct LoggerMetricsSnapshot
+{
+	std::chrono::steady_clock::time_point takenAt;
+	LatencyHistogram enqueueLatency; // Time spent in the producer call (ring push + file queue), ns
+	uint64_t ringPushes = 0;         // Total messages pushed into the ring (incl. external sources)
+	size_t producerThreads = 0;      // Threads that have logged so far
+	LogFileStats file;
+};
+
+// Always-on producer metrics. Every thread records into its own cache-line aligned slot, so
+// recording is a few uncontended relaxed atomic adds and producers never share cache lines.
+// Threads beyond MAX_THREAD_SLOTS share slots (still correct, just contended).
+class LoggerMetrics
+{
+public:
+	static constexpr size_t MAX_THREAD_SLOTS = 64;
+
+	static void RecordEnqueue(uint64_t latencyNs)
+	{
+		ThreadSlot& slot = slots[GetThreadSlot()];
+		slot.buckets[LatencyHistogram::BucketIndex(latencyNs)].fetch_add(1, std::memory_order_relaxed);
+		slot.count.fetch_add(1, std::memory_order_relaxed);
+		slot.sum.fetch_add(latencyNs, std::memory_order_relaxed);
+
+		uint64_t currentMax = slot.max.load(std::memory_order_relaxed);
+		while (latencyNs > currentMax && !slot.max.compare_exchange_weak(currentMax, latencyNs, std::memory_order_relaxed))
+		{
+		}
+	}
+
+	// Merges all thread slots into 'out' (counts keep increasing, callers diff snapshots for rates)
+	static void CollectEnqueueLatency(LatencyHistogram& out);
+
+	static size_t GetThreadCount() { return std::min<size_t>(nextSlot.load(std::memory_order_relaxed), MAX_THREAD_SLOTS); }
+
+private:
+	struct alignas(64) ThreadSlot
+	{
+		std::atomic<uint64_t> count{ 0 };
+		std::atomic<uint64_t> sum{ 0 };
+		std::atomic<uint64_t> max{ 0 };
+		std::array<std::atomic<uint64_t>, LatencyHistogram::BUCKET_COUNT> buckets{};
+	};
+
+	static size_t GetThreadSlot()
+	{
+		thread_local const size_t slot = nextSlot.fetch_add(1, std::memory_order_relaxed) % MAX_THREAD_SLOTS;
+		return slot;
+	}
+
+	static std::array<ThreadSlot, MAX_THREAD_SLOTS> slots;
+	static std::atomic<size_t> nextSlot;
+};
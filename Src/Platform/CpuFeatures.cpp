@@ -0,0 +1,73 @@
+#include "CpuFeatures.h"
+
+#if GEAR_ARCH_X86 && defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace
+{
+	gear::SimdLevel DetectSimdLevel()
+	{
+#if GEAR_ARCH_X86
+#if defined(_MSC_VER) && !defined(__clang__)
+		int info[4] = {};
+		__cpuid(info, 0);
+		const int maxLeaf = info[0];
+
+		__cpuid(info, 1);
+		const bool sse2 = (info[3] & (1 << 26)) != 0;
+		const bool sse42 = (info[2] & (1 << 20)) != 0;
+		const bool osxsave = (info[2] & (1 << 27)) != 0;
+		const bool avx = (info[2] & (1 << 28)) != 0;
+
+		bool avx2 = false;
+		if (maxLeaf >= 7 && osxsave && avx)
+		{
+			// The OS must save the YMM registers on context switches (XCR0 bits 1 and 2)
+			const unsigned long long xcr0 = _xgetbv(0);
+			__cpuidex(info, 7, 0);
+			avx2 = (xcr0 & 0x6) == 0x6 && (info[1] & (1 << 5)) != 0 && (info[1] & (1 << 3)) != 0; // AVX2 + BMI1
+		}
+#else
+		__builtin_cpu_init();
+		const bool sse2 = __builtin_cpu_supports("sse2");
+		const bool sse42 = __builtin_cpu_supports("sse4.2");
+		const bool avx2 = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("bmi");
+#endif
+		if (avx2)
+			return gear::SimdLevel::Avx2;
+		if (sse42)
+			return gear::SimdLevel::Sse42;
+		if (sse2)
+			return gear::SimdLevel::Sse2;
+#endif
+		return gear::SimdLevel::Scalar;
+	}
+}
+
+namespace gear
+{
+	SimdLevel GetSimdLevel()
+	{
+		static const SimdLevel level = DetectSimdLevel();
+		return level;
+	}
+
+	SimdLevel ClampSimdLevel(SimdLevel requested)
+	{
+		const SimdLevel supported = GetSimdLevel();
+		return static_cast<int>(requested) <= static_cast<int>(supported) ? requested : supported;
+	}
+
+	const char* SimdLevelName(SimdLevel level)
+	{
+		switch (level)
+		{
+		case SimdLevel::Scalar: return "Scalar";
+		case SimdLevel::Sse2:   return "SSE2";
+		case SimdLevel::Sse42:  return "SSE4.2";
+		case SimdLevel::Avx2:   return "AVX2";
+		default:                return "Unknown";
+		}
+	}
+}
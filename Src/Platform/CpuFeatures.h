@@ -0,0 +1,41 @@
+#pragma once
+
+// Runtime detection of the SIMD instruction sets used by the vectorized scan kernels.
+// Kernels are compiled per instruction set with GEAR_TARGET_* and selected once at runtime,
+// so the binary still runs on CPUs without AVX2.
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define GEAR_ARCH_X86 1
+#else
+#define GEAR_ARCH_X86 0
+#endif
+
+#if GEAR_ARCH_X86 && (defined(__GNUC__) || defined(__clang__))
+#define GEAR_TARGET_SSE2  __attribute__((target("sse2")))
+#define GEAR_TARGET_SSE42 __attribute__((target("sse4.2")))
+#define GEAR_TARGET_AVX2  __attribute__((target("avx2,bmi")))
+#else
+// MSVC allows all intrinsics without target attributes
+#define GEAR_TARGET_SSE2
+#define GEAR_TARGET_SSE42
+#define GEAR_TARGET_AVX2
+#endif
+
+namespace gear
+{
+	enum class SimdLevel
+	{
+		Scalar, // Portable fallback (also used on non-x86 targets)
+		Sse2,
+		Sse42,
+		Avx2
+	};
+
+	// Best instruction set supported by CPU and OS, detected once
+	SimdLevel GetSimdLevel();
+
+	// Returns 'requested' if supported, otherwise the best supported level below it
+	SimdLevel ClampSimdLevel(SimdLevel requested);
+
+	const char* SimdLevelName(SimdLevel level);
+}
@@ -0,0 +1,152 @@
+#include "MappedFile.h"
+
+#include <utility>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace gear
+{
+	MappedFile::MappedFile(MappedFile&& other) noexcept
+	{
+		*this = std::move(other);
+	}
+
+	MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+	{
+		if (this != &other)
+		{
+			Close();
+			data = std::exchange(other.data, nullptr);
+			size = std::exchange(other.size, 0);
+			isOpen = std::exchange(other.isOpen, false);
+#ifdef _WIN32
+			fileHandle = std::exchange(other.fileHandle, nullptr);
+			mappingHandle = std::exchange(other.mappingHandle, nullptr);
+#endif
+		}
+		return *this;
+	}
+
+#ifdef _WIN32
+	bool MappedFile::Open(const std::filesystem::path& path, std::string* error)
+	{
+		Close();
+
+		auto fail = [&](const char* what)
+			{
+				if (error)
+					*error = std::string(what) + " failed for " + path.string() + " (error " + std::to_string(GetLastError()) + ")";
+				Close();
+				return false;
+			};
+
+		// FILE_SHARE_DELETE: the logger must still be able to rename/remove the file during rotation
+		HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+			nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+		if (file == INVALID_HANDLE_VALUE)
+			return fail("CreateFileW");
+		fileHandle = file;
+
+		LARGE_INTEGER fileSize{};
+		if (!GetFileSizeEx(file, &fileSize))
+			return fail("GetFileSizeEx");
+
+		isOpen = true;
+		if (fileSize.QuadPart == 0)
+			return true; // Windows can't map empty files
+
+		HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (!mapping)
+			return fail("CreateFileMappingW");
+		mappingHandle = mapping;
+
+		const void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+		if (!view)
+			return fail("MapViewOfFile");
+
+		data = static_cast<const char*>(view);
+		size = static_cast<size_t>(fileSize.QuadPart);
+		return true;
+	}
+
+	void MappedFile::Close()
+	{
+		if (data)
+			UnmapViewOfFile(data);
+		if (mappingHandle)
+			CloseHandle(static_cast<HANDLE>(mappingHandle));
+		if (fileHandle)
+			CloseHandle(static_cast<HANDLE>(fileHandle));
+
+		data = nullptr;
+		size = 0;
+		isOpen = false;
+		mappingHandle = nullptr;
+		fileHandle = nullptr;
+	}
+#else
+	bool MappedFile::Open(const std::filesystem::path& path, std::string* error)
+	{
+		Close();
+
+		auto fail = [&](const char* what)
+			{
+				if (error)
+					*error = std::string(what) + " failed for " + path.string() + ": " + std::strerror(errno);
+				return false;
+			};
+
+		const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+		if (fd < 0)
+			return fail("open");
+
+		struct stat st {};
+		if (::fstat(fd, &st) != 0)
+		{
+			fail("fstat");
+			::close(fd);
+			return false;
+		}
+
+		void* view = nullptr;
+		if (st.st_size > 0)
+		{
+			view = ::mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+			if (view == MAP_FAILED)
+			{
+				fail("mmap");
+				::close(fd);
+				return false;
+			}
+		}
+		::close(fd); // The mapping keeps its own reference to the file
+
+		data = static_cast<const char*>(view);
+		size = static_cast<size_t>(st.st_size);
+		isOpen = true;
+		return true;
+	}
+
+	void MappedFile::Close()
+	{
+		if (data)
+			::munmap(const_cast<char*>(data), size);
+
+		data = nullptr;
+		size = 0;
+		isOpen = false;
+	}
+#endif
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+namespace gear
+{
+	// Read-only memory mapping of a whole file (mmap on POSIX, file mapping on Windows).
+	//
+	// The mapping covers the file size at Open() time; data appended later is not visible until the
+	// file is mapped again. The file is opened with full sharing, so a writer can keep appending to it
+	// and LogToFile can still rename it during rotation. It must not be truncated while mapped.
+	class MappedFile
+	{
+	public:
+		MappedFile() = default;
+		~MappedFile() { Close(); }
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+		MappedFile(MappedFile&& other) noexcept;
+		MappedFile& operator=(MappedFile&& other) noexcept;
+
+		// Maps the file, closing any previous mapping. On failure returns false and sets 'error' (if given).
+		// Empty files open successfully with Size() == 0.
+		bool Open(const std::filesystem::path& path, std::string* error = nullptr);
+		void Close();
+
+		bool IsOpen() const { return isOpen; }
+		const char* Data() const { return data; }
+		size_t Size() const { return size; }
+		std::string_view View() const { return std::string_view(data, size); }
+
+	private:
+		const char* data = nullptr;
+		size_t size = 0;
+		bool isOpen = false;
+
+#ifdef _WIN32
+		void* fileHandle = nullptr;
+		void* mappingHandle = nullptr;
+#endif
+	};
+}
@@ -0,0 +1,61 @@
+#include "ProcessCpu.h"
+
+#include <chrono>
+#include <cstdint>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace gear
+{
+	namespace
+	{
+		double NowSeconds()
+		{
+			return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+		}
+	}
+
+	double GetProcessCpuSeconds()
+	{
+#ifdef _WIN32
+		FILETIME creation, exit, kernel, user;
+		if (!GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user))
+			return 0.0;
+		auto toSeconds = [](const FILETIME& time)
+			{
+				return static_cast<double>((static_cast<uint64_t>(time.dwHighDateTime) << 32) | time.dwLowDateTime) * 1e-7; // 100 ns units
+			};
+		return toSeconds(kernel) + toSeconds(user);
+#else
+		rusage usage{};
+		if (getrusage(RUSAGE_SELF, &usage) != 0)
+			return 0.0;
+		return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) * 1e-6;
+#endif
+	}
+
+	float ProcessCpuMeter::Update()
+	{
+		const double wall = NowSeconds();
+		if (lastCpu < 0.0)
+		{
+			lastCpu = GetProcessCpuSeconds();
+			lastWall = wall;
+		}
+		else if (wall - lastWall >= interval)
+		{
+			const double cpu = GetProcessCpuSeconds();
+			percent = static_cast<float>(100.0 * (cpu - lastCpu) / (wall - lastWall));
+			lastCpu = cpu;
+			lastWall = wall;
+		}
+		return percent;
+	}
+}
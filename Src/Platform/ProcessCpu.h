@@ -0,0 +1,24 @@
+#pragma once
+
+namespace gear
+{
+	// User + kernel CPU time of the whole process in seconds (all threads), 0 if unavailable
+	double GetProcessCpuSeconds();
+
+	// CPU load of the process in percent of one core, averaged between two calls at least 'intervalSeconds' apart.
+	// Call on one thread (the frame loop); returns the last average in between.
+	class ProcessCpuMeter
+	{
+	public:
+		explicit ProcessCpuMeter(double intervalSeconds = 1.0) : interval(intervalSeconds) {}
+
+		float Update();
+		float GetPercent() const { return percent; }
+
+	private:
+		double interval;
+		double lastCpu = -1.0;
+		double lastWall = 0.0;
+		float percent = 0.0f;
+	};
+}
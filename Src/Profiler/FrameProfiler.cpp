@@ -0,0 +1,216 @@
+#include "FrameProfiler.h"
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <mutex>
+
+namespace gear
+{
+	namespace
+	{
+		struct OpenZone
+		{
+			const char* name;
+			int64_t startNs;
+		};
+
+		struct ThreadZones
+		{
+			std::mutex mutex;                        // Guards 'front'; the owner appends, EndFrame() swaps
+			std::vector<ProfileZone> front;
+			std::vector<ProfileZone> back;           // Only touched by EndFrame()
+			std::atomic<bool> inUse{ true };
+			uint16_t index = 0;
+			std::string name;                        // Guarded by registryMutex
+
+			// Owner thread only
+			std::array<OpenZone, FrameProfiler::MAX_DEPTH> stack{};
+			size_t depth = 0;
+			uint32_t epoch = 0;
+		};
+
+		// Bumped on every enable: open zones left on a stack while disabled are discarded
+		std::atomic<uint32_t> epoch{ 1 };
+
+		std::mutex registryMutex;
+		std::vector<std::unique_ptr<ThreadZones>> threads;
+
+		// Frame ring, EndFrame() thread only
+		std::array<ProfileFrame, FrameProfiler::MAX_FRAMES> frames;
+		size_t frameCount = 0;
+		size_t nextFrame = 0;
+		uint64_t frameIndex = 0;
+		int64_t frameStartNs = 0;
+
+		int64_t NowNs()
+		{
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+		}
+
+		// Releases the slot when the thread exits, so a new thread can take it over
+		struct ThreadHandle
+		{
+			ThreadZones* zones = nullptr;
+			std::string name;
+
+			~ThreadHandle()
+			{
+				if (zones)
+					zones->inUse.store(false, std::memory_order_release);
+			}
+		};
+		thread_local ThreadHandle localHandle;
+
+		ThreadZones& LocalZones()
+		{
+			if (localHandle.zones)
+				return *localHandle.zones;
+
+			std::lock_guard lock(registryMutex);
+			ThreadZones* zones = nullptr;
+			for (const auto& candidate : threads)
+			{
+				bool expected = false;
+				if (candidate->inUse.compare_exchange_strong(expected, true, std::memory_order_acq_rel))
+				{
+					zones = candidate.get();
+					break;
+				}
+			}
+			if (!zones)
+			{
+				threads.push_back(std::make_unique<ThreadZones>());
+				zones = threads.back().get();
+				zones->index = static_cast<uint16_t>(threads.size() - 1);
+			}
+
+			zones->depth = 0;
+			zones->name = localHandle.name.empty() ? "Thread " + std::to_string(zones->index + 1) : localHandle.name;
+			localHandle.zones = zones;
+			return *zones;
+		}
+	}
+
+	void FrameProfiler::SetEnabled(bool enable)
+	{
+		if (enable && !enabled.load(std::memory_order_relaxed))
+		{
+			// Start clean: no zones from before, and the disabled time doesn't count as one long frame
+			epoch.fetch_add(1, std::memory_order_relaxed);
+			std::lock_guard lock(registryMutex);
+			for (const auto& thread : threads)
+			{
+				std::lock_guard zoneLock(thread->mutex);
+				thread->front.clear();
+			}
+			frameStartNs = NowNs();
+		}
+		enabled.store(enable, std::memory_order_relaxed);
+	}
+
+	void FrameProfiler::PushZone(const char* name)
+	{
+		ThreadZones& zones = LocalZones();
+		const uint32_t currentEpoch = epoch.load(std::memory_order_relaxed);
+		if (zones.epoch != currentEpoch)
+		{
+			zones.epoch = currentEpoch;
+			zones.depth = 0;
+		}
+		if (zones.depth < MAX_DEPTH)
+			zones.stack[zones.depth] = OpenZone{ name, NowNs() };
+		++zones.depth; // Zones deeper than MAX_DEPTH are counted but not recorded
+	}
+
+	void FrameProfiler::PopZone(const char* name)
+	{
+		ThreadZones& zones = LocalZones();
+		if (zones.depth == 0 || zones.epoch != epoch.load(std::memory_order_relaxed))
+			return;
+		if (zones.depth > MAX_DEPTH)
+		{
+			--zones.depth;
+			return;
+		}
+
+		const OpenZone& open = zones.stack[zones.depth - 1];
+		if (open.name != name && std::strcmp(open.name, name) != 0)
+			return; // Began while the profiler was disabled
+		--zones.depth;
+
+		// Stored as absolute times, EndFrame() makes them frame-relative
+		const ProfileZone zone{ open.name, open.startNs, NowNs(), static_cast<uint16_t>(zones.depth), zones.index };
+		std::lock_guard lock(zones.mutex);
+		zones.front.push_back(zone);
+	}
+
+	void FrameProfiler::EndFrame()
+	{
+		if (!enabled.load(std::memory_order_relaxed))
+			return;
+
+		const int64_t now = NowNs();
+		ProfileFrame& frame = frames[nextFrame];
+		frame.index = frameIndex++;
+		frame.startNs = frameStartNs;
+		frame.durationNs = now - frameStartNs;
+		frame.zones.clear();
+
+		{
+			std::lock_guard lock(registryMutex);
+			for (const auto& thread : threads)
+			{
+				{
+					std::lock_guard zoneLock(thread->mutex);
+					thread->front.swap(thread->back);
+				}
+				for (ProfileZone zone : thread->back)
+				{
+					zone.startNs -= frameStartNs;
+					zone.endNs -= frameStartNs;
+					frame.zones.push_back(zone);
+				}
+				thread->back.clear();
+			}
+		}
+
+		nextFrame = (nextFrame + 1) % MAX_FRAMES;
+		frameCount = std::min(frameCount + 1, MAX_FRAMES);
+		frameStartNs = now;
+	}
+
+	size_t FrameProfiler::GetFrameCount()
+	{
+		return frameCount;
+	}
+
+	const ProfileFrame& FrameProfiler::GetFrame(size_t index)
+	{
+		return frames[(nextFrame + MAX_FRAMES - frameCount + index) % MAX_FRAMES];
+	}
+
+	void FrameProfiler::SetThreadName(const std::string& name)
+	{
+		localHandle.name = name;
+		if (localHandle.zones)
+		{
+			std::lock_guard lock(registryMutex);
+			localHandle.zones->name = name;
+		}
+	}
+
+	std::string FrameProfiler::GetThreadName(uint16_t thread)
+	{
+		std::lock_guard lock(registryMutex);
+		return thread < threads.size() ? threads[thread]->name : std::string();
+	}
+
+	size_t FrameProfiler::GetThreadCount()
+	{
+		std::lock_guard lock(registryMutex);
+		return threads.size();
+	}
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace gear
+{
+	// One finished zone. Times are steady_clock ns relative to the start of its frame.
+	struct ProfileZone
+	{
+		const char* name;   // String literal of the trace point
+		int64_t startNs;
+		int64_t endNs;
+		uint16_t depth;     // Nesting level on its thread, 0 = outermost
+		uint16_t thread;    // Index into FrameProfiler::GetThreadName()
+	};
+
+	struct ProfileFrame
+	{
+		uint64_t index = 0;
+		int64_t startNs = 0;   // steady_clock
+		int64_t durationNs = 0;
+		std::vector<ProfileZone> zones; // In end order (children before their parent)
+	};
+
+	// In-process hierarchical zone profiler fed by GEAR_TRACE_SCOPE / GEAR_TRACE_BEGIN / END.
+	//
+	// Each thread keeps a small stack of open zones and appends finished ones to the front half of its own
+	// double buffer (per-thread mutex, only contended for the swap). EndFrame(), called once per frame by the
+	// frame loop, swaps every thread's buffers and moves the finished zones into a ring of the last
+	// MAX_FRAMES frames, whose zone vectors keep their capacity. Disabled (the default) a zone costs one
+	// relaxed load; Application enables it while the Profiler window is open.
+	//
+	// A zone belongs to the frame in which it ends. Frames and thread names may only be read on the thread
+	// that calls EndFrame().
+	class FrameProfiler
+	{
+	public:
+		static constexpr size_t MAX_FRAMES = 300;
+		static constexpr size_t MAX_DEPTH = 64;
+
+		// Call on the EndFrame() thread. Enabling starts a fresh frame and drops zones still open from before.
+		static void SetEnabled(bool enable);
+		static bool IsEnabled() { return enabled.load(std::memory_order_relaxed); }
+
+		static void BeginZone(const char* name)
+		{
+			if (enabled.load(std::memory_order_relaxed))
+				PushZone(name);
+		}
+
+		// Ends the innermost open zone if it is 'name' (zones opened while disabled are not on the stack)
+		static void EndZone(const char* name)
+		{
+			if (enabled.load(std::memory_order_relaxed))
+				PopZone(name);
+		}
+
+		// Closes the current frame (starting at the previous EndFrame()) and collects the zones of all threads
+		static void EndFrame();
+
+		// Frames in the ring, 0 = oldest
+		static size_t GetFrameCount();
+		static const ProfileFrame& GetFrame(size_t index);
+
+		static void SetThreadName(const std::string& name);
+		static std::string GetThreadName(uint16_t thread);
+		static size_t GetThreadCount();
+
+	private:
+		static void PushZone(const char* name);
+		static void PopZone(const char* name);
+
+		static inline std::atomic<bool> enabled{ false };
+	};
+}
@@ -0,0 +1,274 @@
+#include "TraceRecorder.h"
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <fmt/format.h>
+
+#include "Platform/CpuFeatures.h"
+#include "Utils/JsonString.h"
+
+#if GEAR_ARCH_X86
+#ifdef _MSC_VER
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
+#ifdef _WIN32
+#include <process.h>
+#define GEAR_GETPID _getpid
+#else
+#include <unistd.h>
+#define GEAR_GETPID ::getpid
+#endif
+
+namespace gear
+{
+	namespace
+	{
+		struct ThreadBuffer
+		{
+			std::unique_ptr<TraceEvent[]> events{ new TraceEvent[TraceRecorder::EVENTS_PER_THREAD] };
+			std::atomic<size_t> count{ 0 };        // Published events, written by the owning thread only
+			std::atomic<uint64_t> dropped{ 0 };
+			std::atomic<uint32_t> generation{ 0 }; // Capture the events belong to
+			std::atomic<bool> inUse{ true };       // Owned by a running thread
+			uint32_t threadId = 0;
+			std::string threadName;                // Guarded by registryMutex
+		};
+
+		std::atomic<bool> capturing{ false };
+		std::atomic<uint32_t> generation{ 0 };
+
+		// Clock calibration of the capture, guarded by registryMutex
+		int64_t startTicks = 0;
+		int64_t startNs = 0;
+		int64_t stopTicks = 0;
+		int64_t stopNs = 0;
+
+		std::mutex registryMutex;
+		std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+
+		int64_t NowNs()
+		{
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+		}
+
+		// Event timestamps: the TSC on x86 (invariant on every CPU GEAR targets) costs a fraction of
+		// steady_clock::now(); ticks are converted to ns on export, calibrated over the whole capture.
+		int64_t NowTicks()
+		{
+#if GEAR_ARCH_X86
+			return static_cast<int64_t>(__rdtsc());
+#else
+			return NowNs();
+#endif
+		}
+
+		// Releases the buffer when the thread exits, so a new thread can take it over
+		struct ThreadHandle
+		{
+			ThreadBuffer* buffer = nullptr;
+			std::string name;
+
+			~ThreadHandle()
+			{
+				if (buffer)
+					buffer->inUse.store(false, std::memory_order_release);
+			}
+		};
+		thread_local ThreadHandle localHandle;
+
+		// Buffers still holding events of the current capture are never handed to another thread
+		ThreadBuffer* AcquireBuffer(uint32_t currentGeneration)
+		{
+			std::lock_guard lock(registryMutex);
+
+			ThreadBuffer* buffer = nullptr;
+			for (const auto& candidate : buffers)
+			{
+				if (!candidate->inUse.load(std::memory_order_acquire)
+					&& candidate->generation.load(std::memory_order_relaxed) != currentGeneration)
+				{
+					buffer = candidate.get();
+					buffer->inUse.store(true, std::memory_order_relaxed);
+					break;
+				}
+			}
+			if (!buffer)
+			{
+				buffers.push_back(std::make_unique<ThreadBuffer>());
+				buffer = buffers.back().get();
+				buffer->threadId = static_cast<uint32_t>(buffers.size());
+			}
+
+			buffer->threadName = localHandle.name.empty() ? "Thread " + std::to_string(buffer->threadId) : localHandle.name;
+			return buffer;
+		}
+	}
+
+	void TraceRecorder::Start()
+	{
+		std::lock_guard lock(registryMutex);
+		startNs = NowNs();
+		startTicks = NowTicks();
+		stopTicks = 0;
+		generation.fetch_add(1, std::memory_order_release); // Threads reset their buffer on their next event
+		capturing.store(true, std::memory_order_release);
+	}
+
+	void TraceRecorder::Stop()
+	{
+		std::lock_guard lock(registryMutex);
+		if (!capturing.exchange(false, std::memory_order_acq_rel))
+			return;
+		stopNs = NowNs();
+		stopTicks = NowTicks();
+	}
+
+	bool TraceRecorder::IsCapturing()
+	{
+		return capturing.load(std::memory_order_relaxed);
+	}
+
+	void TraceRecorder::SetThreadName(const std::string& name)
+	{
+		FrameProfiler::SetThreadName(name);
+		localHandle.name = name;
+		if (localHandle.buffer)
+		{
+			std::lock_guard lock(registryMutex);
+			localHandle.buffer->threadName = name;
+		}
+	}
+
+	void TraceRecorder::Record(const char* name, TraceEventType type)
+	{
+		if (!capturing.load(std::memory_order_relaxed))
+			return;
+
+		const int64_t timestamp = NowTicks();
+		const uint32_t currentGeneration = generation.load(std::memory_order_acquire);
+
+		ThreadBuffer* buffer = localHandle.buffer;
+		if (!buffer || buffer->generation.load(std::memory_order_relaxed) != currentGeneration)
+		{
+			if (!buffer)
+				buffer = localHandle.buffer = AcquireBuffer(currentGeneration);
+
+			// First event of this thread in the capture: drop the previous capture's events
+			buffer->count.store(0, std::memory_order_relaxed);
+			buffer->dropped.store(0, std::memory_order_relaxed);
+			buffer->generation.store(currentGeneration, std::memory_order_release);
+		}
+
+		const size_t index = buffer->count.load(std::memory_order_relaxed);
+		if (index >= EVENTS_PER_THREAD)
+		{
+			buffer->dropped.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+
+		buffer->events[index] = TraceEvent{ timestamp, name, type };
+		buffer->count.store(index + 1, std::memory_order_release);
+	}
+
+	size_t TraceRecorder::GetEventCount()
+	{
+		std::lock_guard lock(registryMutex);
+		const uint32_t currentGeneration = generation.load(std::memory_order_acquire);
+		size_t total = 0;
+		for (const auto& buffer : buffers)
+			if (buffer->generation.load(std::memory_order_acquire) == currentGeneration)
+				total += buffer->count.load(std::memory_order_acquire);
+		return total;
+	}
+
+	uint64_t TraceRecorder::GetDroppedCount()
+	{
+		std::lock_guard lock(registryMutex);
+		const uint32_t currentGeneration = generation.load(std::memory_order_acquire);
+		uint64_t total = 0;
+		for (const auto& buffer : buffers)
+			if (buffer->generation.load(std::memory_order_acquire) == currentGeneration)
+				total += buffer->dropped.load(std::memory_order_relaxed);
+		return total;
+	}
+
+	void TraceRecorder::WriteChromeTrace(std::ostream& out)
+	{
+		std::lock_guard lock(registryMutex);
+		const uint32_t currentGeneration = generation.load(std::memory_order_acquire);
+		// Ticks per ns over the capture (up to now while it is still running)
+		const int64_t endTicks = stopTicks != 0 ? stopTicks : NowTicks();
+		const int64_t endNs = stopTicks != 0 ? stopNs : NowNs();
+		const double nsPerTick = endTicks > startTicks && endNs > startNs
+			? static_cast<double>(endNs - startNs) / static_cast<double>(endTicks - startTicks) : 1.0;
+		const int pid = static_cast<int>(GEAR_GETPID());
+
+		// Formatted in chunks, timestamps in microseconds relative to the capture start
+		fmt::memory_buffer json;
+		fmt::format_to(std::back_inserter(json),
+			"{{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n"
+			"{{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":{},\"tid\":0,\"args\":{{\"name\":\"GEAR\"}}}}", pid);
+
+		for (const auto& buffer : buffers)
+		{
+			if (buffer->generation.load(std::memory_order_acquire) != currentGeneration)
+				continue;
+
+			fmt::format_to(std::back_inserter(json), ",\n{{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":{},\"tid\":{},\"args\":{{\"name\":", pid, buffer->threadId);
+			AppendJsonString(json, buffer->threadName);
+			json.append(std::string_view("}}"));
+
+			const size_t count = buffer->count.load(std::memory_order_acquire);
+			for (size_t i = 0; i < count; ++i)
+			{
+				const TraceEvent& event = buffer->events[i];
+				json.append(std::string_view(",\n{\"name\":"));
+				AppendJsonString(json, event.name);
+				fmt::format_to(std::back_inserter(json), ",\"ph\":\"{}\",\"ts\":{:.3f},\"pid\":{},\"tid\":{}}}",
+					event.type == TraceEventType::Begin ? 'B' : 'E', (event.ticks - startTicks) * nsPerTick / 1000.0, pid, buffer->threadId);
+
+				if (json.size() > 1024 * 1024)
+				{
+					out.write(json.data(), static_cast<std::streamsize>(json.size()));
+					json.clear();
+				}
+			}
+		}
+
+		json.append(std::string_view("\n]}\n"));
+		out.write(json.data(), static_cast<std::streamsize>(json.size()));
+	}
+
+	bool TraceRecorder::ExportChromeTrace(const std::filesystem::path& path, std::string* error)
+	{
+		std::error_code ec;
+		if (path.has_parent_path())
+			std::filesystem::create_directories(path.parent_path(), ec);
+
+		std::ofstream out(path, std::ios::binary | std::ios::trunc);
+		if (!out)
+		{
+			if (error)
+				*error = "Cannot open '" + path.string() + "' for writing";
+			return false;
+		}
+
+		WriteChromeTrace(out);
+		out.flush();
+		if (!out)
+		{
+			if (error)
+				*error = "Writing '" + path.string() + "' failed";
+			return false;
+		}
+		return true;
+	}
+}
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <ostream>
+#include <string>
+
+#include "Profiler/FrameProfiler.h"
+
+namespace gear
+{
+	enum class TraceEventType : uint8_t { Begin, End };
+
+	struct TraceEvent
+	{
+		int64_t ticks;        // CPU timestamp counter on x86, steady_clock ns elsewhere
+		const char* name;     // Must outlive the capture (string literal)
+		TraceEventType type;
+	};
+
+	// Process-wide span recorder behind the GEAR_TRACE_* macros.
+	//
+	// Every thread records into its own fixed-size buffer (single writer, published with a release store),
+	// so recording takes no lock and allocates nothing after the thread's first event of a capture. While no
+	// capture runs a trace point costs one relaxed load. A full buffer drops further events of that thread
+	// (counted). Buffers of exited threads are reused by new threads in the next capture.
+	//
+	// The capture is exported as Chrome Trace Event JSON, which chrome://tracing, Perfetto (ui.perfetto.dev)
+	// and Speedscope open directly.
+	class TraceRecorder
+	{
+	public:
+		static constexpr size_t EVENTS_PER_THREAD = 1 << 18; // 6 MB per recording thread
+
+		// Starts a new capture and discards the previous one
+		static void Start();
+		static void Stop();
+		static bool IsCapturing();
+
+		static void Begin(const char* name) { Record(name, TraceEventType::Begin); }
+		static void End(const char* name) { Record(name, TraceEventType::End); }
+
+		// Name shown for the calling thread in exported traces and the Profiler window (default "Thread N")
+		static void SetThreadName(const std::string& name);
+
+		static size_t GetEventCount();
+		static uint64_t GetDroppedCount();
+
+		// Writes the last capture (also while it is still running) as Chrome Trace Event JSON
+		static void WriteChromeTrace(std::ostream& out);
+		static bool ExportChromeTrace(const std::filesystem::path& path, std::string* error = nullptr);
+
+	private:
+		static void Record(const char* name, TraceEventType type);
+	};
+
+	// RAII span for GEAR_TRACE_SCOPE, also a zone of the frame profiler
+	class TraceScope
+	{
+	public:
+		explicit TraceScope(const char* name) : name(name)
+		{
+			TraceRecorder::Begin(name);
+			FrameProfiler::BeginZone(name);
+		}
+		~TraceScope()
+		{
+			FrameProfiler::EndZone(name);
+			TraceRecorder::End(name);
+		}
+
+		TraceScope(const TraceScope&) = delete;
+		TraceScope& operator=(const TraceScope&) = delete;
+
+	private:
+		const char* name;
+	};
+}
+
+// Trace points, feeding both TraceRecorder captures and the FrameProfiler; 'name' must be a string literal.
+// Define GEAR_DISABLE_TRACE to compile them out.
+#define GEAR_TRACE_CONCAT_INNER(a, b) a##b
+#define GEAR_TRACE_CONCAT(a, b) GEAR_TRACE_CONCAT_INNER(a, b)
+
+#ifndef GEAR_DISABLE_TRACE
+#define GEAR_TRACE_SCOPE(name) ::gear::TraceScope GEAR_TRACE_CONCAT(gearTraceScope, __LINE__)(name)
+#define GEAR_TRACE_BEGIN(name) (::gear::TraceRecorder::Begin(name), ::gear::FrameProfiler::BeginZone(name))
+#define GEAR_TRACE_END(name) (::gear::FrameProfiler::EndZone(name), ::gear::TraceRecorder::End(name))
+#else
+#define GEAR_TRACE_SCOPE(name) ((void)0)
+#define GEAR_TRACE_BEGIN(name) ((void)0)
+#define GEAR_TRACE_END(name) ((void)0)
+#endif
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+// Binary indexed tree over 'size' values: point updates, prefix sums and the search for the element covering
+// a running total, all O(log n). Used for the row heights of the Logger window's wrapped rows, where the sum
+// above a row is its y position and the search maps a scroll position back to a row. Values must not be
+// negative for UpperBound().
+namespace gear
+{
+	template<typename T>
+	class FenwickTree
+	{
+	public:
+		FenwickTree() = default;
+		explicit FenwickTree(size_t size, T value = T()) { Reset(size, value); }
+
+		// Sets 'size' elements to 'value', O(n)
+		void Reset(size_t size, T value = T())
+		{
+			values.assign(size, value);
+			tree.assign(size + 1, T());
+			for (size_t i = 1; i <= size; ++i)
+			{
+				tree[i] += value;
+				const size_t parent = i + LowBit(i);
+				if (parent <= size)
+					tree[parent] += tree[i];
+			}
+		}
+
+		size_t Size() const { return values.size(); }
+		T Get(size_t index) const { return values[index]; }
+
+		void Set(size_t index, T value)
+		{
+			const T delta = value - values[index];
+			values[index] = value;
+			for (size_t i = index + 1; i < tree.size(); i += LowBit(i))
+				tree[i] += delta;
+		}
+
+		// Sum of the first 'count' elements
+		T PrefixSum(size_t count) const
+		{
+			T sum = T();
+			for (size_t i = count; i > 0; i -= LowBit(i))
+				sum += tree[i];
+			return sum;
+		}
+
+		T Total() const { return PrefixSum(values.size()); }
+
+		// Number of leading elements whose sum is <= 'target', i.e. the index of the element that covers the
+		// position 'target' (Size() if 'target' is at or behind the end)
+		size_t UpperBound(T target) const
+		{
+			size_t step = 1;
+			while (step * 2 <= values.size())
+				step *= 2;
+
+			size_t position = 0;
+			for (; step > 0; step /= 2)
+			{
+				if (position + step <= values.size() && tree[position + step] <= target)
+				{
+					position += step;
+					target -= tree[position];
+				}
+			}
+			return position;
+		}
+
+	private:
+		static size_t LowBit(size_t i) { return i & (~i + 1); }
+
+		std::vector<T> values;
+		std::vector<T> tree; // 1-based, tree[i] = sum of the LowBit(i) values ending at element i - 1
+	};
+}
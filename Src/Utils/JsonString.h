@@ -0,0 +1,27 @@
+#pragma once
+
+#include <iterator>
+#include <string_view>
+#include <fmt/format.h>
+
+namespace gear
+{
+	// Appends 'text' as a quoted JSON string (quotes, backslashes and control characters escaped, UTF-8 kept)
+	inline void AppendJsonString(fmt::memory_buffer& out, std::string_view text)
+	{
+		out.push_back('"');
+		for (char c : text)
+		{
+			if (c == '"' || c == '\\')
+			{
+				out.push_back('\\');
+				out.push_back(c);
+			}
+			else if (static_cast<unsigned char>(c) < 0x20)
+				fmt::format_to(std::back_inserter(out), "\\u{:04x}", static_cast<int>(c));
+			else
+				out.push_back(c);
+		}
+		out.push_back('"');
+	}
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace gear
+{
+	// Redraw requests for the idle-aware frame loop (Application::Run).
+	//
+	// With idle rendering on, the loop blocks in glfwWaitEventsTimeout() once input has settled instead of redrawing
+	// at vsync. Whatever changes the GUI from another thread (log pushes, data workers, background scans) calls
+	// RequestRedraw(): the first request since the last frame sets a dirty flag and wakes the loop through the wake
+	// function (glfwPostEmptyEvent, installed by Application); further requests cost one relaxed load until the
+	// loop consumes the flag. The loop still wakes after GetMaxIdleSeconds(), so clocks and once-per-second
+	// statistics keep updating.
+	class RedrawScheduler
+	{
+	public:
+		static constexpr double DEFAULT_MAX_IDLE_SECONDS = 0.5;
+
+		static void RequestRedraw()
+		{
+			if (!pending.load(std::memory_order_relaxed) && !pending.exchange(true, std::memory_order_acq_rel))
+			{
+				if (void (*wake)() = wakeFunction.load(std::memory_order_acquire))
+					wake();
+			}
+		}
+
+		// Frame loop: true if a redraw was requested since the last call
+		static bool ConsumeRequest() { return pending.exchange(false, std::memory_order_acq_rel); }
+
+		// Must be reset to nullptr before the window system shuts down
+		static void SetWakeFunction(void (*wake)()) { wakeFunction.store(wake, std::memory_order_release); }
+
+		// Off: the loop redraws every frame (vsync paced)
+		static void SetIdleEnabled(bool enable) { idleEnabled.store(enable, std::memory_order_relaxed); }
+		static bool IsIdleEnabled() { return idleEnabled.load(std::memory_order_relaxed); }
+
+		// Longest wait without input or requests
+		static void SetMaxIdleSeconds(double seconds) { maxIdleSeconds.store(seconds, std::memory_order_relaxed); }
+		static double GetMaxIdleSeconds() { return maxIdleSeconds.load(std::memory_order_relaxed); }
+
+	private:
+		static inline std::atomic<bool> pending{ true };
+		static inline std::atomic<void (*)()> wakeFunction{ nullptr };
+		static inline std::atomic<bool> idleEnabled{ true };
+		static inline std::atomic<double> maxIdleSeconds{ DEFAULT_MAX_IDLE_SECONDS };
+	};
+}
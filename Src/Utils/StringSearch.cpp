@@ -0,0 +1,149 @@
+#include "StringSearch.h"
+
+#include <bit>
+#include <cstdint>
+
+#if GEAR_ARCH_X86
+#include <immintrin.h>
+#endif
+
+namespace
+{
+	using gear::ToLowerAscii;
+
+	size_t FindScalar(const char* haystack, size_t begin, size_t last, const char* needle, size_t needleSize)
+	{
+		const char first = ToLowerAscii(needle[0]);
+		for (size_t i = begin; i <= last; ++i)
+		{
+			if (ToLowerAscii(haystack[i]) == first && gear::EqualsNoCase(haystack + i + 1, needle + 1, needleSize - 1))
+				return i;
+		}
+		return gear::NOT_FOUND;
+	}
+
+	// Verifies the candidates in 'bits' (bit k = position i + k), first and last byte already match
+	inline size_t VerifyCandidates(uint32_t bits, size_t i, const char* haystack, const char* needle, size_t needleSize)
+	{
+		while (bits)
+		{
+			const size_t pos = i + std::countr_zero(bits);
+			if (needleSize <= 2 || gear::EqualsNoCase(haystack + pos + 1, needle + 1, needleSize - 2))
+				return pos;
+			bits &= bits - 1;
+		}
+		return gear::NOT_FOUND;
+	}
+
+#if GEAR_ARCH_X86
+	// Folds 'A'-'Z' to lower case. Bytes >= 0x80 are negative in the signed compares and stay unchanged.
+	GEAR_TARGET_SSE2
+	inline __m128i ToLower16(__m128i v)
+	{
+		const __m128i isUpper = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('A' - 1)), _mm_cmplt_epi8(v, _mm_set1_epi8('Z' + 1)));
+		return _mm_or_si128(v, _mm_and_si128(isUpper, _mm_set1_epi8(0x20)));
+	}
+
+	GEAR_TARGET_AVX2
+	inline __m256i ToLower32(__m256i v)
+	{
+		const __m256i isUpper = _mm256_and_si256(_mm256_cmpgt_epi8(v, _mm256_set1_epi8('A' - 1)), _mm256_cmpgt_epi8(_mm256_set1_epi8('Z' + 1), v));
+		return _mm256_or_si256(v, _mm256_and_si256(isUpper, _mm256_set1_epi8(0x20)));
+	}
+
+	GEAR_TARGET_SSE2
+	size_t FindSse2(const char* haystack, size_t last, const char* needle, size_t needleSize)
+	{
+		const __m128i first = _mm_set1_epi8(ToLowerAscii(needle[0]));
+		const __m128i lastChar = _mm_set1_epi8(ToLowerAscii(needle[needleSize - 1]));
+
+		size_t i = 0;
+		for (; i + 16 <= last + 1; i += 16)
+		{
+			const __m128i blockFirst = ToLower16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(haystack + i)));
+			const __m128i blockLast = ToLower16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(haystack + i + needleSize - 1)));
+			const uint32_t bits = static_cast<uint32_t>(_mm_movemask_epi8(
+				_mm_and_si128(_mm_cmpeq_epi8(blockFirst, first), _mm_cmpeq_epi8(blockLast, lastChar))));
+
+			const size_t pos = VerifyCandidates(bits, i, haystack, needle, needleSize);
+			if (pos != gear::NOT_FOUND)
+				return pos;
+		}
+		return FindScalar(haystack, i, last, needle, needleSize);
+	}
+
+	GEAR_TARGET_AVX2
+	size_t FindAvx2(const char* haystack, size_t last, const char* needle, size_t needleSize)
+	{
+		const __m256i first = _mm256_set1_epi8(ToLowerAscii(needle[0]));
+		const __m256i lastChar = _mm256_set1_epi8(ToLowerAscii(needle[needleSize - 1]));
+
+		size_t i = 0;
+		for (; i + 32 <= last + 1; i += 32)
+		{
+			const __m256i blockFirst = ToLower32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(haystack + i)));
+			const __m256i blockLast = ToLower32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(haystack + i + needleSize - 1)));
+			const uint32_t bits = static_cast<uint32_t>(_mm256_movemask_epi8(
+				_mm256_and_si256(_mm256_cmpeq_epi8(blockFirst, first), _mm256_cmpeq_epi8(blockLast, lastChar))));
+
+			const size_t pos = VerifyCandidates(bits, i, haystack, needle, needleSize);
+			if (pos != gear::NOT_FOUND)
+				return pos;
+		}
+
+		// Remaining positions in 16 byte blocks. Kept in this function (VEX encoded) instead of calling
+		// FindSse2, mixing legacy SSE code after 256 bit instructions costs more than it saves.
+		const __m128i first16 = _mm256_castsi256_si128(first);
+		const __m128i last16 = _mm256_castsi256_si128(lastChar);
+		for (; i + 16 <= last + 1; i += 16)
+		{
+			const __m128i blockFirst = ToLower16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(haystack + i)));
+			const __m128i blockLast = ToLower16(_mm_loadu_si128(reinterpret_cast<const __m128i*>(haystack + i + needleSize - 1)));
+			const uint32_t bits = static_cast<uint32_t>(_mm_movemask_epi8(
+				_mm_and_si128(_mm_cmpeq_epi8(blockFirst, first16), _mm_cmpeq_epi8(blockLast, last16))));
+
+			const size_t pos = VerifyCandidates(bits, i, haystack, needle, needleSize);
+			if (pos != gear::NOT_FOUND)
+				return pos;
+		}
+		return FindScalar(haystack, i, last, needle, needleSize);
+	}
+#endif
+}
+
+namespace gear
+{
+	bool EqualsNoCase(const char* a, const char* b, size_t size)
+	{
+		for (size_t i = 0; i < size; ++i)
+		{
+			if (ToLowerAscii(a[i]) != ToLowerAscii(b[i]))
+				return false;
+		}
+		return true;
+	}
+
+	size_t FindNoCase(const char* haystack, size_t haystackSize, const char* needle, size_t needleSize, SimdLevel simd)
+	{
+		if (needleSize == 0)
+			return 0;
+		if (needleSize > haystackSize)
+			return NOT_FOUND;
+
+		const size_t last = haystackSize - needleSize; // Last possible start position
+
+#if GEAR_ARCH_X86
+		switch (ClampSimdLevel(simd))
+		{
+		case SimdLevel::Avx2:
+			return FindAvx2(haystack, last, needle, needleSize);
+		case SimdLevel::Sse42:
+		case SimdLevel::Sse2:
+			return FindSse2(haystack, last, needle, needleSize);
+		default:
+			break;
+		}
+#endif
+		return FindScalar(haystack, 0, last, needle, needleSize);
+	}
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+#include <string_view>
+#include <cstddef>
+
+#include "Platform/CpuFeatures.h"
+
+// Allocation-free, ASCII case-insensitive string search used by the Logger filter and the Icon Picker.
+//
+// Only 'A'-'Z' / 'a'-'z' are folded (like tolower() in the "C" locale), all other bytes including
+// UTF-8 sequences must match exactly. FindNoCase() checks the first and last needle byte of 16 (SSE2)
+// or 32 (AVX2) candidate positions at once and only compares the full needle where both match.
+namespace gear
+{
+	constexpr size_t NOT_FOUND = static_cast<size_t>(-1);
+
+	constexpr char ToLowerAscii(char c)
+	{
+		return (c >= 'A' && c <= 'Z') ? static_cast<char>(c + ('a' - 'A')) : c;
+	}
+
+	// Returns the position of the first case-insensitive occurrence of 'needle' in 'haystack',
+	// NOT_FOUND if there is none. An empty needle matches at position 0.
+	// 'simd' limits the instruction set (mainly for tests), the best supported one is used by default.
+	size_t FindNoCase(const char* haystack, size_t haystackSize, const char* needle, size_t needleSize,
+		SimdLevel simd = SimdLevel::Avx2);
+
+	inline size_t FindNoCase(std::string_view haystack, std::string_view needle, SimdLevel simd = SimdLevel::Avx2)
+	{
+		return FindNoCase(haystack.data(), haystack.size(), needle.data(), needle.size(), simd);
+	}
+
+	inline bool ContainsNoCase(std::string_view haystack, std::string_view needle)
+	{
+		return FindNoCase(haystack, needle) != NOT_FOUND;
+	}
+
+	bool EqualsNoCase(const char* a, const char* b, size_t size);
+
+	inline bool EqualsNoCase(std::string_view a, std::string_view b)
+	{
+		return a.size() == b.size() && EqualsNoCase(a.data(), b.data(), a.size());
+	}
+
+	inline bool StartsWithNoCase(std::string_view text, std::string_view prefix)
+	{
+		return text.size() >= prefix.size() && EqualsNoCase(text.data(), prefix.data(), prefix.size());
+	}
+}
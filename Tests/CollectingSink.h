@@ -0,0 +1,54 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "Logger/LogMessage.h"
+
+// Collects what a background reader (LogFileTail, ShmLogConsumer, LogSocketServer) forwards to its sink.
+// 'SinkType' is the reader's sink, taking either a std::vector<LogMessage>& or a (LogMessage*, size_t) batch.
+template<typename SinkType>
+struct CollectingSink
+{
+	std::mutex mutex;
+	std::vector<LogMessage> messages;
+	std::atomic<size_t> count{ 0 };
+	std::atomic<bool> blocked{ false }; // Holds the reader in the sink until cleared
+	bool keep = true;                   // False: only count, for throughput tests
+
+	SinkType Get()
+	{
+		if constexpr (std::is_invocable_v<SinkType, std::vector<LogMessage>&>)
+			return [this](std::vector<LogMessage>& batch) { Add(batch.data(), batch.size()); };
+		else
+			return [this](LogMessage* batch, size_t n) { Add(batch, n); };
+	}
+
+	size_t Count() const { return count.load(); }
+
+	bool WaitFor(size_t expected, std::chrono::seconds timeout = std::chrono::seconds(5))
+	{
+		const auto deadline = std::chrono::steady_clock::now() + timeout;
+		while (Count() < expected && std::chrono::steady_clock::now() < deadline)
+			std::this_thread::sleep_for(std::chrono::milliseconds(2));
+		return Count() >= expected;
+	}
+
+private:
+	void Add(const LogMessage* batch, size_t n)
+	{
+		while (blocked)
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+		if (keep)
+		{
+			std::lock_guard lock(mutex);
+			messages.insert(messages.end(), batch, batch + n);
+		}
+		count += n;
+	}
+};
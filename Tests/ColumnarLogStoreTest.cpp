@@ -0,0 +1,137 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <vector>
+#include <random>
+
+#include "Logger/ColumnarLogStore.h"
+#include "Logger/CircularLogBuffer.h"
+
+namespace
+{
+	// Builds 'count' entries spread over one hour ending at 'end', ~1% errors
+	void FillStores(size_t count, int64_t endNs, std::vector<LogMessage>* rows, ColumnarLogStore* columns)
+	{
+		std::mt19937 rng(42);
+		const int64_t hourNs = 3600LL * 1000 * 1000 * 1000;
+		const int64_t stepNs = hourNs / static_cast<int64_t>(count);
+
+		if (rows)
+			rows->reserve(count);
+		if (columns)
+			columns->Reserve(count, count * 12);
+
+		for (size_t i = 0; i < count; ++i)
+		{
+			const uint32_t r = rng() % 100;
+			const LogLevel level = r == 0 ? LogLevel::Error : (r < 5 ? LogLevel::Warning : (r < 50 ? LogLevel::Debug : LogLevel::Info));
+			const int64_t ts = endNs - hourNs + static_cast<int64_t>(i) * stepNs;
+			std::string text = "entry " + std::to_string(i);
+
+			if (columns)
+				columns->Append(level, ts, text, i);
+			if (rows)
+			{
+				rows->emplace_back(level, std::move(text));
+				rows->back().timestamp = FromEpochNanoseconds(ts);
+				rows->back().sequence = i;
+			}
+		}
+	}
+}
+
+// All SIMD kernels must return exactly the same indices as the scalar reference
+TEST(ColumnarLogStoreTest, ScanKernelsMatchScalar)
+{
+	ColumnarLogStore store;
+	const int64_t nowNs = ToEpochNanoseconds(std::chrono::system_clock::now());
+	FillStores(10007, nowNs, nullptr, &store); // odd size to exercise the tail loops
+
+	const int64_t minNs = nowNs - 1200LL * 1000 * 1000 * 1000;
+	const int64_t maxNs = nowNs - 60LL * 1000 * 1000 * 1000;
+	const uint32_t masks[] = { LevelBit(LogLevel::Error), LevelBit(LogLevel::Error) | LevelBit(LogLevel::Warning), ALL_LOG_LEVELS };
+
+	for (uint32_t mask : masks)
+	{
+		std::vector<uint32_t> reference;
+		store.ScanLevelTime(mask, minNs, maxNs, reference, 0, SIZE_MAX, gear::SimdLevel::Scalar);
+		ASSERT_FALSE(reference.empty());
+
+		for (gear::SimdLevel simd : { gear::SimdLevel::Sse2, gear::SimdLevel::Sse42, gear::SimdLevel::Avx2 })
+		{
+			std::vector<uint32_t> result;
+			store.ScanLevelTime(mask, minNs, maxNs, result, 3, SIZE_MAX, simd);
+			std::vector<uint32_t> expected;
+			for (uint32_t i : reference)
+			{
+				if (i >= 3)
+					expected.push_back(i);
+			}
+			EXPECT_EQ(result, expected) << gear::SimdLevelName(simd);
+			EXPECT_EQ(store.CountLevelTime(mask, minNs, maxNs, simd), reference.size());
+		}
+	}
+}
+
+// Texts round-trip through the text heap, open time bounds (time_point::min/max) don't overflow
+TEST(ColumnarLogStoreTest, SnapshotFromRingBuffer)
+{
+	CircularLogBuffer ring(4);
+	for (int i = 0; i < 6; ++i)
+		ring.Push(LogMessage(i % 2 ? LogLevel::Error : LogLevel::Info, "message " + std::to_string(i)));
+
+	ColumnarLogStore store;
+	EXPECT_EQ(ring.CopySince(0, 100, store), 4u);
+	ASSERT_EQ(store.Size(), 4u);
+	EXPECT_EQ(store.Text(0), "message 2");
+	EXPECT_EQ(store.Sequence(3), 5u);
+
+	const int64_t minNs = ToEpochNanoseconds(std::chrono::system_clock::time_point::min());
+	const int64_t maxNs = ToEpochNanoseconds(std::chrono::system_clock::time_point::max());
+	EXPECT_EQ(store.CountLevelTime(LevelBit(LogLevel::Error), minNs, maxNs), 2u);
+	EXPECT_EQ(store.ToLogMessage(1).message, "message 3");
+}
+
+// Truncation length and attachment offset survive the snapshot so the full text stays reachable
+TEST(ColumnarLogStoreTest, TruncatedMessageRoundTrip)
+{
+	LogMessage truncated(LogLevel::Warning, "head of a long message");
+	truncated.fullLength = 100000;
+	truncated.attachmentOffset = 4096;
+
+	ColumnarLogStore store;
+	store.Append(LogMessage(LogLevel::Info, "short"));
+	store.Append(truncated);
+	ASSERT_EQ(store.Size(), 2u);
+
+	EXPECT_EQ(store.FullLength(0), 0u);
+	EXPECT_EQ(store.AttachmentOffset(0), -1);
+
+	const LogMessage restored = store.ToLogMessage(1);
+	EXPECT_EQ(restored.message, truncated.message);
+	EXPECT_EQ(restored.fullLength, 100000u);
+	EXPECT_EQ(restored.attachmentOffset, 4096);
+}
+
+// "Errors in the last 10 minutes" finds the same entries in a LogMessage array and the columnar store
+// (timings: BM_ScanRows / BM_ScanColumnar in GearBench)
+TEST(ColumnarLogStoreTest, MatchesRowLayout)
+{
+	const int64_t nowNs = ToEpochNanoseconds(std::chrono::system_clock::now());
+	const int64_t minNs = nowNs - 600LL * 1000 * 1000 * 1000;
+	const auto minTp = FromEpochNanoseconds(minNs);
+
+	std::vector<LogMessage> rows;
+	ColumnarLogStore columns;
+	FillStores(100000, nowNs, &rows, &columns);
+
+	size_t rowMatches = 0;
+	for (const LogMessage& msg : rows)
+	{
+		if (msg.level == LogLevel::Error && msg.timestamp >= minTp)
+			++rowMatches;
+	}
+
+	std::vector<uint32_t> indices;
+	EXPECT_EQ(columns.ScanLevelTime(LevelBit(LogLevel::Error), minNs, INT64_MAX, indices), rowMatches);
+	EXPECT_GT(rowMatches, 0u);
+}
@@ -0,0 +1,72 @@
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <numeric>
+#include <random>
+#include <vector>
+
+#include "Utils/FenwickTree.h"
+
+using gear::FenwickTree;
+
+TEST(FenwickTreeTest, PrefixSumsFollowUpdates)
+{
+	FenwickTree<int64_t> tree(10, 17);
+	EXPECT_EQ(tree.Size(), 10u);
+	EXPECT_EQ(tree.Total(), 170);
+	EXPECT_EQ(tree.PrefixSum(0), 0);
+	EXPECT_EQ(tree.PrefixSum(3), 51);
+
+	tree.Set(2, 51); // A row wrapped to three lines
+	EXPECT_EQ(tree.Get(2), 51);
+	EXPECT_EQ(tree.PrefixSum(2), 34);
+	EXPECT_EQ(tree.PrefixSum(3), 85);
+	EXPECT_EQ(tree.Total(), 204);
+}
+
+// UpperBound() maps a position to the element covering it
+TEST(FenwickTreeTest, UpperBoundFindsCoveringElement)
+{
+	FenwickTree<int64_t> tree(5, 10);
+	tree.Set(1, 30);
+	// Elements cover [0,10) [10,40) [40,50) [50,60) [60,70)
+	EXPECT_EQ(tree.UpperBound(0), 0u);
+	EXPECT_EQ(tree.UpperBound(9), 0u);
+	EXPECT_EQ(tree.UpperBound(10), 1u);
+	EXPECT_EQ(tree.UpperBound(39), 1u);
+	EXPECT_EQ(tree.UpperBound(40), 2u);
+	EXPECT_EQ(tree.UpperBound(69), 4u);
+	EXPECT_EQ(tree.UpperBound(70), 5u);
+	EXPECT_EQ(tree.UpperBound(1000), 5u);
+
+	FenwickTree<int64_t> empty;
+	EXPECT_EQ(empty.UpperBound(5), 0u);
+}
+
+TEST(FenwickTreeTest, MatchesNaiveSums)
+{
+	constexpr size_t SIZE = 1000;
+	std::mt19937 random(42);
+	std::uniform_int_distribution<int> heights(0, 100);
+
+	FenwickTree<int64_t> tree(SIZE, 17);
+	std::vector<int64_t> values(SIZE, 17);
+	for (int i = 0; i < 5000; ++i)
+	{
+		const size_t index = random() % SIZE;
+		values[index] = heights(random);
+		tree.Set(index, values[index]);
+	}
+
+	int64_t sum = 0;
+	for (size_t i = 0; i < SIZE; ++i)
+	{
+		ASSERT_EQ(tree.PrefixSum(i), sum);
+		if (values[i] > 0)
+		{
+			ASSERT_EQ(tree.UpperBound(sum), i);
+			ASSERT_EQ(tree.UpperBound(sum + values[i] - 1), i);
+		}
+		sum += values[i];
+	}
+	EXPECT_EQ(tree.Total(), std::accumulate(values.begin(), values.end(), int64_t(0)));
+}
@@ -0,0 +1,111 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstring>
+#include <thread>
+
+#include "Profiler/FrameProfiler.h"
+#include "Trace/TraceRecorder.h"
+
+using namespace gear;
+
+namespace
+{
+	const ProfileZone* FindZone(const ProfileFrame& frame, const char* name)
+	{
+		for (const ProfileZone& zone : frame.zones)
+			if (std::strcmp(zone.name, name) == 0)
+				return &zone;
+		return nullptr;
+	}
+}
+
+TEST(FrameProfilerTest, RecordsNestedZonesPerFrame)
+{
+	FrameProfiler::SetEnabled(true);
+	{
+		GEAR_TRACE_SCOPE("Frame");
+		{
+			GEAR_TRACE_SCOPE("Update");
+			std::this_thread::sleep_for(std::chrono::milliseconds(2));
+		}
+		GEAR_TRACE_BEGIN("Render");
+		GEAR_TRACE_END("Render");
+	}
+	FrameProfiler::EndFrame();
+	FrameProfiler::SetEnabled(false);
+
+	ASSERT_GE(FrameProfiler::GetFrameCount(), 1u);
+	const ProfileFrame& frame = FrameProfiler::GetFrame(FrameProfiler::GetFrameCount() - 1);
+	ASSERT_EQ(frame.zones.size(), 3u);
+
+	const ProfileZone* outer = FindZone(frame, "Frame");
+	const ProfileZone* update = FindZone(frame, "Update");
+	const ProfileZone* render = FindZone(frame, "Render");
+	ASSERT_TRUE(outer && update && render);
+	EXPECT_EQ(outer->depth, 0);
+	EXPECT_EQ(update->depth, 1);
+	EXPECT_EQ(render->depth, 1);
+	EXPECT_GE(update->endNs - update->startNs, 2'000'000);
+	EXPECT_LE(outer->startNs, update->startNs);
+	EXPECT_GE(outer->endNs, render->endNs);
+	EXPECT_GE(frame.durationNs, outer->endNs); // Zones are relative to the frame start
+	EXPECT_EQ(frame.zones.back().name, outer->name); // Parents end last
+}
+
+TEST(FrameProfilerTest, CollectsOtherThreadsAndIgnoresDisabledTime)
+{
+	// Zones begun while disabled are not on the stack and must not unbalance it
+	GEAR_TRACE_BEGIN("Before");
+	FrameProfiler::SetEnabled(true);
+	GEAR_TRACE_END("Before");
+
+	std::thread([]()
+		{
+			FrameProfiler::SetThreadName("Worker");
+			GEAR_TRACE_SCOPE("Job");
+		}).join();
+	{
+		GEAR_TRACE_SCOPE("Main");
+	}
+	FrameProfiler::EndFrame();
+
+	const ProfileFrame& frame = FrameProfiler::GetFrame(FrameProfiler::GetFrameCount() - 1);
+	EXPECT_EQ(FindZone(frame, "Before"), nullptr);
+	const ProfileZone* job = FindZone(frame, "Job");
+	const ProfileZone* main = FindZone(frame, "Main");
+	ASSERT_TRUE(job && main);
+	EXPECT_EQ(FrameProfiler::GetThreadName(job->thread), "Worker");
+	EXPECT_NE(job->thread, main->thread);
+	EXPECT_EQ(main->depth, 0);
+
+	// Nothing is recorded or collected while disabled
+	FrameProfiler::SetEnabled(false);
+	const size_t frames = FrameProfiler::GetFrameCount();
+	{
+		GEAR_TRACE_SCOPE("Disabled");
+	}
+	FrameProfiler::EndFrame();
+	EXPECT_EQ(FrameProfiler::GetFrameCount(), frames);
+}
+
+TEST(FrameProfilerTest, RingKeepsLastFrames)
+{
+	FrameProfiler::SetEnabled(true);
+	for (size_t i = 0; i < FrameProfiler::MAX_FRAMES + 5; ++i)
+	{
+		GEAR_TRACE_SCOPE("Tick");
+		FrameProfiler::EndFrame(); // Zone still open: belongs to the next frame
+	}
+	FrameProfiler::EndFrame();
+	FrameProfiler::SetEnabled(false);
+
+	ASSERT_EQ(FrameProfiler::GetFrameCount(), FrameProfiler::MAX_FRAMES);
+	const uint64_t first = FrameProfiler::GetFrame(0).index;
+	for (size_t i = 1; i < FrameProfiler::MAX_FRAMES; ++i)
+	{
+		const ProfileFrame& frame = FrameProfiler::GetFrame(i);
+		EXPECT_EQ(frame.index, first + i);
+		ASSERT_EQ(frame.zones.size(), 1u);
+		EXPECT_LT(frame.zones[0].startNs, 0); // Started in the previous frame
+	}
+}
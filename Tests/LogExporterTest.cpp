@@ -0,0 +1,182 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "Logger/LogExporter.h"
+#include "Logger/LogToFile.h"
+#include "Ipc/LogDatagram.h"
+
+namespace
+{
+	// Waits until the exporter has finished its job (or gives up after 10 s)
+	LogExporter::Result WaitForResult(const LogExporter& exporter)
+	{
+		const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+		while (exporter.IsBusy() && std::chrono::steady_clock::now() < deadline)
+			std::this_thread::sleep_for(std::chrono::milliseconds(5));
+		return exporter.GetResult();
+	}
+
+	std::string ReadFile(const std::filesystem::path& path)
+	{
+		std::ifstream in(path, std::ios::binary);
+		std::stringstream content;
+		content << in.rdbuf();
+		return content.str();
+	}
+
+	void Fill(CircularLogBuffer& buffer, int count)
+	{
+		for (int i = 0; i < count; ++i)
+			buffer.Push(LogMessage(i % 10 == 0 ? LogLevel::Error : LogLevel::Info, "Export entry " + std::to_string(i)));
+	}
+}
+
+// Text export writes the Gear.log line format, JSON lines one object per row; a query filters the rows
+TEST(LogExporterTest, ExportsRingAsTextAndJsonLines)
+{
+	const std::filesystem::path folder = "test_logs_export";
+	std::filesystem::remove_all(folder);
+
+	CircularLogBuffer buffer(1000);
+	Fill(buffer, 100);
+	LogExporter exporter(buffer);
+
+	LogExporter::Job job;
+	job.path = folder / "all.log";
+	job.ringBegin = 0;
+	job.ringEnd = 100;
+	exporter.Start(job);
+	LogExporter::Result result = WaitForResult(exporter);
+	EXPECT_TRUE(result.error.empty()) << result.error;
+	EXPECT_EQ(result.rowsWritten, 100u);
+	EXPECT_EQ(result.rowsSkipped, 0u);
+
+	std::istringstream lines(ReadFile(job.path));
+	std::string line;
+	int count = 0;
+	LogMessage parsed;
+	while (std::getline(lines, line))
+	{
+		ASSERT_TRUE(LogMessage::FromFileLine(line, parsed)) << line;
+		EXPECT_EQ(parsed.message, "Export entry " + std::to_string(count));
+		++count;
+	}
+	EXPECT_EQ(count, 100);
+
+	job.path = folder / "errors.jsonl";
+	job.format = LogExporter::Format::JsonLines;
+	job.query = "level:error";
+	exporter.Start(job);
+	result = WaitForResult(exporter);
+	EXPECT_TRUE(result.error.empty()) << result.error;
+	EXPECT_EQ(result.rowsWritten, 10u);
+
+	const std::string json = ReadFile(job.path);
+	EXPECT_EQ(std::count(json.begin(), json.end(), '\n'), 10);
+	EXPECT_NE(json.find("\"level\":\"ERROR\",\"seq\":10,\"source\":\"GEAR\",\"message\":\"Export entry 10\"}"), std::string::npos);
+
+	job.query = "re:/[/";
+	exporter.Start(job);
+	EXPECT_FALSE(WaitForResult(exporter).error.empty());
+
+	std::filesystem::remove_all(folder);
+}
+
+// Binary export is a sequence of LogDatagram packets; overwritten ring entries are counted as skipped
+TEST(LogExporterTest, ExportsBinaryDatagrams)
+{
+	const std::filesystem::path folder = "test_logs_export_binary";
+	std::filesystem::remove_all(folder);
+
+	CircularLogBuffer buffer(5000);
+	Fill(buffer, 6000); // Sequences 0..999 are gone
+	LogExporter exporter(buffer);
+
+	LogExporter::Job job;
+	job.path = folder / "ring.gldg";
+	job.format = LogExporter::Format::Binary;
+	job.ringBegin = 0;
+	job.ringEnd = 6000;
+	exporter.Start(job);
+	const LogExporter::Result result = WaitForResult(exporter);
+	EXPECT_TRUE(result.error.empty()) << result.error;
+	EXPECT_EQ(result.rowsWritten, 5000u);
+	EXPECT_EQ(result.rowsSkipped, 1000u);
+
+	const std::string data = ReadFile(job.path);
+	size_t offset = 0;
+	size_t records = 0;
+	std::string first;
+	while (offset + gear::LOG_DATAGRAM_HEADER_SIZE <= data.size())
+	{
+		ASSERT_EQ(gear::LoadLE<uint32_t>(data.data() + offset), gear::LOG_DATAGRAM_MAGIC);
+		const uint16_t count = gear::LoadLE<uint16_t>(data.data() + offset + 6);
+		ASSERT_LE(count, 5000u);
+		offset += gear::LOG_DATAGRAM_HEADER_SIZE;
+		for (uint16_t i = 0; i < count; ++i)
+		{
+			const uint16_t length = gear::LoadLE<uint16_t>(data.data() + offset + 10);
+			if (records == 0)
+				first.assign(data.data() + offset + gear::LOG_DATAGRAM_RECORD_HEADER_SIZE, length);
+			offset += gear::LOG_DATAGRAM_RECORD_HEADER_SIZE + length;
+			++records;
+		}
+	}
+	EXPECT_EQ(offset, data.size());
+	EXPECT_EQ(records, 5000u);
+	EXPECT_EQ(first, "Export entry 1000");
+
+	std::filesystem::remove_all(folder);
+}
+
+// History rows (mapped log files) come before the ring rows
+TEST(LogExporterTest, ExportsHistoryRows)
+{
+	const std::string folder = "test_logs_export_history";
+	std::filesystem::remove_all(folder);
+	{
+		LogToFile writer(folder, "test.log");
+		for (int i = 0; i < 50; ++i)
+			writer.Write(LogMessage(LogLevel::Info, "History line " + std::to_string(i)));
+	}
+
+	LogHistory history(folder, "test.log", 1);
+	history.Refresh();
+	auto snapshot = history.GetSnapshot();
+	const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+	while (snapshot->GetLineCount() < 50 && std::chrono::steady_clock::now() < deadline)
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(5));
+		snapshot = history.GetSnapshot();
+	}
+	ASSERT_EQ(snapshot->GetLineCount(), 50u);
+
+	CircularLogBuffer buffer(100);
+	Fill(buffer, 5);
+	LogExporter exporter(buffer);
+
+	LogExporter::Job job;
+	job.path = std::filesystem::path(folder) / "export.log";
+	job.history = snapshot;
+	job.historyBegin = 40;
+	job.historyEnd = 50;
+	job.ringBegin = 0;
+	job.ringEnd = 5;
+	exporter.Start(job);
+	const LogExporter::Result result = WaitForResult(exporter);
+	EXPECT_TRUE(result.error.empty()) << result.error;
+	EXPECT_EQ(result.rowsWritten, 15u);
+
+	const std::string text = ReadFile(job.path);
+	EXPECT_LT(text.find("History line 40"), text.find("History line 49"));
+	EXPECT_LT(text.find("History line 49"), text.find("Export entry 0"));
+	EXPECT_EQ(text.find("History line 39"), std::string::npos);
+
+	std::filesystem::remove_all(folder);
+}
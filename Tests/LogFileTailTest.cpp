@@ -0,0 +1,151 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Logger/LogFileTail.h"
+#include "Logger/LogSources.h"
+#include "Logger/CircularLogBuffer.h"
+#include "CollectingSink.h"
+
+namespace
+{
+	void AppendLines(const std::filesystem::path& path, const std::vector<std::string>& lines)
+	{
+		std::ofstream out(path, std::ios::app | std::ios::binary);
+		for (const std::string& line : lines)
+			out << line << '\n';
+	}
+}
+
+TEST(LogFileTailTest, DetectsLevels)
+{
+	EXPECT_EQ(LogFileTail::DetectLevel("2025-10-19 14:30:00 ERROR [db] connection lost"), LogLevel::Error);
+	EXPECT_EQ(LogFileTail::DetectLevel("Oct 19 14:30:00 host daemon[42]: <warning> disk 91% full"), LogLevel::Warning);
+	EXPECT_EQ(LogFileTail::DetectLevel("D/trace: debug output"), LogLevel::Debug);
+	EXPECT_EQ(LogFileTail::DetectLevel("level=info msg=\"errors: none\""), LogLevel::Info);
+	EXPECT_EQ(LogFileTail::DetectLevel("terror and warnings later in a long line without any level keyword up front ... ERROR"), LogLevel::Info);
+
+	// GEAR's own file format keeps level and timestamp
+	LogMessage gearLine(LogLevel::Debug, "Motor Run(): started");
+	LogMessage parsed;
+	LogFileTail::ParseLine(gearLine.ToStringForFile(), 7, std::chrono::system_clock::now(), parsed);
+	EXPECT_EQ(parsed.level, LogLevel::Debug);
+	EXPECT_EQ(parsed.message, "Motor Run(): started");
+	EXPECT_EQ(parsed.sourceId, 7);
+}
+
+TEST(LogFileTailTest, FollowsAppendsAndRotation)
+{
+	const std::filesystem::path folder = "test_logs_tail";
+	std::filesystem::remove_all(folder);
+	std::filesystem::create_directories(folder);
+	const auto path = folder / "daemon.log";
+	AppendLines(path, { "old line before tailing" });
+
+	const uint16_t sourceId = LogSources::Register("daemon.log", LogSources::DefaultColor(0));
+	EXPECT_EQ(LogSources::Register("daemon.log", LogSources::DefaultColor(1)), sourceId);
+	EXPECT_EQ(LogSources::GetName(sourceId), "daemon.log");
+
+	CollectingSink<LogFileTail::Sink> sink;
+	{
+		LogFileTail tail(path, sourceId, sink.Get());
+		std::this_thread::sleep_for(std::chrono::milliseconds(50)); // Let it seek to the end
+
+		AppendLines(path, { "INFO first", "WARN second\r" });
+		ASSERT_TRUE(sink.WaitFor(2));
+
+		// Incomplete lines are held back until their newline arrives
+		{
+			std::ofstream out(path, std::ios::app | std::ios::binary);
+			out << "ERROR split ";
+		}
+		std::this_thread::sleep_for(std::chrono::milliseconds(150));
+		EXPECT_EQ(sink.Count(), 2u);
+		AppendLines(path, { "line" });
+		ASSERT_TRUE(sink.WaitFor(3));
+
+		// Rotation: rename and recreate, the new file is read from its start
+		std::filesystem::rename(path, folder / "daemon.log.1");
+		AppendLines(path, { "DEBUG after rotation" });
+		ASSERT_TRUE(sink.WaitFor(4));
+		EXPECT_EQ(tail.GetLineCount(), 4u);
+	}
+
+	ASSERT_EQ(sink.messages.size(), 4u);
+	EXPECT_EQ(sink.messages[0].message, "INFO first");
+	EXPECT_EQ(sink.messages[1].message, "WARN second");
+	EXPECT_EQ(sink.messages[1].level, LogLevel::Warning);
+	EXPECT_EQ(sink.messages[2].message, "ERROR split line");
+	EXPECT_EQ(sink.messages[2].level, LogLevel::Error);
+	EXPECT_EQ(sink.messages[3].level, LogLevel::Debug);
+	EXPECT_EQ(sink.messages[3].sourceId, sourceId);
+
+	std::filesystem::remove_all(folder);
+}
+
+// Throughput: a file with 500k lines must be ingested into a ring buffer at well above 100k lines/s
+TEST(LogFileTailTest, IngestPerformance)
+{
+	const std::filesystem::path folder = "test_logs_tail_perf";
+	std::filesystem::remove_all(folder);
+	std::filesystem::create_directories(folder);
+	const auto path = folder / "bulk.log";
+
+	const size_t lineCount = 500000;
+	{
+		std::ofstream out(path, std::ios::binary);
+		for (size_t i = 0; i < lineCount; ++i)
+			out << "2025-10-19 14:30:00.123 " << (i % 50 == 0 ? "WARN" : "INFO") << " worker-3 processed request " << i << " in 12 ms\n";
+	}
+
+	CircularLogBuffer ring(100000);
+	std::atomic<size_t> received{ 0 };
+	const auto start = std::chrono::high_resolution_clock::now();
+	{
+		LogFileTail tail(path, 1, [&](std::vector<LogMessage>& batch)
+			{
+				ring.PushBatch(batch.data(), batch.size());
+				received += batch.size();
+			}, true);
+
+		const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+		while (received < lineCount && std::chrono::steady_clock::now() < deadline)
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+	const auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::high_resolution_clock::now() - start).count();
+
+	EXPECT_EQ(received, lineCount);
+	EXPECT_EQ(ring.GetTotalPushed(), lineCount);
+	EXPECT_LT(ms, 5000); // 100k lines/s
+	std::cout << "[ Tail     ] " << lineCount << " lines in " << ms << " ms\n";
+
+	std::filesystem::remove_all(folder);
+}
+
+// Sources beyond the registry share OTHER_SOURCE, they must not be shown as GEAR. Fills the global
+// registry, so it runs in a child process (death test) to leave the other tests' sources alone.
+TEST(LogSourcesTest, OverflowMapsToOtherSource)
+{
+	GTEST_FLAG_SET(death_test_style, "threadsafe"); // Re-executes the binary; a plain fork may inherit locks held by other tests' threads
+	EXPECT_EXIT(
+		{
+			for (size_t i = LogSources::GetCount(); i < LogSources::OTHER_SOURCE; ++i)
+				LogSources::Register("producer:" + std::to_string(i), LogSources::DefaultColor(i));
+
+			const uint16_t overflow = LogSources::Register("late:1", LogSources::DefaultColor(0));
+			const bool ok = overflow == LogSources::OTHER_SOURCE
+				&& LogSources::Register("late:2", LogSources::DefaultColor(1)) == LogSources::OTHER_SOURCE
+				&& LogSources::GetName(overflow) == LogSources::OTHER_SOURCE_NAME
+				&& LogSources::GetCount() == LogSources::MAX_SOURCES
+				// Registered sources keep their ids
+				&& LogSources::Register("producer:" + std::to_string(LogSources::OTHER_SOURCE - 1), LogSources::DefaultColor(0)) == LogSources::OTHER_SOURCE - 1;
+			std::exit(ok ? 0 : 1);
+		},
+		::testing::ExitedWithCode(0), "");
+}
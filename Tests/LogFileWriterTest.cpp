@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include "Logger/LogFileWriter.h"
+#include "Logger/LogToFile.h"
+
+namespace
+{
+	std::string ReadFile(const std::filesystem::path& path)
+	{
+		std::ifstream in(path, std::ios::binary);
+		std::stringstream content;
+		content << in.rdbuf();
+		return content.str();
+	}
+}
+
+TEST(LogFileWriterTest, BuffersUntilFlush)
+{
+	const std::filesystem::path folder = "test_logs_writer";
+	std::filesystem::remove_all(folder);
+	std::filesystem::create_directories(folder);
+	const auto path = folder / "out.log";
+
+	{
+		std::ofstream(path, std::ios::binary) << "existing\n";
+
+		LogFileWriter writer;
+		ASSERT_TRUE(writer.Open(path));
+		writer.AppendLine("first");
+		writer.AppendLine("second");
+		EXPECT_EQ(writer.GetBufferedBytes(), 13u);
+		EXPECT_EQ(ReadFile(path), "existing\n"); // Appends, nothing written yet
+
+		ASSERT_TRUE(writer.Flush());
+		EXPECT_EQ(writer.GetBufferedBytes(), 0u);
+		EXPECT_EQ(ReadFile(path), "existing\nfirst\nsecond\n");
+
+		writer.AppendLine("third");
+		EXPECT_TRUE(writer.Sync());
+	}
+	EXPECT_EQ(ReadFile(path), "existing\nfirst\nsecond\nthird\n");
+
+	std::filesystem::remove_all(folder);
+}
+
+// Lines larger than the buffer go out together with the buffered ones, in order
+TEST(LogFileWriterTest, LargeLinesKeepOrder)
+{
+	const std::filesystem::path folder = "test_logs_writer_large";
+	std::filesystem::remove_all(folder);
+	std::filesystem::create_directories(folder);
+	const auto path = folder / "out.log";
+
+	const std::string large(LogFileWriter::BUFFER_SIZE + 100, 'L');
+	const std::string almostFull(LogFileWriter::BUFFER_SIZE - 10, 'A');
+	std::string expected;
+	{
+		LogFileWriter writer;
+		ASSERT_TRUE(writer.Open(path));
+		for (int i = 0; i < 3; ++i)
+		{
+			writer.AppendLine("small " + std::to_string(i));
+			writer.AppendLine(large);
+			writer.AppendLine(almostFull);
+			expected += "small " + std::to_string(i) + "\n" + large + "\n" + almostFull + "\n";
+		}
+	}
+	EXPECT_EQ(ReadFile(path), expected);
+
+	std::filesystem::remove_all(folder);
+}
+
+TEST(LogFileWriterTest, ReportsOpenErrors)
+{
+	LogFileWriter writer;
+	std::string error;
+	EXPECT_FALSE(writer.Open("test_logs_missing_folder/sub/out.log", &error));
+	EXPECT_FALSE(writer.IsOpen());
+	EXPECT_FALSE(error.empty());
+	EXPECT_EQ(error, writer.GetError());
+}
+
+// LogToFile counts lines as written once they are in the file, and syncs after errors in OnError mode
+TEST(LogFileWriterTest, LogToFileSyncOnError)
+{
+	const std::filesystem::path folder = "test_logs_writer_sync";
+	std::filesystem::remove_all(folder);
+
+	{
+		LogToFile logger(folder.string(), "test.log", 1024, 1);
+		logger.SetSyncMode(LogSyncMode::OnError);
+		logger.Write(LogMessage(LogLevel::Info, "info line"));
+		logger.Write(LogMessage(LogLevel::Error, "error line"));
+
+		const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+		while (logger.GetStats().linesWritten < 2 && std::chrono::steady_clock::now() < deadline)
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+		const LogFileStats stats = logger.GetStats();
+		EXPECT_EQ(stats.linesWritten, 2u);
+		EXPECT_EQ(stats.syncs, 1u);
+		EXPECT_EQ(stats.writeErrors, 0u);
+
+		const std::string content = ReadFile(folder / "test.log");
+		EXPECT_NE(content.find("info line\n"), std::string::npos);
+		EXPECT_NE(content.find("error line\n"), std::string::npos);
+	}
+
+	std::filesystem::remove_all(folder);
+}
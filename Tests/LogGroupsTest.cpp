@@ -0,0 +1,110 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "Logger/Logger.h"
+#include "Logger/LogGroups.h"
+
+namespace
+{
+	const LogGroups::Group* FindGroup(const std::vector<LogGroups::Group>& groups, uint32_t siteId)
+	{
+		auto it = std::find_if(groups.begin(), groups.end(), [siteId](const LogGroups::Group& group) { return group.siteId == siteId; });
+		return it != groups.end() ? &*it : nullptr;
+	}
+}
+
+TEST(LogGroupsTest, AggregatesPerSite)
+{
+	LogGroups groups;
+	const uint32_t bulk = LogSymbols::Intern("GroupsTest(): Bulk log entry {}", LogSymbols::ROLE_SITE);
+	const uint32_t other = LogSymbols::Intern("GroupsTest(): t={} | A={}", LogSymbols::ROLE_SITE);
+	const auto start = std::chrono::system_clock::time_point(std::chrono::seconds(1700000000));
+
+	LogMessage message(LogLevel::Debug, "");
+	for (int i = 0; i < 10; ++i)
+	{
+		message.siteId = bulk;
+		message.sequence = i;
+		message.timestamp = start + std::chrono::milliseconds(i * 250); // 4 per second
+		groups.Record(message);
+	}
+	message.siteId = other;
+	message.timestamp = start;
+	groups.Record(message);
+
+	message.siteId = LogSymbols::NONE; // Other sources have no site
+	groups.Record(message);
+
+	std::vector<LogGroups::Group> snapshot;
+	groups.Snapshot(1700000002, snapshot);
+	ASSERT_EQ(snapshot.size(), 2u);
+
+	const LogGroups::Group* group = FindGroup(snapshot, bulk);
+	ASSERT_NE(group, nullptr);
+	EXPECT_EQ(group->count, 10u);
+	EXPECT_EQ(group->level, LogLevel::Debug);
+	EXPECT_EQ(group->firstNs, ToEpochNanoseconds(start));
+	EXPECT_EQ(group->lastNs, ToEpochNanoseconds(start + std::chrono::milliseconds(2250)));
+	EXPECT_EQ(group->lastSequence, 9u);
+
+	// Rates end at the snapshot second
+	constexpr size_t LAST = LogGroups::SPARK_SECONDS - 1;
+	EXPECT_EQ(group->perSecond[LAST - 2], 4u);
+	EXPECT_EQ(group->perSecond[LAST - 1], 4u);
+	EXPECT_EQ(group->perSecond[LAST], 2u);
+	EXPECT_EQ(group->perSecond[LAST - 3], 0u);
+
+	EXPECT_EQ(FindGroup(snapshot, other)->count, 1u);
+}
+
+TEST(LogGroupsTest, ConcurrentRecords)
+{
+	LogGroups groups;
+	const uint32_t site = LogSymbols::Intern("GroupsTest(): concurrent {}", LogSymbols::ROLE_SITE);
+	constexpr int THREADS = 4;
+	constexpr int PER_THREAD = 10000;
+
+	std::vector<std::thread> threads;
+	for (int t = 0; t < THREADS; ++t)
+	{
+		threads.emplace_back([&groups, site]()
+			{
+				LogMessage message(LogLevel::Info, "");
+				message.siteId = site;
+				for (int i = 0; i < PER_THREAD; ++i)
+					groups.Record(message);
+			});
+	}
+	for (auto& thread : threads)
+		thread.join();
+
+	std::vector<LogGroups::Group> snapshot;
+	groups.Snapshot(0, snapshot);
+	ASSERT_EQ(snapshot.size(), 1u);
+	EXPECT_EQ(snapshot[0].count, static_cast<uint64_t>(THREADS * PER_THREAD));
+}
+
+// LOG_* calls are grouped by function and format string, whatever the arguments
+TEST(LogGroupsTest, LoggerGroupsByFormatString)
+{
+	for (int i = 0; i < 5; ++i)
+		LOG_DEBUG("Grouped entry {}", i);
+	LOG_DEBUG("Grouped entry {} of {}", 1, 2);
+
+	const uint32_t site = LogSymbols::Find("TestBody(): Grouped entry {}");
+	ASSERT_NE(site, LogSymbols::NONE);
+	EXPECT_TRUE(LogSymbols::GetRoles(site) & LogSymbols::ROLE_SITE);
+
+	const auto& buffer = Logger::GetBuffer();
+	EXPECT_EQ(buffer[(Logger::GetReadIndex() + Logger::GetSize() - 2) % buffer.size()].siteId, site);
+
+	std::vector<LogGroups::Group> snapshot;
+	Logger::GetGroups().Snapshot(LogRateSeries::ToEpochSecond(std::chrono::system_clock::now()), snapshot);
+	const LogGroups::Group* group = FindGroup(snapshot, site);
+	ASSERT_NE(group, nullptr);
+	EXPECT_EQ(group->count, 5u);
+	EXPECT_NE(FindGroup(snapshot, LogSymbols::Find("TestBody(): Grouped entry {} of {}")), nullptr);
+}
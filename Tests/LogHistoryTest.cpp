@@ -0,0 +1,184 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <thread>
+
+#include "Logger/LogHistory.h"
+#include "Logger/LogFileIndex.h"
+#include "Logger/LogToFile.h"
+
+namespace
+{
+	// Waits until the background index has published at least 'lines' lines (or gives up after 5 s)
+	std::shared_ptr<const LogHistory::Snapshot> WaitForLines(LogHistory& history, size_t lines)
+	{
+		const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+		auto snapshot = history.GetSnapshot();
+		while (snapshot->GetLineCount() < lines && std::chrono::steady_clock::now() < deadline)
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(5));
+			snapshot = history.GetSnapshot();
+		}
+		return snapshot;
+	}
+}
+
+// Lines written by LogToFile parse back into level, timestamp (ms precision) and text
+TEST(LogHistoryTest, ParsesFileLines)
+{
+	LogMessage original(LogLevel::Warning, "Motor \"Left\" Run(): [not a level] 42");
+	original.timestamp = std::chrono::floor<std::chrono::milliseconds>(original.timestamp);
+
+	LogMessage parsed;
+	ASSERT_TRUE(LogMessage::FromFileLine(original.ToStringForFile(), parsed));
+	EXPECT_EQ(parsed.level, LogLevel::Warning);
+	EXPECT_EQ(parsed.timestamp, original.timestamp);
+	EXPECT_EQ(parsed.message, original.message);
+
+	EXPECT_TRUE(LogMessage::FromFileLine(LogMessage(LogLevel::Error, "").ToStringForFile() + "\r", parsed));
+	EXPECT_EQ(parsed.level, LogLevel::Error);
+	EXPECT_EQ(parsed.message, "");
+
+	EXPECT_FALSE(LogMessage::FromFileLine("second line of a multi-line message", parsed));
+	EXPECT_FALSE(LogMessage::FromFileLine("[INFO] [2025:10:19 14:3x:00.000] broken time", parsed));
+	EXPECT_FALSE(LogMessage::FromFileLine("[TRACE] [2025:10:19 14:30:00.000] unknown level", parsed));
+}
+
+// Rotated files are indexed oldest first, rows can be looked up and searched by time
+TEST(LogHistoryTest, IndexesRotatedFilesInOrder)
+{
+	const std::string folder = "test_logs_history";
+	std::filesystem::remove_all(folder);
+
+	const auto start = std::chrono::floor<std::chrono::milliseconds>(std::chrono::system_clock::now()) - std::chrono::hours(1);
+	const int lineCount = 3000;
+	{
+		LogToFile writer(folder, "test.log", 16, 20); // 16 KB per file -> several backups
+		for (int i = 0; i < lineCount; ++i)
+		{
+			LogMessage message(i % 10 == 0 ? LogLevel::Error : LogLevel::Info, "History line " + std::to_string(i));
+			message.timestamp = start + std::chrono::milliseconds(i * 10);
+			writer.Write(message);
+		}
+	}
+	ASSERT_TRUE(std::filesystem::exists(std::filesystem::path(folder) / "test.log.2"));
+
+	{
+		LogHistory history(folder, "test.log", 20);
+		history.Refresh();
+		auto snapshot = WaitForLines(history, lineCount);
+
+		ASSERT_EQ(snapshot->GetLineCount(), static_cast<size_t>(lineCount));
+		EXPECT_GT(snapshot->GetSegmentCount(), 2u);
+		EXPECT_TRUE(history.GetError().empty());
+
+		LogMessage row;
+		for (int i : { 0, 1, 1234, lineCount - 1 })
+		{
+			ASSERT_TRUE(snapshot->GetRow(static_cast<size_t>(i), row));
+			EXPECT_EQ(row.message, "History line " + std::to_string(i));
+			EXPECT_EQ(row.level, i % 10 == 0 ? LogLevel::Error : LogLevel::Info);
+			EXPECT_EQ(row.timestamp, start + std::chrono::milliseconds(i * 10));
+		}
+
+		EXPECT_EQ(snapshot->LowerBound(start), 0u);
+		EXPECT_EQ(snapshot->LowerBound(start + std::chrono::milliseconds(15000)), 1500u);
+		EXPECT_EQ(snapshot->LowerBound(start + std::chrono::milliseconds(15001)), 1501u);
+		EXPECT_EQ(snapshot->LowerBound(start + std::chrono::hours(2)), static_cast<size_t>(lineCount));
+
+		// Appended lines are picked up by the next refresh, without re-reading the unchanged files
+		{
+			LogToFile writer(folder, "test.log", 1024, 20);
+			writer.Write(LogMessage(LogLevel::Debug, "Appended line"));
+		}
+		history.Refresh();
+		snapshot = WaitForLines(history, lineCount + 1);
+		ASSERT_EQ(snapshot->GetLineCount(), static_cast<size_t>(lineCount + 1));
+		EXPECT_EQ(snapshot->GetLine(lineCount).substr(0, 7), "[DEBUG]");
+	}
+
+	std::filesystem::remove_all(folder);
+}
+
+// LogToFile writes a sidecar index per segment; it is rotated with the log file and continued after a restart
+TEST(LogHistoryTest, SidecarIndexCheckpointsAndCounts)
+{
+	const std::string folder = "test_logs_index";
+	std::filesystem::remove_all(folder);
+	const auto start = std::chrono::floor<std::chrono::milliseconds>(std::chrono::system_clock::now()) - std::chrono::hours(1);
+
+	auto writeLines = [&](int first, int count)
+		{
+			LogToFile writer(folder, "test.log", 64, 3, 1); // 64 KB files, checkpoint every KB
+			for (int i = first; i < first + count; ++i)
+			{
+				LogMessage message(i % 4 == 0 ? LogLevel::Warning : LogLevel::Info, "Indexed line " + std::to_string(i));
+				message.timestamp = start + std::chrono::milliseconds(i);
+				writer.Write(message);
+			}
+		};
+	writeLines(0, 1000);
+
+	const auto logPath = std::filesystem::path(folder) / "test.log";
+	LogFileIndex index;
+	ASSERT_TRUE(index.Load(logPath));
+	ASSERT_TRUE(index.IsComplete());
+	EXPECT_GT(index.GetRecords().size(), 20u);
+	EXPECT_EQ(index.GetRecords().back().offset, std::filesystem::file_size(logPath));
+	EXPECT_EQ(index.GetLevelCounts()[static_cast<size_t>(LogLevel::Warning)], 250u);
+	EXPECT_EQ(index.GetLevelCounts()[static_cast<size_t>(LogLevel::Info)], 750u);
+
+	// Every checkpoint points to the start of the line with its timestamp
+	std::ifstream file(logPath, std::ios::binary);
+	for (const LogIndexRecord& record : index.GetRecords())
+	{
+		if (record.flags & LogIndexRecord::FLAG_END)
+			continue;
+		file.seekg(static_cast<std::streamoff>(record.offset));
+		std::string line;
+		std::getline(file, line);
+		LogMessage parsed;
+		ASSERT_TRUE(LogMessage::FromFileLine(line, parsed)) << line;
+		EXPECT_EQ(ToEpochNanoseconds(parsed.timestamp), record.timestampNs);
+	}
+	file.close();
+
+	uint64_t begin, end;
+	index.FindRange(ToEpochNanoseconds(start + std::chrono::milliseconds(500)), begin, end);
+	EXPECT_LT(begin, end);
+	EXPECT_LE(end - begin, 2048u);
+
+	// Appending after a restart continues the index, rotation moves it along with the log file
+	writeLines(1000, 2000);
+	ASSERT_TRUE(std::filesystem::exists(LogFileIndex::PathFor(logPath.string() + ".1")));
+
+	uint64_t warnings = 0;
+	for (const char* name : { "test.log", "test.log.1", "test.log.2", "test.log.3" })
+	{
+		LogFileIndex segmentIndex;
+		if (segmentIndex.Load(std::filesystem::path(folder) / name))
+		{
+			EXPECT_TRUE(segmentIndex.IsComplete()) << name;
+			warnings += segmentIndex.GetLevelCounts()[static_cast<size_t>(LogLevel::Warning)];
+		}
+	}
+	EXPECT_EQ(warnings, 750u);
+
+	{
+		LogHistory history(folder, "test.log", 3);
+		history.Refresh();
+		auto snapshot = WaitForLines(history, 3000);
+		ASSERT_EQ(snapshot->GetLineCount(), 3000u);
+		EXPECT_EQ(snapshot->GetLevelCounts()[static_cast<size_t>(LogLevel::Warning)], 750u);
+		for (int i : { 0, 1, 999, 1000, 1777, 2999 })
+		{
+			const size_t row = snapshot->LowerBound(start + std::chrono::milliseconds(i));
+			EXPECT_EQ(row, static_cast<size_t>(i));
+			EXPECT_EQ(snapshot->LowerBound(start + std::chrono::microseconds(i * 1000 + 500)), static_cast<size_t>(i + 1));
+		}
+	}
+
+	std::filesystem::remove_all(folder);
+}
@@ -0,0 +1,159 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <chrono>
+#include <vector>
+
+#include "Logger/LogQuery.h"
+#include "Logger/LogSearchWorker.h"
+#include "Logger/CircularLogBuffer.h"
+#include "Logger/LogThreads.h"
+
+// Query: plain terms are case-insensitive, comma means OR, '-' excludes
+TEST(LogQueryTest, TextTerms)
+{
+	LogQuery query = LogQuery::Parse("motor,servo -heartbeat");
+	ASSERT_TRUE(query.error.empty());
+
+	EXPECT_TRUE(query.Matches(LogMessage(LogLevel::Info, "MOTOR started")));
+	EXPECT_TRUE(query.Matches(LogMessage(LogLevel::Info, "Servo reached position")));
+	EXPECT_FALSE(query.Matches(LogMessage(LogLevel::Info, "Motor heartbeat")));
+	EXPECT_FALSE(query.Matches(LogMessage(LogLevel::Info, "Camera ready")));
+}
+
+// Query: level mask, object and name prefixes of LOG1..LOG3 messages
+TEST(LogQueryTest, LevelAndPrefixFields)
+{
+	LogQuery query = LogQuery::Parse("level:error,warn obj:Mot name:Le");
+	ASSERT_TRUE(query.error.empty());
+
+	EXPECT_TRUE(query.Matches(LogMessage(LogLevel::Error, "Motor \"Left\" Update(): Temp too high")));
+	EXPECT_TRUE(query.Matches(LogMessage(LogLevel::Warning, "Main >> Motor \"Left\" Update(): Overload")));
+	EXPECT_FALSE(query.Matches(LogMessage(LogLevel::Info, "Motor \"Left\" Update(): Temp too high")));
+	EXPECT_FALSE(query.Matches(LogMessage(LogLevel::Error, "Motor \"Right\" Update(): Temp too high")));
+	EXPECT_FALSE(query.Matches(LogMessage(LogLevel::Error, "Update(): Motor \"Left\" without prefix")));
+}
+
+// Query: time ranges relative to a fixed 'now'
+TEST(LogQueryTest, TimeRange)
+{
+	const auto now = std::chrono::system_clock::now();
+	LogQuery query = LogQuery::Parse("last:10m", now);
+	ASSERT_TRUE(query.error.empty());
+
+	LogMessage recent(LogLevel::Info, "recent");
+	recent.timestamp = now - std::chrono::minutes(5);
+	LogMessage old(LogLevel::Info, "old");
+	old.timestamp = now - std::chrono::minutes(15);
+
+	EXPECT_TRUE(query.Matches(recent));
+	EXPECT_FALSE(query.Matches(old));
+
+	LogQuery invalid = LogQuery::Parse("after:yesterday");
+	EXPECT_FALSE(invalid.error.empty());
+}
+
+// Query: regex terms, invalid expressions are reported instead of thrown
+TEST(LogQueryTest, Regex)
+{
+	LogQuery query = LogQuery::Parse("re:/temp\\s+\\d+/");
+	ASSERT_TRUE(query.error.empty());
+	EXPECT_TRUE(query.Matches(LogMessage(LogLevel::Info, "Motor Temp 85 C")));
+	EXPECT_FALSE(query.Matches(LogMessage(LogLevel::Info, "Motor Temp high")));
+
+	LogQuery invalid = LogQuery::Parse("re:(unclosed");
+	EXPECT_FALSE(invalid.error.empty());
+}
+
+// Query: thread=N matches the LogThreads index, thread=Name the thread's name
+TEST(LogQueryTest, Thread)
+{
+	LogMessage main(LogLevel::Info, "Frame done");
+	main.threadIndex = LogThreads::Current();
+
+	LogMessage worker(LogLevel::Info, "Frame done");
+	std::thread thread([&worker]()
+		{
+			LogThreads::SetName("Query test worker");
+			worker.threadIndex = LogThreads::Current();
+		});
+	thread.join();
+
+	LogQuery byIndex = LogQuery::Parse("thread=" + std::to_string(main.threadIndex));
+	ASSERT_TRUE(byIndex.error.empty());
+	EXPECT_TRUE(byIndex.Matches(main));
+	EXPECT_FALSE(byIndex.Matches(worker));
+
+	LogQuery byName = LogQuery::Parse("frame thread=\"Query test worker\"");
+	ASSERT_TRUE(byName.error.empty());
+	EXPECT_TRUE(byName.Matches(worker));
+	EXPECT_FALSE(byName.Matches(main));
+	EXPECT_FALSE(byName.Matches(LogMessage(LogLevel::Info, "Frame done")));
+
+	// A name typed before the thread sets it is not interned, and matches once the thread is named
+	const LogQuery early = LogQuery::Parse("thread=\"Query test late worker\"");
+	EXPECT_TRUE(early.error.empty());
+	EXPECT_EQ(LogSymbols::Find("Query test late worker"), LogSymbols::NONE);
+	LogMessage late(LogLevel::Info, "Frame done");
+	std::thread lateThread([&late]()
+		{
+			LogThreads::SetName("Query test late worker");
+			late.threadIndex = LogThreads::Current();
+		});
+	lateThread.join();
+	EXPECT_TRUE(early.Matches(late));
+	EXPECT_FALSE(early.Matches(worker));
+}
+
+// Worker: results stream back in sequence order and new entries are followed after the initial scan
+TEST(LogSearchWorkerTest, FindsMatchesAndFollowsNewEntries)
+{
+	CircularLogBuffer store(1000);
+	for (int i = 0; i < 500; ++i)
+		store.Push(LogMessage(i % 10 == 0 ? LogLevel::Error : LogLevel::Info, "entry " + std::to_string(i)));
+
+	LogSearchWorker worker(store);
+	worker.Submit("level:error");
+
+	std::vector<LogMessage> results;
+	auto waitFor = [&](size_t count) {
+		for (int i = 0; i < 200 && results.size() < count; ++i)
+		{
+			worker.FetchResults(results);
+			std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		}
+		};
+
+	waitFor(50);
+	ASSERT_EQ(results.size(), 50u);
+	for (size_t i = 1; i < results.size(); ++i)
+		EXPECT_LT(results[i - 1].sequence, results[i].sequence);
+
+	store.Push(LogMessage(LogLevel::Error, "late error"));
+	waitFor(51);
+	ASSERT_EQ(results.size(), 51u);
+	EXPECT_EQ(results.back().message, "late error");
+}
+
+// Worker: a new query discards all results of the previous one
+TEST(LogSearchWorkerTest, ResubmitDiscardsOldResults)
+{
+	CircularLogBuffer store(100);
+	for (int i = 0; i < 100; ++i)
+		store.Push(LogMessage(LogLevel::Info, i < 50 ? "alpha" : "beta"));
+
+	LogSearchWorker worker(store);
+	worker.Submit("alpha");
+	worker.Submit("beta");
+
+	std::vector<LogMessage> results;
+	for (int i = 0; i < 200 && (worker.IsBusy() || results.size() < 50); ++i)
+	{
+		worker.FetchResults(results);
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+	}
+	worker.FetchResults(results);
+
+	ASSERT_EQ(results.size(), 50u);
+	for (const LogMessage& msg : results)
+		EXPECT_EQ(msg.message, "beta");
+}
@@ -0,0 +1,81 @@
+#include <gtest/gtest.h>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "Logger/Logger.h"
+#include "Logger/LogRateSeries.h"
+
+TEST(LogRateSeriesTest, CountsPerSecondAndLevel)
+{
+	auto series = std::make_unique<LogRateSeries>();
+	const int64_t base = 1760000000;
+
+	series->Record(LogLevel::Info, base, 10);
+	series->Record(LogLevel::Info, base, 11);
+	series->Record(LogLevel::Error, base, 12);
+	series->Record(LogLevel::Warning, base + 2, 13);
+
+	std::vector<LogRateSeries::Bucket> buckets;
+	series->Snapshot(base + 2, 3, buckets);
+	ASSERT_EQ(buckets.size(), 3u);
+
+	EXPECT_EQ(buckets[0].second, base);
+	EXPECT_EQ(buckets[0].counts[static_cast<size_t>(LogLevel::Info)], 2u);
+	EXPECT_EQ(buckets[0].counts[static_cast<size_t>(LogLevel::Error)], 1u);
+	EXPECT_EQ(buckets[0].firstSequence, 10u);
+
+	EXPECT_EQ(buckets[1].Total(), 0u);
+	EXPECT_EQ(buckets[1].firstSequence, LogRateSeries::NO_SEQUENCE);
+
+	EXPECT_EQ(buckets[2].counts[static_cast<size_t>(LogLevel::Warning)], 1u);
+	EXPECT_EQ(buckets[2].firstSequence, 13u);
+}
+
+// One hour later the same slot is reused, the old second must not leak into the new one
+TEST(LogRateSeriesTest, WrapsAfterWindow)
+{
+	auto series = std::make_unique<LogRateSeries>();
+	const int64_t base = 1760000000;
+	const int64_t later = base + LogRateSeries::WINDOW_SECONDS;
+
+	series->Record(LogLevel::Debug, base, 1);
+	series->Record(LogLevel::Info, later, 2);
+	series->Record(LogLevel::Error, base, 3); // Older than the window now, ignored
+
+	std::vector<LogRateSeries::Bucket> buckets;
+	series->Snapshot(later, 1, buckets);
+	ASSERT_EQ(buckets.size(), 1u);
+	EXPECT_EQ(buckets[0].Total(), 1u);
+	EXPECT_EQ(buckets[0].counts[static_cast<size_t>(LogLevel::Info)], 1u);
+	EXPECT_EQ(buckets[0].firstSequence, 2u);
+
+	// The old second reads as empty
+	series->Snapshot(base, 1, buckets);
+	EXPECT_EQ(buckets[0].Total(), 0u);
+}
+
+TEST(LogRateSeriesTest, LoggerRecordsPushes)
+{
+	const int64_t second = LogRateSeries::ToEpochSecond(std::chrono::system_clock::now());
+	std::vector<LogRateSeries::Bucket> before;
+	Logger::GetRateSeries().Snapshot(second + 1, 2, before);
+
+	std::vector<std::thread> threads;
+	for (int t = 0; t < 4; ++t)
+		threads.emplace_back([]()
+			{
+				for (int i = 0; i < 250; ++i)
+					LOG_ERROR("rate test {}", i);
+			});
+	for (std::thread& t : threads)
+		t.join();
+
+	std::vector<LogRateSeries::Bucket> after;
+	Logger::GetRateSeries().Snapshot(second + 1, 2, after);
+
+	uint64_t errors = 0;
+	for (size_t i = 0; i < after.size(); ++i)
+		errors += after[i].counts[static_cast<size_t>(LogLevel::Error)] - before[i].counts[static_cast<size_t>(LogLevel::Error)];
+	EXPECT_EQ(errors, 1000u);
+}
@@ -0,0 +1,183 @@
+#ifndef _WIN32
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "Ipc/LogSocketServer.h"
+#include "Logger/LogSources.h"
+#include "CollectingSink.h"
+
+using namespace gear;
+
+namespace
+{
+	// Connected client socket for either address form
+	struct Client
+	{
+		int fd = -1;
+
+		explicit Client(const std::string& address)
+		{
+			if (address.rfind("udp://", 0) == 0)
+			{
+				fd = ::socket(AF_INET, SOCK_DGRAM, 0);
+				sockaddr_in addr{};
+				addr.sin_family = AF_INET;
+				addr.sin_port = htons(static_cast<uint16_t>(std::stoi(address.substr(6))));
+				addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+				::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+			}
+			else
+			{
+				fd = ::socket(AF_UNIX, SOCK_DGRAM, 0);
+				sockaddr_un addr{};
+				addr.sun_family = AF_UNIX;
+				std::snprintf(addr.sun_path, sizeof(addr.sun_path), "%s", address.c_str());
+				::connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+			}
+		}
+		~Client() { ::close(fd); }
+
+		bool Send(const char* data, size_t size)
+		{
+			// Unix datagram sockets block when the receiver is behind, UDP would drop instead
+			return ::send(fd, data, size, 0) == static_cast<ssize_t>(size);
+		}
+	};
+
+	std::string SocketPath(const char* test)
+	{
+		return "/tmp/gear_test_" + std::string(test) + "_" + std::to_string(::getpid()) + ".sock";
+	}
+}
+
+TEST(LogSocketServerTest, ForwardsRecordsWithProcessSource)
+{
+	const std::string path = SocketPath("basic");
+	CollectingSink<LogSocketServer::Sink> sink;
+	{
+		LogSocketServer server(path, sink.Get());
+		ASSERT_TRUE(server.IsListening()) << server.GetError();
+
+		std::vector<char> buffer(LOG_DATAGRAM_MAX_SIZE);
+		LogDatagramWriter writer(buffer.data(), buffer.size(), 4242, "pyscript");
+		ASSERT_TRUE(writer.Add(ShmLogLevel::Warning, "disk almost full"));
+		ASSERT_TRUE(writer.Add(ShmLogLevel::Error, "explicit time", 1'700'000'000'000'000'000));
+		ASSERT_TRUE(writer.Add(ShmLogLevel::Debug, ""));
+
+		Client client(path);
+		ASSERT_TRUE(client.Send(writer.Data(), writer.Size()));
+		ASSERT_TRUE(sink.WaitFor(3));
+		EXPECT_EQ(server.GetDatagramCount(), 1u);
+		EXPECT_EQ(server.GetRecordCount(), 3u);
+		EXPECT_EQ(server.GetByteCount(), writer.Size());
+	}
+	EXPECT_NE(::access(path.c_str(), F_OK), 0); // Socket file removed
+
+	ASSERT_EQ(sink.messages.size(), 3u);
+	EXPECT_EQ(sink.messages[0].level, LogLevel::Warning);
+	EXPECT_EQ(sink.messages[0].message, "disk almost full");
+	EXPECT_EQ(LogSources::GetName(sink.messages[0].sourceId), "pyscript:4242");
+	EXPECT_EQ(ToEpochNanoseconds(sink.messages[1].timestamp), 1'700'000'000'000'000'000);
+	EXPECT_EQ(sink.messages[2].level, LogLevel::Debug);
+	EXPECT_TRUE(sink.messages[2].message.empty());
+}
+
+TEST(LogSocketServerTest, RejectsMalformedDatagrams)
+{
+	const std::string path = SocketPath("malformed");
+	CollectingSink<LogSocketServer::Sink> sink;
+	LogSocketServer server(path, sink.Get());
+	ASSERT_TRUE(server.IsListening()) << server.GetError();
+	Client client(path);
+
+	std::vector<char> buffer(1024);
+	LogDatagramWriter writer(buffer.data(), buffer.size(), 1, "bad");
+	ASSERT_TRUE(writer.Add(ShmLogLevel::Info, "0123456789"));
+	ASSERT_TRUE(writer.Add(ShmLogLevel::Info, "abcdef"));
+
+	client.Send("hello", 5);                          // Too short
+	client.Send(writer.Data(), writer.Size() - 1);    // Truncated text
+	client.Send(writer.Data(), writer.Size() + 4);    // Trailing bytes
+	std::vector<char> copy(buffer.begin(), buffer.begin() + writer.Size());
+	copy[6] = 3;                                      // More records than present
+	client.Send(copy.data(), copy.size());
+	copy[6] = 2;
+	copy[0] = 'X';                                    // Wrong magic
+	client.Send(copy.data(), copy.size());
+	client.Send(writer.Data(), writer.Size());        // Valid
+
+	ASSERT_TRUE(sink.WaitFor(2));
+	const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+	while (server.GetRejectedCount() < 5 && std::chrono::steady_clock::now() < deadline)
+		std::this_thread::sleep_for(std::chrono::milliseconds(2));
+	EXPECT_EQ(server.GetRejectedCount(), 5u);
+	EXPECT_EQ(server.GetRecordCount(), 2u);
+}
+
+TEST(LogSocketServerTest, ListensOnLoopbackUdp)
+{
+	// Pick a free port by binding to 0 first
+	int probe = ::socket(AF_INET, SOCK_DGRAM, 0);
+	sockaddr_in addr{};
+	addr.sin_family = AF_INET;
+	addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	::bind(probe, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+	socklen_t length = sizeof(addr);
+	::getsockname(probe, reinterpret_cast<sockaddr*>(&addr), &length);
+	::close(probe);
+	const std::string address = "udp://" + std::to_string(ntohs(addr.sin_port));
+
+	CollectingSink<LogSocketServer::Sink> sink;
+	LogSocketServer server(address, sink.Get());
+	ASSERT_TRUE(server.IsListening()) << server.GetError();
+
+	std::vector<char> buffer(256);
+	LogDatagramWriter writer(buffer.data(), buffer.size(), 7, "udp");
+	ASSERT_TRUE(writer.Add(ShmLogLevel::Info, "over udp"));
+	Client client(address);
+	ASSERT_TRUE(client.Send(writer.Data(), writer.Size()));
+	ASSERT_TRUE(sink.WaitFor(1));
+	EXPECT_EQ(sink.messages[0].message, "over udp");
+
+	EXPECT_FALSE(LogSocketServer("udp://0", sink.Get()).IsListening());
+}
+
+// Throughput smoke test with 100-record datagrams; the 1M msgs/s figure is measured by GearBench (BM_SocketIngest)
+TEST(LogSocketServerTest, SustainsBatchedThroughput)
+{
+	const std::string path = SocketPath("throughput");
+	constexpr size_t datagrams = 5000;
+	constexpr size_t perDatagram = 100;
+
+	CollectingSink<LogSocketServer::Sink> sink;
+	sink.keep = false;
+	LogSocketServer server(path, sink.Get());
+	ASSERT_TRUE(server.IsListening()) << server.GetError();
+
+	std::vector<char> buffer(LOG_DATAGRAM_MAX_SIZE);
+	LogDatagramWriter writer(buffer.data(), buffer.size(), 1, "load");
+	for (size_t i = 0; i < perDatagram; ++i)
+		writer.Add(ShmLogLevel::Info, "Motor \"Left\" Run(): reached target position 1234.5 after 17 ms");
+
+	Client client(path);
+	const auto start = std::chrono::steady_clock::now();
+	for (size_t i = 0; i < datagrams; ++i)
+		ASSERT_TRUE(client.Send(writer.Data(), writer.Size()));
+	ASSERT_TRUE(sink.WaitFor(datagrams * perDatagram, std::chrono::seconds(20)));
+	const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	EXPECT_EQ(server.GetRejectedCount(), 0u);
+	std::printf("[          ] %.2f M msgs/s\n", datagrams * perDatagram / seconds / 1e6);
+}
+
+#endif
@@ -0,0 +1,104 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Logger/Logger.h"
+#include "Logger/LogQuery.h"
+#include "Logger/LogSymbols.h"
+
+TEST(LogSymbolsTest, InternsOnce)
+{
+	const uint32_t sensor = LogSymbols::Intern("SymbolsTestSensor", LogSymbols::ROLE_OBJECT);
+	const uint32_t left = LogSymbols::Intern("SymbolsTestLeft", LogSymbols::ROLE_NAME);
+	ASSERT_NE(sensor, LogSymbols::NONE);
+	EXPECT_NE(sensor, left);
+	EXPECT_EQ(LogSymbols::Intern(std::string("SymbolsTestSensor")), sensor); // Same id for a different buffer
+	EXPECT_EQ(LogSymbols::Find("SymbolsTestSensor"), sensor);
+	EXPECT_EQ(LogSymbols::Find("SymbolsTestUnknown"), LogSymbols::NONE);
+
+	EXPECT_EQ(LogSymbols::GetText(sensor), "SymbolsTestSensor");
+	EXPECT_EQ(LogSymbols::GetText(LogSymbols::NONE), "");
+	EXPECT_GE(LogSymbols::GetCount(), 2u);
+
+	// Roles accumulate
+	EXPECT_EQ(LogSymbols::GetRoles(sensor), LogSymbols::ROLE_OBJECT);
+	LogSymbols::Intern("SymbolsTestSensor", LogSymbols::ROLE_CALLER);
+	EXPECT_EQ(LogSymbols::GetRoles(sensor), LogSymbols::ROLE_OBJECT | LogSymbols::ROLE_CALLER);
+
+	const std::vector<uint32_t> objects = LogSymbols::List(LogSymbols::ROLE_OBJECT);
+	EXPECT_NE(std::find(objects.begin(), objects.end(), sensor), objects.end());
+	EXPECT_EQ(std::find(objects.begin(), objects.end(), left), objects.end());
+}
+
+TEST(LogSymbolsTest, ConcurrentInternAgrees)
+{
+	constexpr int THREADS = 8;
+	constexpr int SYMBOLS = 200;
+	std::vector<std::vector<uint32_t>> ids(THREADS, std::vector<uint32_t>(SYMBOLS));
+
+	std::vector<std::thread> threads;
+	for (int t = 0; t < THREADS; ++t)
+	{
+		threads.emplace_back([t, &ids]()
+			{
+				for (int i = 0; i < SYMBOLS; ++i)
+					ids[t][i] = LogSymbols::Intern("SymbolsTestConcurrent" + std::to_string(i));
+			});
+	}
+	for (std::thread& thread : threads)
+		thread.join();
+
+	std::set<uint32_t> distinct;
+	for (int i = 0; i < SYMBOLS; ++i)
+	{
+		for (int t = 1; t < THREADS; ++t)
+			EXPECT_EQ(ids[t][i], ids[0][i]);
+		EXPECT_EQ(LogSymbols::GetText(ids[0][i]), "SymbolsTestConcurrent" + std::to_string(i));
+		distinct.insert(ids[0][i]);
+	}
+	EXPECT_EQ(distinct.size(), static_cast<size_t>(SYMBOLS));
+}
+
+// LOG1..LOG3 keep their text format and carry the interned prefix ids
+TEST(LogSymbolsTest, LoggerRecordsIds)
+{
+	LOG3_INFO("SymbolsTestCaller", "SymbolsTestMotor", "Left", "moved {} mm", 12);
+
+	const auto& buffer = Logger::GetBuffer();
+	const LogMessage& message = buffer[(Logger::GetReadIndex() + Logger::GetSize() - 1) % buffer.size()];
+	EXPECT_EQ(message.GetText(), "SymbolsTestCaller >> SymbolsTestMotor \"Left\" TestBody(): moved 12 mm");
+	EXPECT_EQ(message.objectId, LogSymbols::Find("SymbolsTestMotor"));
+	EXPECT_EQ(message.nameId, LogSymbols::Find("Left"));
+	EXPECT_EQ(message.callerId, LogSymbols::Find("SymbolsTestCaller"));
+	EXPECT_NE(message.objectId, LogSymbols::NONE);
+
+	// obj= compares the ids
+	const LogQuery query = LogQuery::Parse("obj=SymbolsTestMotor");
+	EXPECT_TRUE(query.error.empty());
+	EXPECT_FALSE(query.IsLevelTimeOnly());
+	EXPECT_TRUE(query.Matches(message));
+	EXPECT_FALSE(LogQuery::Parse("obj=SymbolsTestCaller").Matches(message));
+
+	LogMessage plain(LogLevel::Info, "SymbolsTestMotor TestBody(): same text, no id");
+	EXPECT_FALSE(query.Matches(plain));
+}
+
+// obj= never interns the typed text, an object that starts logging later still matches
+TEST(LogSymbolsTest, QueryDoesNotIntern)
+{
+	const size_t count = LogSymbols::GetCount();
+	const LogQuery query = LogQuery::Parse("obj=SymbolsTestLateObject");
+	EXPECT_TRUE(query.error.empty());
+	EXPECT_FALSE(query.IsLevelTimeOnly());
+	EXPECT_EQ(LogSymbols::Find("SymbolsTestLateObject"), LogSymbols::NONE);
+	EXPECT_EQ(LogSymbols::GetCount(), count);
+
+	LOG1_INFO("SymbolsTestLateObject", "started");
+	const auto& buffer = Logger::GetBuffer();
+	const LogMessage& message = buffer[(Logger::GetReadIndex() + Logger::GetSize() - 1) % buffer.size()];
+	EXPECT_TRUE(query.Matches(message));
+	EXPECT_FALSE(LogQuery::Parse("obj=SymbolsTestLate").Matches(message));
+}
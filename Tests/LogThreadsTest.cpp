@@ -0,0 +1,55 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+#include "Logger/LogThreads.h"
+
+// Every thread gets its own index on its first call and keeps it
+TEST(LogThreadsTest, DistinctIndexPerThread)
+{
+	const uint16_t main = LogThreads::Current();
+	ASSERT_NE(main, LogThreads::NONE);
+	EXPECT_EQ(LogThreads::Current(), main);
+
+	std::vector<uint16_t> indexes(4, LogThreads::NONE);
+	std::vector<std::thread> threads;
+	for (size_t i = 0; i < indexes.size(); ++i)
+		threads.emplace_back([&indexes, i]() { indexes[i] = LogThreads::Current(); });
+	for (auto& thread : threads)
+		thread.join();
+
+	for (size_t i = 0; i < indexes.size(); ++i)
+	{
+		EXPECT_NE(indexes[i], LogThreads::NONE);
+		EXPECT_NE(indexes[i], main);
+		for (size_t j = i + 1; j < indexes.size(); ++j)
+			EXPECT_NE(indexes[i], indexes[j]);
+		EXPECT_LE(indexes[i], LogThreads::GetCount());
+	}
+}
+
+// Unnamed threads show as "Thread N", names also apply to the messages logged before
+TEST(LogThreadsTest, NamesAndMessageCounts)
+{
+	uint16_t index = LogThreads::NONE;
+	std::thread worker([&index]()
+		{
+			index = LogThreads::Current();
+			LogThreads::Record(index);
+			LogThreads::Record(index);
+		});
+	worker.join();
+
+	EXPECT_EQ(LogThreads::GetName(index), "Thread " + std::to_string(index));
+	EXPECT_EQ(LogThreads::GetMessageCount(index), 2u);
+	EXPECT_EQ(LogThreads::GetName(LogThreads::NONE), "");
+
+	std::thread named([&index]()
+		{
+			LogThreads::SetName("Camera grabber");
+			index = LogThreads::Current();
+		});
+	named.join();
+	EXPECT_EQ(LogThreads::GetName(index), "Camera grabber");
+	EXPECT_EQ(LogThreads::GetMessageCount(index), 0u);
+}
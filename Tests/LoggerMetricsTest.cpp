@@ -0,0 +1,140 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+#include "Logger/Logger.h"
+#include "Logger/LogToFile.h"
+#include "Logger/LatencyHistogram.h"
+
+TEST(LatencyHistogramTest, BucketLayout)
+{
+	// Exact below 8, then 8 sub-buckets per power of two
+	for (uint64_t v = 0; v < 8; ++v)
+		EXPECT_EQ(LatencyHistogram::BucketIndex(v), v);
+	EXPECT_EQ(LatencyHistogram::BucketIndex(8), 8u);
+	EXPECT_EQ(LatencyHistogram::BucketIndex(15), 15u);
+	EXPECT_EQ(LatencyHistogram::BucketIndex(16), 16u);
+	EXPECT_EQ(LatencyHistogram::BucketIndex(17), 16u);
+	EXPECT_EQ(LatencyHistogram::BucketIndex(UINT64_MAX), LatencyHistogram::BUCKET_COUNT - 1);
+
+	// Bounds are consistent with the index mapping and contiguous
+	for (size_t i = 0; i + 1 < LatencyHistogram::BUCKET_COUNT; ++i)
+	{
+		EXPECT_EQ(LatencyHistogram::BucketIndex(LatencyHistogram::BucketLowerBound(i)), i);
+		EXPECT_EQ(LatencyHistogram::BucketIndex(LatencyHistogram::BucketUpperBound(i)), i);
+		EXPECT_EQ(LatencyHistogram::BucketUpperBound(i) + 1, LatencyHistogram::BucketLowerBound(i + 1));
+	}
+}
+
+// Percentiles must stay within the 12.5% bucket resolution of the exact values
+TEST(LatencyHistogramTest, PercentileAccuracy)
+{
+	std::mt19937_64 rng(42);
+	std::lognormal_distribution<double> dist(7.0, 1.0); // ~1 us median, long tail
+
+	std::vector<uint64_t> values(100000);
+	LatencyHistogram histogram;
+	for (uint64_t& v : values)
+	{
+		v = static_cast<uint64_t>(dist(rng));
+		histogram.Record(v);
+	}
+	std::sort(values.begin(), values.end());
+
+	for (double p : { 50.0, 90.0, 99.0, 99.9 })
+	{
+		const uint64_t exact = values[static_cast<size_t>(p / 100.0 * values.size()) - 1];
+		const uint64_t approx = histogram.GetPercentile(p);
+		EXPECT_GE(approx, exact) << "p" << p;
+		EXPECT_LE(static_cast<double>(approx), exact * 1.125 + 1) << "p" << p;
+	}
+	EXPECT_EQ(histogram.GetPercentile(100.0), values.back());
+	EXPECT_EQ(histogram.GetMax(), values.back());
+	EXPECT_EQ(histogram.GetCount(), values.size());
+}
+
+TEST(LoggerMetricsTest, SnapshotCountsProducers)
+{
+	const LoggerMetricsSnapshot before = Logger::GetMetrics();
+
+	const int perThread = 1000;
+	std::vector<std::thread> threads;
+	for (int t = 0; t < 4; ++t)
+		threads.emplace_back([]()
+			{
+				for (int i = 0; i < perThread; ++i)
+					LOG_DEBUG("metrics test {}", i);
+			});
+	for (std::thread& t : threads)
+		t.join();
+
+	const LoggerMetricsSnapshot after = Logger::GetMetrics();
+	EXPECT_EQ(after.enqueueLatency.GetCount() - before.enqueueLatency.GetCount(), 4u * perThread);
+	EXPECT_GE(after.ringPushes - before.ringPushes, 4u * perThread);
+	EXPECT_GE(after.producerThreads, 4u);
+	EXPECT_GT(after.enqueueLatency.GetMax(), 0u);
+	EXPECT_GE(after.enqueueLatency.GetPercentile(99.0), after.enqueueLatency.GetPercentile(50.0));
+	EXPECT_GE(after.file.queueHighWater, 1u);
+}
+
+TEST(LoggerMetricsTest, FileWriterStats)
+{
+	const std::filesystem::path folder = "test_logs_metrics";
+	std::filesystem::remove_all(folder);
+
+	{
+		LogToFile logger(folder.string(), "test.log", 1, 3); // 1 KB files, rotates often
+
+		const std::string line(100, 'x');
+		const size_t lineCount = 200;
+		for (size_t i = 0; i < lineCount; ++i)
+			logger.Write(LogMessage(LogLevel::Info, line));
+
+		const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+		while (logger.GetStats().linesWritten < lineCount && std::chrono::steady_clock::now() < deadline)
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+		const LogFileStats stats = logger.GetStats();
+		EXPECT_EQ(stats.linesWritten, lineCount);
+		EXPECT_EQ(stats.bytesWritten, lineCount * (LogMessage(LogLevel::Info, line).ToStringForFile().size() + 1));
+		EXPECT_GE(stats.rotations, 10u);
+		EXPECT_GE(stats.maxRotationNs, stats.lastRotationNs);
+		EXPECT_GT(stats.maxRotationNs, 0u);
+		EXPECT_EQ(stats.queueDepth, 0u);
+		EXPECT_GE(stats.queueHighWater, 1u);
+		EXPECT_EQ(stats.droppedMessages, 0u);
+	}
+
+	std::filesystem::remove_all(folder);
+}
+
+// A writer that can't keep up drops queued lines and counts every discarded one
+TEST(LoggerMetricsTest, CountsQueueOverflowDrops)
+{
+	const std::filesystem::path folder = "test_logs_overflow";
+	std::filesystem::remove_all(folder);
+
+	{
+		LogToFile logger(folder.string(), "test.log", 1, 1); // 1 KB files: the writer rotates every few lines
+
+		const LogMessage message(LogLevel::Info, std::string(200, 'x'));
+		const size_t maxWrites = 20 * LogToFile::MAX_QUEUE_SIZE;
+		for (size_t i = 0; i < maxWrites; ++i)
+		{
+			logger.Write(message);
+			if (i % 1000 == 0 && logger.GetStats().droppedMessages > 0)
+				break;
+		}
+
+		const LogFileStats stats = logger.GetStats();
+		EXPECT_GE(stats.droppedMessages, LogToFile::MAX_QUEUE_SIZE);
+		EXPECT_LT(stats.queueDepth, LogToFile::MAX_QUEUE_SIZE);
+	}
+
+	std::filesystem::remove_all(folder);
+}
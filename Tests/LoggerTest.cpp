@@ -1,4 +1,5 @@
 #include <gtest/gtest.h>
+#include <atomic>
 #include <thread>
 #include <chrono>
 #include <filesystem>
@@ -7,6 +8,7 @@
 
 #include "Logger/Logger.h"
 #include "Logger/LogToFile.h"
+#include "Logger/CircularLogBuffer.h"
 
 // Basic: Verify that messages are stored in correct order and with correct log levels
 TEST(LoggerTest, StoresLogsInOrder)
@@ -26,8 +28,76 @@ TEST(LoggerTest, StoresLogsInOrder)
 
 	EXPECT_EQ(msg1.level, LogLevel::Info);
 	EXPECT_EQ(msg2.level, LogLevel::Warning);
-	EXPECT_EQ(msg1.message, "TestBody(): First log");  // this is, because the macro will add the function name
-	EXPECT_EQ(msg2.message, "TestBody(): Second log");
+	EXPECT_EQ(msg1.GetText(), "TestBody(): First log");  // this is, because the macro will add the function name
+	EXPECT_EQ(msg2.GetText(), "TestBody(): Second log");
+}
+
+// The call site is a static LogLocation: the message keeps the user text, the prefix is rendered from it
+TEST(LoggerTest, CarriesSourceLocation)
+{
+	const auto& buffer = Logger::GetBuffer();
+	auto last = [&buffer]() -> const LogMessage& { return buffer[(Logger::GetReadIndex() + Logger::GetSize() - 1) % buffer.size()]; };
+
+	const LogLocation* previous = nullptr;
+	for (int i = 0; i < 2; ++i)
+	{
+		const uint32_t line = __LINE__ + 1;
+		LOG2_WARN("Motor", "Left", "located {}", i);
+		const LogMessage& message = last();
+		EXPECT_EQ(message.message, "located " + std::to_string(i));
+		EXPECT_EQ(message.GetText(), "Motor \"Left\" TestBody(): located " + std::to_string(i));
+		ASSERT_NE(message.location, nullptr);
+		EXPECT_EQ(message.location->GetFileName(), "LoggerTest.cpp");
+		EXPECT_EQ(message.location->source.line(), line);
+		EXPECT_STREQ(message.location->function, "TestBody");
+		EXPECT_EQ(message.location->siteId.load(), message.siteId);
+		if (previous)
+		{
+			EXPECT_EQ(message.location, previous); // One location per call site
+		}
+		previous = message.location;
+	}
+
+	// Files get the rendered text
+	const std::string line = last().ToStringForFile();
+	EXPECT_TRUE(line.ends_with("] Motor \"Left\" TestBody(): located 1")) << line;
+
+	// Messages without a location are shown as they are
+	EXPECT_EQ(LogMessage(LogLevel::Info, "plain").GetText(), "plain");
+}
+
+// Calls without format arguments are log sites of their own, keyed by their location
+TEST(LoggerTest, PlainMessagesGetOneSitePerCall)
+{
+	const auto& buffer = Logger::GetBuffer();
+	auto last = [&buffer]() -> const LogMessage& { return buffer[(Logger::GetReadIndex() + Logger::GetSize() - 1) % buffer.size()]; };
+
+	const uint32_t line = __LINE__ + 1;
+	LOG_INFO("Fixed string log");
+	const uint32_t first = last().siteId;
+	LOG_WARN(std::string("Runtime string log"));
+	const uint32_t second = last().siteId;
+	LOG1_DEBUG("Motor", "const char* log");
+	const uint32_t third = last().siteId;
+
+	EXPECT_NE(first, LogSymbols::NONE);
+	EXPECT_NE(first, second);
+	EXPECT_NE(second, third);
+	EXPECT_EQ(LogSymbols::GetText(first), "TestBody(): LoggerTest.cpp:" + std::to_string(line));
+
+	// Varying texts of one call stay in its site
+	for (int i = 0; i < 2; ++i)
+	{
+		LOG_INFO(std::to_string(i));
+		if (i == 0)
+		{
+			EXPECT_NE(last().siteId, third);
+		}
+		else
+		{
+			EXPECT_EQ(last().siteId, buffer[(Logger::GetReadIndex() + Logger::GetSize() - 2) % buffer.size()].siteId);
+		}
+	}
 }
 
 // Basic: Verify all overloads of logging macros
@@ -65,28 +135,28 @@ TEST(LoggerTest, StoresAllLogVariantsCorrectly)
 		};
 
 	EXPECT_EQ(get(0).level, LogLevel::Info);
-	EXPECT_EQ(get(0).message, "TestBody(): Log0 plain");
+	EXPECT_EQ(get(0).GetText(), "TestBody(): Log0 plain");
 
 	EXPECT_EQ(get(1).level, LogLevel::Info);
-	EXPECT_EQ(get(1).message, "TestBody(): Log0 formatted value: 123");
+	EXPECT_EQ(get(1).GetText(), "TestBody(): Log0 formatted value: 123");
 
 	EXPECT_EQ(get(2).level, LogLevel::Info);
-	EXPECT_EQ(get(2).message, "Sensor TestBody(): Log1 plain");
+	EXPECT_EQ(get(2).GetText(), "Sensor TestBody(): Log1 plain");
 
 	EXPECT_EQ(get(3).level, LogLevel::Info);
-	EXPECT_EQ(get(3).message, "Sensor TestBody(): Log1 formatted: 3.14");
+	EXPECT_EQ(get(3).GetText(), "Sensor TestBody(): Log1 formatted: 3.14");
 
 	EXPECT_EQ(get(4).level, LogLevel::Info);
-	EXPECT_EQ(get(4).message, "Motor \"Left\" TestBody(): Log2 plain");
+	EXPECT_EQ(get(4).GetText(), "Motor \"Left\" TestBody(): Log2 plain");
 
 	EXPECT_EQ(get(5).level, LogLevel::Info);
-	EXPECT_EQ(get(5).message, "Motor \"Left\" TestBody(): Log2 formatted: 42");
+	EXPECT_EQ(get(5).GetText(), "Motor \"Left\" TestBody(): Log2 formatted: 42");
 
 	EXPECT_EQ(get(6).level, LogLevel::Info);
-	EXPECT_EQ(get(6).message, "Main >> Arm \"Joint1\" TestBody(): Log3 plain");
+	EXPECT_EQ(get(6).GetText(), "Main >> Arm \"Joint1\" TestBody(): Log3 plain");
 
 	EXPECT_EQ(get(7).level, LogLevel::Info);
-	EXPECT_EQ(get(7).message, "Main >> Arm \"Joint1\" TestBody(): Log3 formatted: ok");
+	EXPECT_EQ(get(7).GetText(), "Main >> Arm \"Joint1\" TestBody(): Log3 formatted: ok");
 }
 
 // Buffer Logic: Fill buffer beyond its capacity and check that oldest entries are overwritten
@@ -107,6 +177,179 @@ TEST(LoggerTest, RingBufferOverwritesOldEntries)
 	EXPECT_TRUE(firstMsg.message.find("Overflow test 5") != std::string::npos);
 }
 
+// Buffer Logic: Growing and shrinking keeps the newest entries in order, with their sequence numbers
+TEST(LoggerTest, RingBufferResize)
+{
+	CircularLogBuffer ring(8);
+	for (int i = 0; i < 12; ++i)
+		ring.Push(LogMessage(LogLevel::Info, "entry " + std::to_string(i)));
+
+	auto entry = [&ring](size_t i) -> const LogMessage& { return ring.GetBuffer()[(ring.GetReadIndex() + i) % ring.GetCapacity()]; };
+
+	ring.Resize(100);
+	ASSERT_EQ(ring.GetCapacity(), 100u);
+	ASSERT_EQ(ring.GetSize(), 8u);
+	for (size_t i = 0; i < 8; ++i)
+	{
+		EXPECT_EQ(entry(i).message, "entry " + std::to_string(i + 4));
+		EXPECT_EQ(entry(i).sequence, i + 4);
+	}
+
+	ring.Push(LogMessage(LogLevel::Info, "entry 12"));
+	EXPECT_EQ(ring.GetSize(), 9u);
+	EXPECT_EQ(entry(8).message, "entry 12");
+	EXPECT_EQ(entry(8).sequence, 12u);
+
+	ring.Resize(3);
+	ASSERT_EQ(ring.GetSize(), 3u);
+	for (size_t i = 0; i < 3; ++i)
+		EXPECT_EQ(entry(i).message, "entry " + std::to_string(i + 10));
+
+	// Keeps overwriting the oldest entry after the resize
+	ring.Push(LogMessage(LogLevel::Info, "entry 13"));
+	EXPECT_EQ(ring.GetSize(), 3u);
+	EXPECT_EQ(entry(0).message, "entry 11");
+	EXPECT_EQ(entry(2).message, "entry 13");
+	EXPECT_EQ(ring.GetTotalPushed(), 14u);
+
+	CircularLogBuffer empty(4);
+	empty.Resize(16);
+	EXPECT_EQ(empty.GetSize(), 0u);
+	empty.Push(LogMessage(LogLevel::Info, "first"));
+	EXPECT_EQ(empty.GetBuffer()[empty.GetReadIndex()].message, "first");
+}
+
+// Buffer Logic: BeginResize() prepares the storage in the background, the ring keeps its capacity until FinishResize()
+TEST(LoggerTest, RingBufferResizeInBackground)
+{
+	CircularLogBuffer ring(8);
+	for (int i = 0; i < 6; ++i)
+		ring.Push(LogMessage(LogLevel::Info, "entry " + std::to_string(i)));
+
+	ASSERT_TRUE(ring.BeginResize(1000));
+	EXPECT_TRUE(ring.IsResizing());
+	EXPECT_FALSE(ring.BeginResize(16)); // One at a time
+	EXPECT_EQ(ring.GetCapacity(), 8u);
+	EXPECT_EQ(ring.GetPendingCapacity(), 1000u);
+
+	ring.Push(LogMessage(LogLevel::Info, "entry 6"));
+	const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+	while (!ring.FinishResize() && std::chrono::steady_clock::now() < deadline)
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+
+	ASSERT_EQ(ring.GetCapacity(), 1000u);
+	ASSERT_EQ(ring.GetSize(), 7u);
+	for (size_t i = 0; i < 7; ++i)
+		EXPECT_EQ(ring.GetBuffer()[(ring.GetReadIndex() + i) % ring.GetCapacity()].message, "entry " + std::to_string(i));
+
+	// The old storage is freed in the background
+	while (ring.IsResizing() && std::chrono::steady_clock::now() < deadline)
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	EXPECT_FALSE(ring.IsResizing());
+}
+
+// Buffer Logic: Resizing while producers push loses nothing that fits into the new capacity
+TEST(LoggerTest, RingBufferResizeUnderLoad)
+{
+	CircularLogBuffer ring(1000);
+	std::atomic<bool> stop{ false };
+	std::thread producer([&]()
+		{
+			for (uint64_t i = 0; !stop.load(); ++i)
+				ring.Push(LogMessage(LogLevel::Info, std::to_string(i)));
+		});
+
+	while (ring.GetTotalPushed() < 5000)
+		std::this_thread::yield();
+	ring.Resize(200000);
+	ring.Resize(50000);
+	stop = true;
+	producer.join();
+
+	// Contiguous sequences, each text matching its sequence
+	const size_t size = ring.GetSize();
+	ASSERT_GT(size, 0u);
+	const uint64_t oldest = ring.GetTotalPushed() - size;
+	for (size_t i = 0; i < size; ++i)
+	{
+		const LogMessage& message = ring.GetBuffer()[(ring.GetReadIndex() + i) % ring.GetCapacity()];
+		ASSERT_EQ(message.sequence, oldest + i);
+		ASSERT_EQ(message.message, std::to_string(message.sequence));
+	}
+}
+
+// Oversized messages are cut at the maximum length (user text, without the prefix) on a UTF-8 boundary and keep their original length
+TEST(LoggerTest, TruncatesOversizedMessages)
+{
+	const auto& buffer = Logger::GetBuffer();
+	auto last = [&buffer]() -> const LogMessage& { return buffer[(Logger::GetReadIndex() + Logger::GetSize() - 1) % buffer.size()]; };
+
+	Logger::SetMaxMessageLength(64);
+	const std::string blob(100000, 'x');
+	LOG_DEBUG("blob {}", blob);
+	EXPECT_EQ(last().message, "blob " + std::string(64 - 5, 'x') + "... [truncated, 100005 bytes]");
+	EXPECT_EQ(last().fullLength, 100005u);
+	EXPECT_EQ(last().attachmentOffset, -1);
+
+	// "\xC3\xA4" (a-umlaut) would be split at byte 64
+	LOG_INFO("{}\xC3\xA4 tail", std::string(63, 'y'));
+	EXPECT_EQ(last().GetText(), "TestBody(): " + std::string(63, 'y') + "... [truncated, 70 bytes]");
+
+	LOG_INFO("short");
+	EXPECT_EQ(last().GetText(), "TestBody(): short");
+	EXPECT_EQ(last().fullLength, 0u);
+
+	// With attachments the full text goes to the side file
+	ASSERT_TRUE(Logger::SetAttachmentsEnabled(true));
+	LOG1_WARN("Camera", "frame {}", blob);
+	const LogMessage& attached = last();
+	EXPECT_EQ(attached.fullLength, 100006u);
+	EXPECT_GE(attached.attachmentOffset, 0);
+	EXPECT_NE(attached.message.find("attachment @"), std::string::npos);
+
+	// Written by the file writer thread
+	std::string full;
+	const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+	while (!Logger::ReadAttachment(attached, full) && std::chrono::steady_clock::now() < deadline)
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	EXPECT_EQ(full, "frame " + blob);
+
+	Logger::SetAttachmentsEnabled(false);
+	Logger::SetMaxMessageLength(Logger::DEFAULT_MAX_MESSAGE_LENGTH);
+}
+
+// Attachments: ranges are reserved up front and can be written in any order
+TEST(LoggerTest, AttachmentsWriteAtReservedOffsets)
+{
+	const std::filesystem::path path = "test_attachments/out-of-order.attachments";
+	std::filesystem::remove_all(path.parent_path());
+
+	LogAttachments attachments;
+	ASSERT_TRUE(attachments.Open(path));
+	const int64_t first = attachments.Reserve(5);
+	const int64_t second = attachments.Reserve(3);
+	EXPECT_EQ(first, 0);
+	EXPECT_EQ(second, 6);
+	EXPECT_EQ(attachments.GetSize(), 10u);
+
+	EXPECT_TRUE(attachments.WriteAt(static_cast<uint64_t>(second), "two"));
+	EXPECT_TRUE(attachments.WriteAt(static_cast<uint64_t>(first), "first"));
+	attachments.Close();
+	EXPECT_EQ(attachments.Reserve(1), -1);
+
+	std::string text;
+	ASSERT_TRUE(LogAttachments::Read(path, first, 5, text));
+	EXPECT_EQ(text, "first");
+	ASSERT_TRUE(LogAttachments::Read(path, second, 3, text));
+	EXPECT_EQ(text, "two");
+
+	// Offsets continue behind the data of an earlier run
+	ASSERT_TRUE(attachments.Open(path));
+	EXPECT_EQ(attachments.Reserve(1), 10);
+	attachments.Close();
+	std::filesystem::remove_all(path.parent_path());
+}
+
 // Thread Safety: Spawn multiple threads that write logs concurrently and verify no crash or data corruption
 TEST(LoggerTest, ThreadSafety_MultipleThreadsWrite)
 {
@@ -250,6 +493,65 @@ TEST(LoggerFileTest, Rotation)
 	std::filesystem::remove_all(folder);
 }
 
+// File Logging: Segments are rotated before a line would exceed the size limit, the prepared segment is removed on shutdown
+TEST(LoggerFileTest, RotationKeepsSegmentsWithinLimit)
+{
+	std::string folder = GenerateUniqueLogFolder();
+	const auto folderPath = std::filesystem::path(folder);
+
+	{
+		LogToFile logger(folder, "test.log", 4, 3);
+		for (int i = 0; i < 200; ++i)
+			logger.Write(LogMessage(LogLevel::Info, std::string(100, 'x')));
+	}
+
+	for (int i = 1; i <= 3; ++i)
+	{
+		const auto backupPath = folderPath / ("test.log." + std::to_string(i));
+		ASSERT_TRUE(std::filesystem::exists(backupPath));
+		EXPECT_LE(std::filesystem::file_size(backupPath), 4u * 1024u);
+		EXPECT_GT(std::filesystem::file_size(backupPath), 3u * 1024u);
+	}
+	EXPECT_FALSE(std::filesystem::exists(folderPath / "test.log.next"));
+
+	std::filesystem::remove_all(folder);
+}
+
+// File Logging: Time-based rotation starts a new segment at the interval boundary, even without size pressure
+TEST(LoggerFileTest, TimeRotation)
+{
+	std::string folder = GenerateUniqueLogFolder();
+	const auto folderPath = std::filesystem::path(folder);
+
+	{
+		LogToFile logger(folder, "test.log", 1024, 3);
+		logger.SetRotationInterval(std::chrono::seconds(1));
+		EXPECT_EQ(logger.GetRotationInterval(), std::chrono::seconds(1));
+
+		logger.Write("Before boundary");
+		const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+		while (logger.GetStats().rotations == 0 && std::chrono::steady_clock::now() < deadline)
+			std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		EXPECT_EQ(logger.GetStats().rotations, 1u); // Rotated by the idle writer, the empty new segment is kept
+
+		logger.SetRotationInterval(std::chrono::seconds(0));
+		logger.Write("After boundary");
+	}
+
+	std::ifstream backup(folderPath / "test.log.1");
+	std::string line;
+	ASSERT_TRUE(std::getline(backup, line));
+	EXPECT_NE(line.find("Before boundary"), std::string::npos);
+	EXPECT_FALSE(std::getline(backup, line));
+
+	std::ifstream current(folderPath / "test.log");
+	ASSERT_TRUE(std::getline(current, line));
+	EXPECT_NE(line.find("After boundary"), std::string::npos);
+	EXPECT_FALSE(std::getline(current, line));
+
+	std::filesystem::remove_all(folder);
+}
+
 // File Logging: Test thread safety by logging concurrently from multiple threads
 TEST(LoggerFileTest, ThreadSafety)
 {
@@ -0,0 +1,20 @@
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdint>
+
+#include "Platform/ProcessCpu.h"
+
+// Busy work shows up as process CPU time (bounded by wall time, tests may share the CPU)
+TEST(ProcessCpuTest, CountsBusyTime)
+{
+	const double before = gear::GetProcessCpuSeconds();
+	const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+	volatile uint64_t sink = 0;
+	while (gear::GetProcessCpuSeconds() - before < 0.05 && std::chrono::steady_clock::now() < deadline)
+		for (int i = 0; i < 10000; ++i)
+			sink = sink + 1;
+
+	const double busy = gear::GetProcessCpuSeconds() - before;
+	EXPECT_GE(busy, 0.05);
+	EXPECT_LT(busy, 5.0);
+}
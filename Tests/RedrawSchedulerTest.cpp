@@ -0,0 +1,40 @@
+#include <gtest/gtest.h>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "Utils/RedrawScheduler.h"
+
+namespace
+{
+	std::atomic<int> wakeCount{ 0 };
+	void CountWake() { wakeCount.fetch_add(1); }
+}
+
+// Requests coalesce: only the first one after the loop consumed the flag wakes it
+TEST(RedrawSchedulerTest, CoalescesRequestsUntilConsumed)
+{
+	gear::RedrawScheduler::ConsumeRequest();
+	gear::RedrawScheduler::SetWakeFunction(&CountWake);
+	wakeCount = 0;
+
+	std::vector<std::thread> threads;
+	for (int t = 0; t < 4; ++t)
+		threads.emplace_back([]() { for (int i = 0; i < 1000; ++i) gear::RedrawScheduler::RequestRedraw(); });
+	for (auto& thread : threads)
+		thread.join();
+
+	EXPECT_EQ(wakeCount.load(), 1);
+	EXPECT_TRUE(gear::RedrawScheduler::ConsumeRequest());
+	EXPECT_FALSE(gear::RedrawScheduler::ConsumeRequest());
+
+	gear::RedrawScheduler::RequestRedraw();
+	EXPECT_EQ(wakeCount.load(), 2);
+	EXPECT_TRUE(gear::RedrawScheduler::ConsumeRequest());
+
+	// Without a wake function requests only set the flag
+	gear::RedrawScheduler::SetWakeFunction(nullptr);
+	gear::RedrawScheduler::RequestRedraw();
+	EXPECT_EQ(wakeCount.load(), 2);
+	EXPECT_TRUE(gear::RedrawScheduler::ConsumeRequest());
+}
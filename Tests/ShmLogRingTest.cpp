@@ -0,0 +1,168 @@
+#ifndef _WIN32
+
+#include <gtest/gtest.h>
+#include <chrono>
+#include <map>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "Ipc/ShmLogConsumer.h"
+#include "Ipc/ShmLogProducer.h"
+#include "Logger/LogSources.h"
+#include "CollectingSink.h"
+
+using namespace gear;
+
+namespace
+{
+	std::string UniqueName(const char* test)
+	{
+		return std::string("/gear_test_") + test + "_" + std::to_string(::getpid());
+	}
+}
+
+TEST(ShmLogRingTest, ForwardsRecordsWithProcessSource)
+{
+	const std::string name = UniqueName("basic");
+	CollectingSink<ShmLogConsumer::Sink> sink;
+	{
+		ShmLogConsumer consumer(name, sink.Get(), 64, 256);
+		ASSERT_TRUE(consumer.IsOpen()) << consumer.GetError();
+
+		ShmLogProducer producer(name, "testworker");
+		ASSERT_TRUE(producer.IsAttached());
+		EXPECT_TRUE(producer.Log(ShmLogLevel::Warning, "disk almost full"));
+		EXPECT_TRUE(producer.Log(ShmLogLevel::Error, std::string(1000, 'x'))); // Truncated to the slot
+		ASSERT_TRUE(sink.WaitFor(2));
+		EXPECT_EQ(consumer.GetProcessCount(), 1u);
+	}
+	ShmLogConsumer::Unlink(name);
+
+	ASSERT_EQ(sink.messages.size(), 2u);
+	EXPECT_EQ(sink.messages[0].level, LogLevel::Warning);
+	EXPECT_EQ(sink.messages[0].message, "disk almost full");
+	EXPECT_EQ(LogSources::GetName(sink.messages[0].sourceId), "testworker:" + std::to_string(::getpid()));
+	EXPECT_EQ(sink.messages[1].level, LogLevel::Error);
+	EXPECT_EQ(sink.messages[1].message.size(), 256 - sizeof(ShmLogSlot));
+}
+
+// Producers that started before GEAR attach once the ring exists
+TEST(ShmLogRingTest, ProducerAttachesLater)
+{
+	const std::string name = UniqueName("late");
+	ShmLogConsumer::Unlink(name);
+
+	ShmLogProducer producer(name, "early");
+	EXPECT_FALSE(producer.IsAttached());
+	EXPECT_FALSE(producer.Log(ShmLogLevel::Info, "lost"));
+
+	CollectingSink<ShmLogConsumer::Sink> sink;
+	{
+		ShmLogConsumer consumer(name, sink.Get(), 64, 256);
+		ASSERT_TRUE(consumer.IsOpen());
+
+		const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(3);
+		while (!producer.Log(ShmLogLevel::Info, "found") && std::chrono::steady_clock::now() < deadline)
+			std::this_thread::sleep_for(std::chrono::milliseconds(50));
+		EXPECT_TRUE(producer.IsAttached());
+		ASSERT_TRUE(sink.WaitFor(1));
+	}
+	ShmLogConsumer::Unlink(name);
+	EXPECT_EQ(sink.messages[0].message, "found");
+}
+
+TEST(ShmLogRingTest, CountsDropsWhenFull)
+{
+	const std::string name = UniqueName("full");
+	CollectingSink<ShmLogConsumer::Sink> sink;
+	{
+		ShmLogConsumer consumer(name, sink.Get(), 16, 128);
+		ShmLogProducer producer(name, "flood");
+
+		// Stall the consumer inside its sink so the ring fills up
+		sink.blocked = true;
+		ASSERT_TRUE(producer.Log(ShmLogLevel::Info, "first"));
+		std::this_thread::sleep_for(std::chrono::milliseconds(50)); // Consumer takes 'first' and blocks
+
+		size_t stored = 0;
+		for (int i = 0; i < 40; ++i)
+			stored += producer.Log(ShmLogLevel::Info, "msg " + std::to_string(i)) ? 1 : 0;
+		EXPECT_EQ(stored, 16u);
+		EXPECT_EQ(consumer.GetDroppedCount(), 24u);
+		EXPECT_EQ(producer.GetDroppedCount(), 24u);
+
+		sink.blocked = false;
+		ASSERT_TRUE(sink.WaitFor(17));
+	}
+	ShmLogConsumer::Unlink(name);
+	EXPECT_EQ(sink.messages.back().message, "msg 15");
+}
+
+// Several threads in several processes log concurrently, nothing may be lost or duplicated
+TEST(ShmLogRingTest, MultiProcessProducers)
+{
+	const std::string name = UniqueName("multi");
+	constexpr int processCount = 3;
+	constexpr int threadCount = 4;
+	constexpr int perThread = 5000;
+
+	CollectingSink<ShmLogConsumer::Sink> sink;
+	{
+		ShmLogConsumer consumer(name, sink.Get(), 1024, 128);
+		ASSERT_TRUE(consumer.IsOpen());
+
+		std::vector<pid_t> children;
+		for (int p = 0; p < processCount; ++p)
+		{
+			const pid_t pid = ::fork();
+			if (pid == 0)
+			{
+				ShmLogProducer producer(name, "child" + std::to_string(p));
+				std::vector<std::thread> threads;
+				for (int t = 0; t < threadCount; ++t)
+					threads.emplace_back([&producer, t]()
+						{
+							for (int i = 0; i < perThread; ++i)
+							{
+								const std::string text = std::to_string(t) + ":" + std::to_string(i);
+								while (!producer.Log(ShmLogLevel::Debug, text))
+									std::this_thread::yield(); // Ring full, retry
+							}
+						});
+				for (std::thread& thread : threads)
+					thread.join();
+				::_exit(0);
+			}
+			children.push_back(pid);
+		}
+
+		for (pid_t child : children)
+		{
+			int status = 0;
+			::waitpid(child, &status, 0);
+			EXPECT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+		}
+
+		EXPECT_TRUE(sink.WaitFor(processCount * threadCount * perThread, std::chrono::seconds(20)));
+		EXPECT_EQ(consumer.GetProcessCount(), static_cast<size_t>(processCount));
+	}
+	ShmLogConsumer::Unlink(name);
+
+	// Per (source, thread) the sequence of numbers must be complete and in order
+	std::map<std::pair<uint16_t, int>, int> next;
+	for (const LogMessage& message : sink.messages)
+	{
+		const size_t colon = message.message.find(':');
+		const int thread = std::stoi(message.message.substr(0, colon));
+		const int index = std::stoi(message.message.substr(colon + 1));
+		int& expected = next[{ message.sourceId, thread }];
+		ASSERT_EQ(index, expected);
+		++expected;
+	}
+	EXPECT_EQ(sink.messages.size(), static_cast<size_t>(processCount * threadCount * perThread));
+}
+
+#endif
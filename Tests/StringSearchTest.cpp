@@ -0,0 +1,93 @@
+#include <gtest/gtest.h>
+#include <algorithm>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Utils/StringSearch.h"
+
+namespace
+{
+	const gear::SimdLevel ALL_SIMD_LEVELS[] = { gear::SimdLevel::Scalar, gear::SimdLevel::Sse2, gear::SimdLevel::Avx2 };
+
+	// Reference implementation: the lowercase-copy-and-find approach this replaces
+	size_t FindLowerCopy(std::string haystack, std::string needle)
+	{
+		auto lower = [](std::string& s) { std::transform(s.begin(), s.end(), s.begin(), [](char c) { return gear::ToLowerAscii(c); }); };
+		lower(haystack);
+		lower(needle);
+		const size_t pos = haystack.find(needle);
+		return pos == std::string::npos ? gear::NOT_FOUND : pos;
+	}
+}
+
+TEST(StringSearchTest, BasicMatches)
+{
+	for (gear::SimdLevel simd : ALL_SIMD_LEVELS)
+	{
+		SCOPED_TRACE(gear::SimdLevelName(simd));
+		EXPECT_EQ(gear::FindNoCase("Motor overheated", "MOTOR", simd), 0u);
+		EXPECT_EQ(gear::FindNoCase("Motor overheated", "HEAT", simd), 10u);
+		EXPECT_EQ(gear::FindNoCase("Motor overheated", "d", simd), 15u);
+		EXPECT_EQ(gear::FindNoCase("Motor overheated", "", simd), 0u);
+		EXPECT_EQ(gear::FindNoCase("Motor", "Motor overheated", simd), gear::NOT_FOUND);
+		EXPECT_EQ(gear::FindNoCase("Motor overheated", "cooled", simd), gear::NOT_FOUND);
+		EXPECT_EQ(gear::FindNoCase("", "a", simd), gear::NOT_FOUND);
+
+		// Only ASCII letters are folded: '@' (0x40) and '`' (0x60) differ by 0x20 but are not letters
+		EXPECT_EQ(gear::FindNoCase("user@host", "`", simd), gear::NOT_FOUND);
+		EXPECT_EQ(gear::FindNoCase("Temperatur \xC3\x9C" "berschritten", "\xC3\x9C" "BER", simd), 11u);
+		EXPECT_EQ(gear::FindNoCase("Temperatur \xC3\x9C" "berschritten", "\xC3\xBC" "ber", simd), gear::NOT_FOUND);
+	}
+
+	EXPECT_TRUE(gear::EqualsNoCase("ICON_FA_Bell", "icon_fa_bell"));
+	EXPECT_FALSE(gear::EqualsNoCase("icon", "icons"));
+	EXPECT_TRUE(gear::StartsWithNoCase("Sensor.Left", "sensor"));
+	EXPECT_FALSE(gear::StartsWithNoCase("Sen", "sensor"));
+}
+
+// Matches at every offset and across the 16/32 byte block boundaries, every length combination
+TEST(StringSearchTest, MatchesReferenceAtAllOffsets)
+{
+	for (size_t size = 1; size <= 100; ++size)
+	{
+		for (size_t needleSize = 1; needleSize <= std::min<size_t>(size, 40); needleSize += 3)
+		{
+			for (size_t offset = 0; offset + needleSize <= size; ++offset)
+			{
+				std::string haystack(size, 'x');
+				std::string needle(needleSize, 'A');
+				needle.back() = 'Z';
+				std::fill_n(haystack.begin() + offset, needleSize, 'a');
+				haystack[offset + needleSize - 1] = 'z';
+
+				for (gear::SimdLevel simd : ALL_SIMD_LEVELS)
+					ASSERT_EQ(gear::FindNoCase(haystack, needle, simd), offset) << size << "/" << needleSize << "/" << offset;
+			}
+		}
+	}
+}
+
+// Random texts over a small alphabet produce many partial matches (first/last byte hits)
+TEST(StringSearchTest, RandomTextsMatchReference)
+{
+	std::mt19937 rng(7);
+	const char alphabet[] = "aAbBcC_\x80\xE4";
+	auto randomString = [&](size_t size)
+		{
+			std::string s(size, ' ');
+			for (char& c : s)
+				c = alphabet[rng() % (sizeof(alphabet) - 1)];
+			return s;
+		};
+
+	for (int run = 0; run < 5000; ++run)
+	{
+		const std::string haystack = randomString(rng() % 200);
+		const std::string needle = randomString(1 + rng() % 6);
+		const size_t expected = FindLowerCopy(haystack, needle);
+
+		for (gear::SimdLevel simd : ALL_SIMD_LEVELS)
+			ASSERT_EQ(gear::FindNoCase(haystack, needle, simd), expected) << "'" << haystack << "' / '" << needle << "'";
+	}
+}
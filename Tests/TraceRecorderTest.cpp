@@ -0,0 +1,105 @@
+#include <gtest/gtest.h>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Trace/TraceRecorder.h"
+
+using namespace gear;
+
+namespace
+{
+	size_t CountOccurrences(const std::string& text, const std::string& pattern)
+	{
+		size_t count = 0;
+		for (size_t pos = text.find(pattern); pos != std::string::npos; pos = text.find(pattern, pos + 1))
+			++count;
+		return count;
+	}
+
+	std::string ExportToString()
+	{
+		std::ostringstream out;
+		TraceRecorder::WriteChromeTrace(out);
+		return out.str();
+	}
+}
+
+TEST(TraceRecorderTest, RecordsNestedScopesOnlyWhileCapturing)
+{
+	TraceRecorder::Stop();
+	{
+		GEAR_TRACE_SCOPE("ignored");
+	}
+
+	TraceRecorder::Start();
+	TraceRecorder::SetThreadName("Test \"Main\"");
+	{
+		GEAR_TRACE_SCOPE("outer");
+		{
+			GEAR_TRACE_SCOPE("inner");
+		}
+		GEAR_TRACE_BEGIN("manual");
+		GEAR_TRACE_END("manual");
+	}
+	TraceRecorder::Stop();
+	{
+		GEAR_TRACE_SCOPE("ignored");
+	}
+
+	EXPECT_EQ(TraceRecorder::GetEventCount(), 6u);
+	const std::string json = ExportToString();
+	EXPECT_EQ(json.find("ignored"), std::string::npos);
+	EXPECT_EQ(CountOccurrences(json, "\"ph\":\"B\""), 3u);
+	EXPECT_EQ(CountOccurrences(json, "\"ph\":\"E\""), 3u);
+	EXPECT_NE(json.find("\"name\":\"Test \\\"Main\\\"\""), std::string::npos); // Escaped thread name
+
+	// Events keep their order: outer begins before inner, inner ends before outer
+	EXPECT_LT(json.find("\"name\":\"outer\""), json.find("\"name\":\"inner\""));
+	EXPECT_LT(json.rfind("\"name\":\"inner\""), json.rfind("\"name\":\"outer\""));
+}
+
+TEST(TraceRecorderTest, SeparatesThreadsAndRestartsCaptures)
+{
+	TraceRecorder::Start();
+	{
+		GEAR_TRACE_SCOPE("old capture");
+	}
+
+	TraceRecorder::Start(); // Discards the previous capture
+	std::vector<std::thread> threads;
+	for (int t = 0; t < 4; ++t)
+		threads.emplace_back([]()
+			{
+				for (int i = 0; i < 1000; ++i)
+				{
+					GEAR_TRACE_SCOPE("work");
+				}
+			});
+	for (std::thread& thread : threads)
+		thread.join();
+	TraceRecorder::Stop();
+
+	EXPECT_EQ(TraceRecorder::GetEventCount(), 4u * 2000u);
+	const std::string json = ExportToString();
+	EXPECT_EQ(json.find("old capture"), std::string::npos);
+	EXPECT_EQ(CountOccurrences(json, "\"name\":\"thread_name\""), 4u);
+	EXPECT_EQ(CountOccurrences(json, "\"name\":\"work\""), 8000u);
+}
+
+TEST(TraceRecorderTest, DropsEventsWhenThreadBufferIsFull)
+{
+	TraceRecorder::Start();
+	std::thread([]()
+		{
+			for (size_t i = 0; i < TraceRecorder::EVENTS_PER_THREAD / 2 + 10; ++i)
+			{
+				GEAR_TRACE_SCOPE("flood");
+			}
+		}).join();
+	TraceRecorder::Stop();
+
+	EXPECT_EQ(TraceRecorder::GetEventCount(), TraceRecorder::EVENTS_PER_THREAD);
+	EXPECT_EQ(TraceRecorder::GetDroppedCount(), 20u);
+}